@@ -40,6 +40,7 @@
 #include "ast/transform/InsertLatticeOperations.h"
 #include "ast/transform/MagicSet.h"
 #include "ast/transform/MaterializeAggregationQueries.h"
+#include "ast/transform/MaterializeHotJoins.h"
 #include "ast/transform/MaterializeSingletonAggregation.h"
 #include "ast/transform/MinimiseProgram.h"
 #include "ast/transform/NameUnnamedVariables.h"
@@ -72,6 +73,9 @@
 #include "interpreter/Engine.h"
 #include "interpreter/ProgInterface.h"
 #include "parser/ParserDriver.h"
+#include "ram/Insert.h"
+#include "ram/Merge.h"
+#include "ram/MergeLattice.h"
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
@@ -86,12 +90,15 @@
 #include "ram/transform/Loop.h"
 #include "ram/transform/MakeIndex.h"
 #include "ram/transform/Parallel.h"
+#include "ram/transform/ReduceIndexes.h"
 #include "ram/transform/ReorderConditions.h"
 #include "ram/transform/ReorderFilterBreak.h"
 #include "ram/transform/ReportIndex.h"
 #include "ram/transform/Sequence.h"
+#include "ram/transform/ShareSubplans.h"
 #include "ram/transform/Transformer.h"
 #include "ram/transform/TupleId.h"
+#include "ram/utility/Visitor.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
 #include "souffle/RamTypes.h"
@@ -118,6 +125,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -175,10 +183,10 @@ namespace souffle {
 }
 
 /**
- * Compiles the given source file to a binary file.
+ * Returns the arguments of souffle-compile.py compiling the given source files to a binary file.
  */
-void compileToBinary(
-        Global& glb, const std::string& command, std::vector<fs::path>& sourceFilenames, fs::path binary) {
+std::vector<std::string> compileArguments(Global& glb, const std::string& command,
+        const std::vector<fs::path>& sourceFilenames, const fs::path& binary) {
     std::vector<std::string> argv;
 
     argv.push_back(command);
@@ -213,17 +221,150 @@ void compileToBinary(
 
     argv.push_back("-o");
     argv.push_back(binary.string());
+    return argv;
+}
 
+/**
+ * Executes souffle-compile.py with the given arguments.
+ */
+auto executeCompileScript(const std::vector<std::string>& argv) {
 #if defined(_MSC_VER)
     const char* interpreter = "python";
 #else
     const char* interpreter = "python3";
 #endif
-    auto exit = execute(interpreter, argv);
+    return execute(interpreter, argv);
+}
+
+/**
+ * Compiles the given source file to a binary file.
+ */
+void compileToBinary(
+        Global& glb, const std::string& command, std::vector<fs::path>& sourceFilenames, fs::path binary) {
+    auto exit = executeCompileScript(compileArguments(glb, command, sourceFilenames, binary));
     if (!exit) throw std::invalid_argument(tfm::format("unable to execute tool <python3 %s>", command));
     if (*exit != 0) throw std::invalid_argument("failed to compile C++ sources");
 }
 
+/**
+ * Synthesises the program and starts compiling it to a shared library in the background, such that the
+ * compiled tier takes over the evaluation of the strata from the interpreter once it is ready.
+ */
+Own<interpreter::CompiledTier> startCompiledTier(
+        Global& glb, ram::TranslationUnit& ramTranslationUnit, const std::string& souffleExecutable) {
+    // the tiers only hand over relations of primitive values
+    for (const ram::Relation* rel : ramTranslationUnit.getProgram().getRelations()) {
+        for (const std::string& type : rel->getAttributeTypes()) {
+            if (type[0] == 'r' || type[0] == '+') {
+                if (!glb.config().has("no-warn")) {
+                    std::cerr << "Warning: tiered execution does not support records, interpreting only\n";
+                }
+                return nullptr;
+            }
+        }
+    }
+
+    const auto souffleCompile = findTool("souffle-compile.py", souffleExecutable, ".");
+    if (!souffleCompile) throw std::runtime_error("failed to locate souffle-compile.py");
+
+    const std::string id = identifier(simpleName(glb.config().get("")));
+    const auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    const fs::path directory = fs::temp_directory_path() / tfm::format("souffle-tiered-%s-%d", id, timestamp);
+    fs::create_directories(directory);
+
+    auto synthesiser = mk<synthesiser::Synthesiser>(ramTranslationUnit);
+    synthesiser::GenDb db;
+    bool withSharedLibrary = false;
+    synthesiser->generateCode(db, id, withSharedLibrary);
+    std::vector<fs::path> srcFiles{directory / (id + ".cpp")};
+    std::ofstream os{srcFiles.front()};
+    db.emitSingleFile(os);
+    os.close();
+
+    if (withSharedLibrary) {
+        if (!glb.config().has("libraries")) {
+            glb.config().set("libraries", "functors");
+        }
+        if (!glb.config().has("library-dir")) {
+            glb.config().set("library-dir", ".");
+        }
+    }
+
+    // the arguments are taken now, since the interpreter may change the configuration meanwhile
+    const fs::path library = directory / ("lib" + id + ".so");
+    std::vector<std::string> argv = compileArguments(glb, *souffleCompile, srcFiles, library);
+    argv.insert(argv.begin() + 1, "--shared");
+    auto compile = [argv]() {
+        auto exit = executeCompileScript(argv);
+        return exit && *exit == 0;
+    };
+    return mk<interpreter::CompiledTier>(compile, library.string(), id, directory.string());
+}
+
+/**
+ * Synthesises the strata computing the relations given by --plugin-strata, and compiles them to the
+ * shared library given by --generate-plugin. The interpreter evaluates these strata with the library
+ * loaded by --plugin, provided it runs the same program with the same options.
+ */
+void generateStratumPlugin(
+        Global& glb, ram::TranslationUnit& ramTranslationUnit, const std::string& souffleExecutable) {
+    const ram::Program& program = ramTranslationUnit.getProgram();
+
+    // the stratum of a relation is named after it, or inserts into it if the relation is recursive
+    std::set<std::string> strata;
+    for (const std::string& name : splitString(glb.config().get("plugin-strata"), ',')) {
+        std::optional<std::string> stratum;
+        for (const auto& [key, stmt] : program.getSubroutines()) {
+            bool computes = key == name;
+            visit(*stmt, [&](const ram::Insert& insert) { computes |= insert.getRelation() == name; });
+            visit(*stmt, [&](const ram::Merge& merge) { computes |= merge.getTargetRelation() == name; });
+            visit(*stmt, [&](const ram::MergeLattice& merge) {
+                computes |= merge.getTargetRelation() == name;
+            });
+            if (computes) {
+                stratum = key;
+                break;
+            }
+        }
+        if (!stratum) {
+            throw std::runtime_error(tfm::format("no stratum computes relation %s", name));
+        }
+        strata.insert(*stratum);
+    }
+
+    const auto souffleCompile = findTool("souffle-compile.py", souffleExecutable, ".");
+    if (!souffleCompile) throw std::runtime_error("failed to locate souffle-compile.py");
+
+    const fs::path library = glb.config().get("generate-plugin");
+    const std::string id = identifier(simpleName(library.string()));
+
+    auto synthesiser = mk<synthesiser::Synthesiser>(ramTranslationUnit);
+    synthesiser::GenDb db;
+    bool withSharedLibrary = false;
+    synthesiser->generatePlugin(db, id, strata, withSharedLibrary);
+    std::vector<fs::path> srcFiles{fs::path(library).replace_extension(".cpp")};
+    std::ofstream os{srcFiles.front()};
+    db.emitSingleFile(os);
+    os.close();
+
+    if (withSharedLibrary) {
+        if (!glb.config().has("libraries")) {
+            glb.config().set("libraries", "functors");
+        }
+        if (!glb.config().has("library-dir")) {
+            glb.config().set("library-dir", ".");
+        }
+    }
+
+    std::vector<std::string> argv = compileArguments(glb, *souffleCompile, srcFiles, library);
+    argv.insert(argv.begin() + 1, "--shared");
+    auto exit = executeCompileScript(argv);
+    if (!exit) {
+        throw std::invalid_argument(tfm::format("unable to execute tool <python3 %s>", *souffleCompile));
+    }
+    if (*exit != 0) throw std::invalid_argument("failed to compile C++ sources");
+}
+
 class InputProvider {
 public:
     virtual ~InputProvider() {}
@@ -514,6 +655,9 @@ Own<ast::transform::PipelineTransformer> astTransformationPipeline(Global& glb)
             mk<ast::transform::RemoveRelationCopiesTransformer>(), std::move(partitionPipeline),
             std::move(equivalencePipeline), mk<ast::transform::RemoveRelationCopiesTransformer>(),
             std::move(magicPipeline), mk<ast::transform::RemoveEmptyRelationsTransformer>(),
+            mk<ast::transform::ConditionalTransformer>(
+                    glb.config().has("auto-schedule") && !glb.config().has("provenance"),
+                    mk<ast::transform::MaterializeHotJoinsTransformer>()),
             mk<ast::transform::AddNullariesToAtomlessAggregatesTransformer>(),
             mk<ast::transform::ExecutionPlanChecker>(), std::move(provenancePipeline),
             mk<ast::transform::IOAttributesTransformer>());
@@ -545,6 +689,7 @@ Own<ram::transform::Transformer> ramTransformerSequence(Global& glb) {
             mk<ExpandFilterTransformer>(), mk<HoistConditionsTransformer>(),
             mk<CollapseFiltersTransformer>(), mk<EliminateDuplicatesTransformer>(),
             mk<ReorderConditionsTransformer>(), mk<LoopTransformer>(mk<ReorderFilterBreak>()),
+            mk<ShareSubplansTransformer>(), mk<ReduceIndexesTransformer>(),
             mk<ConditionalTransformer>(
                     // job count of 0 means all cores are used.
                     [&]() -> bool { return std::stoi(glb.config().get("jobs")) != 1; },
@@ -555,7 +700,8 @@ Own<ram::transform::Transformer> ramTransformerSequence(Global& glb) {
     return ramTransform;
 }
 
-bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationUnit) {
+bool interpretTranslationUnit(
+        Global& glb, ram::TranslationUnit& ramTranslationUnit, Own<interpreter::CompiledTier> tier) {
     try {
         std::thread profiler;
         // Start up profiler if needed
@@ -570,6 +716,9 @@ bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationU
         // configure and execute interpreter
         const std::size_t numThreadsOrZero = std::stoi(glb.config().get("jobs"));
         Own<interpreter::Engine> interpreter(mk<interpreter::Engine>(ramTranslationUnit, numThreadsOrZero));
+        if (tier != nullptr) {
+            interpreter->setCompiledTier(std::move(tier));
+        }
         interpreter->executeMain();
         // If the profiler was started, join back here once it exits.
         if (profiler.joinable()) {
@@ -581,10 +730,11 @@ bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationU
 #else
             // only run explain interface if interpreted
             interpreter::ProgInterface interface(*interpreter);
+            const bool lazy = glb.config().has("lazy-provenance");
             if (glb.config().get("provenance") == "explain") {
-                explain(interface, false);
+                explain(interface, false, lazy);
             } else if (glb.config().get("provenance") == "explore") {
-                explain(interface, true);
+                explain(interface, true, lazy);
             }
 #endif
         }
@@ -650,6 +800,9 @@ std::vector<MainOption> getMainOptions() {
           "executable."},
       {"debug-report", 'r', "FILE", "", false,
           "Write HTML debug report to <FILE>."},
+      {"delta-tagging", nextOptChar++, "RELATIONS", "", false,
+          "Track the delta of the given recursive relations in place, tagging each tuple with "
+          "the iteration that derived it, use '*' for all."},
       {"disable-transformers", 'z', "TRANSFORMERS", "", false,
           "Disable the given AST transformers."},
       {"dl-program", 'o', "FILE", "", false,
@@ -668,15 +821,25 @@ std::vector<MainOption> getMainOptions() {
       {"generate-namespace", 'N', "NS", "", false,
        "The namespace of generated C++ source code. Empty name denotes the anonymous "
        "namespace."},
+      {"generate-plugin", nextOptChar++, "FILE", "", false,
+          "Compile the strata of the relations given by --plugin-strata to the shared library "
+          "<FILE>, which the interpreter loads with --plugin."},
       {"help", 'h', "", "", false,
           "Display this help message."},
       {"include-dir", 'I', "DIR", ".", true,
           "Specify directory for include files."},
+      {"index-budget", nextOptChar++, "MB", "", false,
+          "Limit the memory of the indexes beyond the first index of each relation to <MB> "
+          "megabytes, estimated from the relation sizes of the auto-schedule profile."},
       {"inline-exclude", nextOptChar++, "RELATIONS", "", false,
           "Prevent the given relations from being inlined. Overrides any `inline` qualifiers."},
       {"jobs", 'j', "N", "1", false,
           "Run interpreter/compiler in parallel using N threads, N=auto for system "
           "default."},
+      {"lazy-provenance", nextOptChar++, "", "", false,
+          "Evaluate without provenance annotations and re-derive the proofs of --provenance on demand."},
+      {"leapfrog-join", nextOptChar++, "", "", false,
+          "Intersect the atoms sharing a variable of cyclic rule bodies with leapfrog joins."},
       {"legacy", nextOptChar++, "", "", false,
           "Enable legacy support."},
       {"libraries", 'l', "FILE", "", true,
@@ -697,10 +860,20 @@ std::vector<MainOption> getMainOptions() {
           "Do not use a C preprocessor."},
       {"no-warn", 'w', "", "", false,
           "Disable warnings."},
+      {"numa", nextOptChar++, "", "", false,
+          "Bind the threads to the NUMA nodes of the machine, and give the threads of each node a "
+          "block of the ranges of a parallel scan."},
       {"output-dir", 'D', "DIR", ".", false,
           "Specify directory for output files. If <DIR> is `-` then stdout is used."},
+      {"parallel-strata", nextOptChar++, "", "", false,
+          "Evaluate independent strata concurrently, sharing the threads given by -j/--jobs."},
       {"parse-errors", nextOptChar++, "", "", false,
           "Show parsing errors, if any, then exit."},
+      {"plugin", nextOptChar++, "FILE", "", true,
+          "Evaluate the strata of the shared library <FILE> generated by --generate-plugin in place of "
+          "the interpreter."},
+      {"plugin-strata", nextOptChar++, "RELATIONS", "", false,
+          "Select the strata of the given relations for --generate-plugin."},
       {"pragma", 'P', "OPTIONS", "", true,
           "Set pragma options."},
       {"preprocessor", nextOptChar++, "CMD", "", false,
@@ -709,6 +882,8 @@ std::vector<MainOption> getMainOptions() {
           "Enable profiling, and write profile data to <FILE>."},
       {"profile-frequency", nextOptChar++, "", "", false,
           "Enable the frequency counter in the profiler."},
+      {"profile-use", nextOptChar++, "FILE", "", false,
+          "Specialise the synthesised code for profile <FILE> of a prior run with --profile."},
       {"provenance", 't', "[ none | explain | explore ]", "", false,
           "Enable provenance instrumentation and interaction."},
       {"show", nextOptChar++, "[ <see-list> ]", "", true,
@@ -727,6 +902,11 @@ std::vector<MainOption> getMainOptions() {
       {"swig", 's', "LANG", "", false,
           "Generate SWIG interface for given language. The values <LANG> accepts is java and "
           "python. "},
+      {"tiered", nextOptChar++, "", "", false,
+          "Start interpreting immediately while compiling the program in the background, and evaluate "
+          "the remaining strata with the compiled program once it is ready."},
+      {"tiered-wait", nextOptChar++, "N", "", false,
+          "With --tiered, wait for the compiled program once <N> strata have been interpreted."},
       {"verbose", 'v', "", "", false,
           "Verbose output."},
       {"version", nextOptChar++, "", "", false,
@@ -810,6 +990,58 @@ int main(Global& glb, const char* souffle_executable) {
 #endif
         }
 
+        /* the index budget is estimated from the relation sizes of a profile */
+        if (glb.config().has("index-budget")) {
+            if (!isNumber(glb.config().get("index-budget").c_str()) ||
+                    std::stoll(glb.config().get("index-budget")) < 0) {
+                throw std::runtime_error("--index-budget may only be set to a non-negative integer.");
+            }
+            if (!glb.config().has("auto-schedule")) {
+                throw std::runtime_error("--index-budget requires a profile given by -a/--auto-schedule.");
+            }
+        }
+
+        /* proofs are re-derived lazily for the explain and explore interfaces only */
+        if (glb.config().has("lazy-provenance") && !glb.config().has("provenance", "explain") &&
+                !glb.config().has("provenance", "explore")) {
+            throw std::runtime_error(
+                    "--lazy-provenance requires --provenance=explain or --provenance=explore.");
+        }
+
+        /* the compiled tier takes over the strata, hence their relations must not be observed otherwise */
+        if (glb.config().has("tiered")) {
+#ifdef _MSC_VER
+            throw std::runtime_error("--tiered is not supported on Windows.");
+#endif
+            for (const char* option : {"profile", "live-profile", "provenance", "parallel-strata"}) {
+                if (glb.config().has(option)) {
+                    throw std::runtime_error(tfm::format("--tiered cannot be combined with --%s.", option));
+                }
+            }
+        }
+        if (glb.config().has("tiered-wait")) {
+            if (!glb.config().has("tiered")) {
+                throw std::runtime_error("--tiered-wait requires --tiered.");
+            }
+            const std::string& strata = glb.config().get("tiered-wait");
+            if (strata.empty() || !isNumber(strata.c_str())) {
+                throw std::runtime_error("--tiered-wait may only be set to a non-negative integer.");
+            }
+        }
+
+        /* plugins evaluate strata on the relations of the interpreter */
+        if (glb.config().has("plugin") || glb.config().has("generate-plugin")) {
+            for (const char* option : {"profile", "live-profile", "provenance", "tiered"}) {
+                if (glb.config().has(option)) {
+                    throw std::runtime_error(tfm::format(
+                            "--plugin and --generate-plugin cannot be combined with --%s.", option));
+                }
+            }
+        }
+        if (glb.config().has("generate-plugin") && !glb.config().has("plugin-strata")) {
+            throw std::runtime_error("--generate-plugin requires the relations given by --plugin-strata.");
+        }
+
         /* if an output directory is given, check it exists */
         if (glb.config().has("output-dir") && !glb.config().has("output-dir", "-") &&
                 !existDir(glb.config().get("output-dir")) &&
@@ -1068,9 +1300,16 @@ int main(Global& glb, const char* souffle_executable) {
     const bool must_compile = must_execute || compile_mode || glb.config().has("swig");
 
     try {
-        if (must_interpret) {
+        if (must_interpret && glb.config().has("generate-plugin")) {
+            // ------- stratum plugin ----------
+            generateStratumPlugin(glb, *ramTranslationUnit, souffleExecutable);
+        } else if (must_interpret) {
             // ------- interpreter -------------
-            const bool success = interpretTranslationUnit(glb, *ramTranslationUnit);
+            Own<interpreter::CompiledTier> tier;
+            if (glb.config().has("tiered")) {
+                tier = startCompiledTier(glb, *ramTranslationUnit, souffleExecutable);
+            }
+            const bool success = interpretTranslationUnit(glb, *ramTranslationUnit, std::move(tier));
             if (!success) {
                 std::exit(EXIT_FAILURE);
             }
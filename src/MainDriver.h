@@ -18,6 +18,7 @@
 #include "ast2ram/UnitTranslator.h"
 #include "ast2ram/utility/TranslatorContext.h"
 #include "include/souffle/utility/Types.h"
+#include "interpreter/CompiledTier.h"
 #include "ram/Program.h"
 #include "ram/transform/Transformer.h"
 
@@ -50,7 +51,11 @@ Own<ast2ram::UnitTranslator> getUnitTranslator(Global& glb);
 /** Construct and return a RAM transformer pipeline */
 Own<ram::transform::Transformer> ramTransformerSequence(Global& glb);
 
-/** Interpret the RAM translation unit using Souffle's interpreter engine. */
-bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationUnit);
+/**
+ * Interpret the RAM translation unit using Souffle's interpreter engine, letting the given compiled tier
+ * take over once it is ready.
+ */
+bool interpretTranslationUnit(
+        Global& glb, ram::TranslationUnit& ramTranslationUnit, Own<interpreter::CompiledTier> tier = nullptr);
 
 }  // namespace souffle
@@ -62,6 +62,16 @@ std::size_t ProfileUseAnalysis::getRelationSize(const QualifiedName& rel) const
     }
 }
 
+/**
+ * Get number of fixpoint iterations from profile
+ */
+std::size_t ProfileUseAnalysis::getRecursiveIterations(const QualifiedName& rel) const {
+    if (const auto* profRel = programRun->getRelation(rel.toString())) {
+        return profRel->getIterations().size();
+    }
+    return 0;
+}
+
 bool ProfileUseAnalysis::hasAutoSchedulerStats() const {
     return reader->hasAutoSchedulerStats();
 }
@@ -54,6 +54,9 @@ public:
     /** Return size of relation in the profile */
     std::size_t getRelationSize(const QualifiedName& rel) const;
 
+    /** Return number of fixpoint iterations of a recursive relation in the profile, or zero */
+    std::size_t getRecursiveIterations(const QualifiedName& rel) const;
+
     bool hasAutoSchedulerStats() const;
 
     double getNonRecursiveJoinSize(
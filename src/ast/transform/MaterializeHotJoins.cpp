@@ -0,0 +1,229 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MaterializeHotJoins.cpp
+ *
+ ***********************************************************************/
+
+#include "ast/transform/MaterializeHotJoins.h"
+#include "ast/Argument.h"
+#include "ast/Atom.h"
+#include "ast/Attribute.h"
+#include "ast/Clause.h"
+#include "ast/Constant.h"
+#include "ast/Literal.h"
+#include "ast/Program.h"
+#include "ast/QualifiedName.h"
+#include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
+#include "ast/TranslationUnit.h"
+#include "ast/UnnamedVariable.h"
+#include "ast/Variable.h"
+#include "ast/analysis/Aggregate.h"
+#include "ast/analysis/ProfileUse.h"
+#include "ast/analysis/RecursiveClauses.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/analysis/typesystem/Type.h"
+#include "ast/analysis/typesystem/TypeSystem.h"
+#include "ast/utility/Visitor.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FunctionalUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+namespace {
+
+/** Tests whether an atom of a plain relation only has variables and constants as arguments */
+bool isPlainAtom(const Program& program, const Atom& atom) {
+    const auto* rel = program.getRelation(atom);
+    if (rel == nullptr) {
+        return false;
+    }
+    for (const auto* attr : rel->getAttributes()) {
+        if (attr->getIsLattice()) {
+            return false;
+        }
+    }
+    return all_of(atom.getArguments(), [](const Argument* arg) {
+        return isA<Variable>(arg) || isA<UnnamedVariable>(arg) || isA<Constant>(arg);
+    });
+}
+
+}  // namespace
+
+bool MaterializeHotJoinsTransformer::isMaterializedJoin(const QualifiedName& name) {
+    return isPrefix(RELATION_PREFIX, name.toString());
+}
+
+bool MaterializeHotJoinsTransformer::transform(TranslationUnit& translationUnit) {
+    bool changed = false;
+    Program& program = translationUnit.getProgram();
+    const auto& profileUse = translationUnit.getAnalysis<analysis::ProfileUseAnalysis>();
+    const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+    const auto& recursiveClauses = translationUnit.getAnalysis<analysis::RecursiveClausesAnalysis>();
+
+    VecOwn<Clause> clausesToAdd;
+    std::vector<const Clause*> clausesToRemove;
+
+    for (const auto* clause : program.getClauses()) {
+        // only recursive rules iterating several times in the profile reuse a join
+        if (!recursiveClauses.recursive(clause) || clause->getExecutionPlan() != nullptr ||
+                isA<SubsumptiveClause>(clause)) {
+            continue;
+        }
+        const auto* head = clause->getHead();
+        if (profileUse.getRecursiveIterations(head->getQualifiedName()) < MIN_ITERATIONS) {
+            continue;
+        }
+
+        // find the atoms of relations computed in lower strata
+        std::size_t headScc = sccGraph.getSCC(program.getRelation(*head));
+        std::vector<const Atom*> invariants;
+        std::vector<std::vector<std::string>> invariantVars;
+        std::set<std::string> outsideVars;
+        visit(*head, [&](const Variable& var) { outsideVars.insert(var.getName()); });
+        for (const auto* lit : clause->getBodyLiterals()) {
+            const auto* atom = as<Atom>(lit);
+            if (atom != nullptr && sccGraph.getSCC(program.getRelation(*atom)) != headScc &&
+                    isPlainAtom(program, *atom)) {
+                std::vector<std::string> vars;
+                visit(*atom, [&](const Variable& var) { vars.push_back(var.getName()); });
+                invariants.push_back(atom);
+                invariantVars.push_back(std::move(vars));
+            } else {
+                visit(*lit, [&](const Variable& var) { outsideVars.insert(var.getName()); });
+            }
+        }
+        if (invariants.size() < 2) {
+            continue;
+        }
+
+        // group the atoms joined on variables that do not occur elsewhere in the clause
+        std::vector<std::size_t> group(invariants.size());
+        std::iota(group.begin(), group.end(), 0);
+        auto find = [&](std::size_t i) {
+            while (group[i] != i) {
+                i = group[i];
+            }
+            return i;
+        };
+        for (std::size_t i = 0; i < invariants.size(); i++) {
+            for (std::size_t j = i + 1; j < invariants.size(); j++) {
+                bool isJoined = any_of(invariantVars[i], [&](const std::string& var) {
+                    return outsideVars.count(var) == 0 && contains(invariantVars[j], var);
+                });
+                if (isJoined) {
+                    group[find(j)] = find(i);
+                }
+            }
+        }
+
+        // materialise each group of at least two atoms into a new relation
+        std::optional<std::map<const Argument*, analysis::TypeSet>> clauseArgTypes;
+        std::map<const Literal*, Own<Literal>> replacements;
+        for (std::size_t root = 0; root < invariants.size(); root++) {
+            std::vector<std::size_t> members;
+            for (std::size_t i = 0; i < invariants.size(); i++) {
+                if (find(i) == root) {
+                    members.push_back(i);
+                }
+            }
+            if (members.size() < 2) {
+                continue;
+            }
+
+            // the join is kept on the variables shared with the rest of the clause
+            std::vector<std::string> headVars;
+            for (std::size_t i : members) {
+                for (const auto& var : invariantVars[i]) {
+                    if (outsideVars.count(var) != 0 && !contains(headVars, var)) {
+                        headVars.push_back(var);
+                    }
+                }
+            }
+
+            if (!clauseArgTypes) {
+                clauseArgTypes = analysis::TypeAnalysis::analyseTypes(translationUnit, *clause);
+            }
+            auto getType = [&](const std::string& name) -> std::optional<QualifiedName> {
+                for (const auto& [arg, types] : *clauseArgTypes) {
+                    const auto* var = as<Variable>(arg);
+                    if (var != nullptr && var->getName() == name && types.size() == 1) {
+                        return types.begin()->getName();
+                    }
+                }
+                return std::nullopt;
+            };
+            if (!all_of(headVars, [&](const std::string& var) { return getType(var).has_value(); })) {
+                continue;
+            }
+
+            auto name = QualifiedName::fromString(analysis::findUniqueRelationName(program, RELATION_PREFIX));
+            auto rel = mk<Relation>(name, clause->getSrcLoc());
+            VecOwn<Argument> headArgs;
+            VecOwn<Argument> atomArgs;
+            for (const auto& var : headVars) {
+                rel->addAttribute(mk<Attribute>(var, *getType(var)));
+                headArgs.push_back(mk<Variable>(var));
+                atomArgs.push_back(mk<Variable>(var));
+            }
+            program.addRelation(std::move(rel));
+
+            VecOwn<Literal> body;
+            for (std::size_t i : members) {
+                body.push_back(clone(invariants[i]));
+            }
+            clausesToAdd.push_back(
+                    mk<Clause>(mk<Atom>(name, std::move(headArgs), clause->getSrcLoc()), std::move(body),
+                            nullptr, clause->getSrcLoc()));
+
+            // the first atom of the group is replaced by the new relation, the others are dropped
+            replacements[invariants[members[0]]] = mk<Atom>(name, std::move(atomArgs), clause->getSrcLoc());
+            for (std::size_t k = 1; k < members.size(); k++) {
+                replacements[invariants[members[k]]] = nullptr;
+            }
+        }
+        if (replacements.empty()) {
+            continue;
+        }
+
+        // replace the materialised atoms in the clause
+        VecOwn<Literal> body;
+        for (const auto* lit : clause->getBodyLiterals()) {
+            auto it = replacements.find(lit);
+            if (it == replacements.end()) {
+                body.push_back(clone(lit));
+            } else if (it->second != nullptr) {
+                body.push_back(std::move(it->second));
+            }
+        }
+        auto replacement = clone(clause);
+        replacement->setBodyLiterals(std::move(body));
+        clausesToAdd.push_back(std::move(replacement));
+        clausesToRemove.push_back(clause);
+        changed = true;
+    }
+
+    program.removeClauses(clausesToRemove);
+    program.addClauses(std::move(clausesToAdd));
+    return changed;
+}
+
+}  // namespace souffle::ast::transform
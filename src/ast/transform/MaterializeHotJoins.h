@@ -0,0 +1,64 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MaterializeHotJoins.h
+ *
+ * Transformation pass to materialise the joins of recursive rules over
+ * non-recursive relations, if the profile shows that the rules are
+ * evaluated in several iterations.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/QualifiedName.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/Transformer.h"
+#include <cstddef>
+#include <string>
+
+namespace souffle::ast::transform {
+
+/**
+ * Transformation pass to move joins of non-recursive atoms out of recursive
+ * rules, such that they are computed once instead of in every iteration.
+ * E.g. for a relation path that iterates several times in the profile,
+ *      path(x, z) :- path(x, y), edge(y, w), label(w, z).
+ * is transformed into:
+ *      - path(x, z) :- path(x, y), __hot_join(y, z).
+ *      - __hot_join(y, z) :- edge(y, w), label(w, z).
+ *
+ * Only joins projecting away a variable are materialised. The new relation is
+ * indexed on the variables bound by the remaining atoms, as for any other atom.
+ */
+class MaterializeHotJoinsTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "MaterializeHotJoinsTransformer";
+    }
+
+    /** Tests whether a relation holds a join materialised by this transformation */
+    static bool isMaterializedJoin(const QualifiedName& name);
+
+private:
+    /** Prefix of the names of the relations holding materialised joins */
+    static constexpr const char* RELATION_PREFIX = "__hot_join";
+
+    /** Minimal number of iterations for a recursive rule to reuse a join */
+    static constexpr std::size_t MIN_ITERATIONS = 2;
+
+    MaterializeHotJoinsTransformer* cloning() const override {
+        return new MaterializeHotJoinsTransformer();
+    }
+
+    bool transform(TranslationUnit& translationUnit) override;
+};
+
+}  // namespace souffle::ast::transform
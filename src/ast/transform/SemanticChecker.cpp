@@ -765,6 +765,31 @@ void SemanticCheckerImpl::checkRelation(const Relation& relation) {
         }
     }
 
+    // Check signature of bitmap relations
+    if (relation.getRepresentation() == RelationRepresentation::BITMAP) {
+        if (relation.getArity() != 1 && relation.getArity() != 2) {
+            report.addError("Bitmap relation " + toString(relation.getQualifiedName()) +
+                                    " is neither unary nor binary",
+                    relation.getSrcLoc());
+        } else if (relation.getAuxiliaryArity() > 0) {
+            report.addError("Bitmap relation " + toString(relation.getQualifiedName()) +
+                                    " has lattice attributes",
+                    relation.getSrcLoc());
+        }
+        for (const auto* attribute : relation.getAttributes()) {
+            if (!typeEnv.isType(attribute->getTypeName())) {
+                continue;
+            }
+            const auto& type = typeEnv.getType(attribute->getTypeName());
+            if (!isOfKind(type, TypeAttribute::Signed) && !isOfKind(type, TypeAttribute::Unsigned)) {
+                report.addError("Attribute " + attribute->getName() + " of bitmap relation " +
+                                        toString(relation.getQualifiedName()) +
+                                        " is not of type number or unsigned",
+                        attribute->getSrcLoc());
+            }
+        }
+    }
+
     // check subsumption relations
     bool hasSubsumptiveRule = visitExists(program, [&](const ast::SubsumptiveClause& sClause) {
         return sClause.getHead()->getQualifiedName() == relation.getQualifiedName();
@@ -0,0 +1,116 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LazySubproofGenerator.cpp
+ *
+ ***********************************************************************/
+
+#include "ast2ram/provenance/LazySubproofGenerator.h"
+#include "ast/Atom.h"
+#include "ast/BinaryConstraint.h"
+#include "ast/Clause.h"
+#include "ast/Functor.h"
+#include "ast/Negation.h"
+#include "ast/utility/Utils.h"
+#include "ast2ram/utility/TranslatorContext.h"
+#include "ast2ram/utility/ValueIndex.h"
+#include "ram/Constraint.h"
+#include "ram/Filter.h"
+#include "ram/Query.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/SubroutineArgument.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/UndefValue.h"
+
+namespace souffle::ast2ram::provenance {
+
+LazySubproofGenerator::LazySubproofGenerator(const TranslatorContext& context)
+        : ast2ram::seminaive::ClauseTranslator(context) {}
+
+LazySubproofGenerator::~LazySubproofGenerator() = default;
+
+Own<ram::Statement> LazySubproofGenerator::createRamFactQuery(const ast::Clause& clause) const {
+    assert(isFact(clause) && "clause should be fact");
+
+    VecOwn<ram::Expression> values;
+    values.push_back(mk<ram::SignedConstant>(context.getClauseNum(&clause)));
+
+    // the fact must match the tuple given as arguments
+    auto op = addBodyLiteralConstraints(clause, mk<ram::SubroutineReturn>(std::move(values)));
+    return mk<ram::Query>(std::move(op));
+}
+
+Own<ram::Statement> LazySubproofGenerator::createRamRuleQuery(const ast::Clause& clause) {
+    assert(isRule(clause) && "clause should be rule");
+
+    // Index all variables and generators in the clause
+    indexClause(clause);
+
+    // Set up the RAM statement bottom-up
+    auto op = generateReturnInstantiatedValues(clause);
+    op = addVariableBindingConstraints(std::move(op));
+    op = addBodyLiteralConstraints(clause, std::move(op));
+    op = addGeneratorLevels(std::move(op), clause);
+    op = addVariableIntroductions(clause, std::move(op));
+    return mk<ram::Query>(std::move(op));
+}
+
+Own<ram::Operation> LazySubproofGenerator::addBodyLiteralConstraints(
+        const ast::Clause& clause, Own<ram::Operation> op) const {
+    op = seminaive::ClauseTranslator::addBodyLiteralConstraints(clause, std::move(op));
+
+    // the head must match the tuple given as arguments
+    const auto& headArgs = clause.getHead()->getArguments();
+    for (std::size_t i = 0; i < headArgs.size(); i++) {
+        auto opEq = BinaryConstraintOp::EQ;
+        if (const auto* func = as<ast::Functor>(headArgs[i])) {
+            if (context.getFunctorReturnTypeAttribute(*func) == TypeAttribute::Float) {
+                opEq = BinaryConstraintOp::FEQ;
+            }
+        }
+        auto lhs = context.translateValue(*valueIndex, headArgs[i]);
+        auto constraint = mk<ram::Constraint>(opEq, std::move(lhs), mk<ram::SubroutineArgument>(i));
+        op = mk<ram::Filter>(std::move(constraint), std::move(op));
+    }
+
+    return op;
+}
+
+Own<ram::Operation> LazySubproofGenerator::generateReturnInstantiatedValues(
+        const ast::Clause& clause) const {
+    VecOwn<ram::Expression> values;
+
+    // values of the atoms and negations, with undefined rule and level numbers
+    for (const auto* lit : clause.getBodyLiterals()) {
+        const ast::Atom* atom = as<ast::Atom>(lit);
+        if (const auto* neg = as<ast::Negation>(lit)) {
+            atom = neg->getAtom();
+        }
+        if (atom == nullptr) {
+            continue;
+        }
+        for (const auto* arg : atom->getArguments()) {
+            values.push_back(context.translateValue(*valueIndex, arg));
+        }
+        values.push_back(mk<ram::UndefValue>());
+        values.push_back(mk<ram::UndefValue>());
+    }
+
+    // operands of the binary constraints
+    for (const auto* constraint : ast::getBodyLiterals<const ast::BinaryConstraint>(clause)) {
+        values.push_back(context.translateValue(*valueIndex, constraint->getLHS()));
+        values.push_back(context.translateValue(*valueIndex, constraint->getRHS()));
+    }
+
+    return mk<ram::SubroutineReturn>(std::move(values));
+}
+
+}  // namespace souffle::ast2ram::provenance
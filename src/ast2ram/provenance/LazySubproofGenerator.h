@@ -0,0 +1,62 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LazySubproofGenerator.h
+ *
+ * Generator of the subproof subroutines for relations without provenance
+ * annotations
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast2ram/seminaive/ClauseTranslator.h"
+
+namespace souffle::ast {
+class Clause;
+}  // namespace souffle::ast
+
+namespace souffle::ram {
+class Operation;
+class Statement;
+}  // namespace souffle::ram
+
+namespace souffle::ast2ram {
+class TranslatorContext;
+}
+
+namespace souffle::ast2ram::provenance {
+
+/**
+ * Translates a clause to a subroutine returning all instantiations of its body
+ * for the head tuple given as arguments.
+ *
+ * The values of each instantiation are laid out as for the subproof subroutine
+ * of annotated relations, i.e. the values of the atoms and negations followed by
+ * the operands of the binary constraints. The rule and level numbers of the
+ * atoms are left undefined; the explainer fills them in by its proof search.
+ *
+ * A fact is translated to a query returning its clause number if it is the
+ * tuple given as arguments.
+ */
+class LazySubproofGenerator : public ast2ram::seminaive::ClauseTranslator {
+public:
+    LazySubproofGenerator(const TranslatorContext& context);
+    ~LazySubproofGenerator();
+
+protected:
+    Own<ram::Statement> createRamFactQuery(const ast::Clause& clause) const override;
+    Own<ram::Statement> createRamRuleQuery(const ast::Clause& clause) override;
+    Own<ram::Operation> addBodyLiteralConstraints(
+            const ast::Clause& clause, Own<ram::Operation> op) const override;
+    Own<ram::Operation> generateReturnInstantiatedValues(const ast::Clause& clause) const;
+};
+
+}  // namespace souffle::ast2ram::provenance
@@ -18,8 +18,11 @@
 #include "ast/BinaryConstraint.h"
 #include "ast/Clause.h"
 #include "ast/Constraint.h"
+#include "ast/Program.h"
+#include "ast/Relation.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
+#include "ast2ram/provenance/LazySubproofGenerator.h"
 #include "ast2ram/provenance/SubproofGenerator.h"
 #include "ast2ram/utility/TranslatorContext.h"
 #include "ast2ram/utility/Utils.h"
@@ -72,6 +75,9 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
 Own<ram::Relation> UnitTranslator::createRamRelation(
         const ast::Relation* baseRelation, std::string ramRelationName) const {
     auto relation = seminaive::UnitTranslator::createRamRelation(baseRelation, ramRelationName);
+    if (isLazy()) {
+        return relation;
+    }
 
     std::size_t arity = relation->getArity();
     std::size_t auxiliaryArity = relation->getAuxiliaryArity();
@@ -142,10 +148,18 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
 }
 
 void UnitTranslator::addAuxiliaryArity(
-        const ast::Relation* /* relation */, std::map<std::string, std::string>& directives) const {
+        const ast::Relation* relation, std::map<std::string, std::string>& directives) const {
+    if (isLazy()) {
+        seminaive::UnitTranslator::addAuxiliaryArity(relation, directives);
+        return;
+    }
     directives.insert(std::make_pair("auxArity", "2"));
 }
 
+bool UnitTranslator::isLazy() const {
+    return glb->config().has("lazy-provenance");
+}
+
 Own<ram::Statement> UnitTranslator::generateClearExpiredRelations(
         const ast::RelationSet& /* expiredRelations */) const {
     // Relations should be preserved if provenance is enabled
@@ -171,10 +185,29 @@ void UnitTranslator::addProvenanceClauseSubroutines(const ast::Program* program)
                 relName + "_" + std::to_string(context->getClauseNum(&clause)) + "_negation_subproof";
         addRamSubroutine(negationSubroutineLabel, makeNegationSubproofSubroutine(clause));
     });
+
+    // Fact checks for the lazy explainer, which cannot tell facts from derived tuples otherwise
+    if (isLazy()) {
+        for (const auto* rel : program->getRelations()) {
+            VecOwn<ram::Statement> factChecks;
+            for (const auto* clause : program->getClauses(*rel)) {
+                if (isFact(*clause)) {
+                    LazySubproofGenerator factTranslator(*context);
+                    factChecks.push_back(factTranslator.translateNonRecursiveClause(*clause));
+                }
+            }
+            std::string factSubroutineLabel = toString(rel->getQualifiedName()) + "_fact";
+            addRamSubroutine(factSubroutineLabel, mk<ram::Sequence>(std::move(factChecks)));
+        }
+    }
 }
 
 Own<ram::Statement> UnitTranslator::generateMergeRelations(
         const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const {
+    if (isLazy()) {
+        return seminaive::UnitTranslator::generateMergeRelations(rel, destRelation, srcRelation);
+    }
+
     VecOwn<ram::Expression> values;
 
     // Predicate - insert all values
@@ -314,6 +347,9 @@ Own<ram::Sequence> UnitTranslator::generateInfoClauses(const ast::Program* progr
 }
 
 Own<ram::Statement> UnitTranslator::makeSubproofSubroutine(const ast::Clause& clause) {
+    if (isLazy()) {
+        return LazySubproofGenerator(*context).translateNonRecursiveClause(clause);
+    }
     return SubproofGenerator(*context).translateNonRecursiveClause(clause);
 }
 
@@ -332,8 +368,10 @@ Own<ram::ExistenceCheck> UnitTranslator::makeRamAtomExistenceCheck(const ast::At
     }
 
     // Fill up query with nullptrs for the provenance columns
-    query.push_back(mk<ram::UndefValue>());
-    query.push_back(mk<ram::UndefValue>());
+    if (!isLazy()) {
+        query.push_back(mk<ram::UndefValue>());
+        query.push_back(mk<ram::UndefValue>());
+    }
 
     // Create existence checks to check if the tuple exists or not
     return mk<ram::ExistenceCheck>(relName, std::move(query));
@@ -55,6 +55,9 @@ protected:
             const std::string& srcRelation) const override;
 
 private:
+    /** Whether the relations are evaluated without annotations, re-deriving proofs on demand */
+    bool isLazy() const;
+
     /** Translate RAM code for subroutine to get subproofs */
     Own<ram::Statement> makeSubproofSubroutine(const ast::Clause& clause);
 
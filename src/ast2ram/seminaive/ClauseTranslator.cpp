@@ -30,6 +30,7 @@
 #include "ast/StringConstant.h"
 #include "ast/SubsumptiveClause.h"
 #include "ast/UnnamedVariable.h"
+#include "ast/Variable.h"
 #include "ast/analysis/Functor.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
@@ -49,6 +50,7 @@
 #include "ram/FloatConstant.h"
 #include "ram/GuardedInsert.h"
 #include "ram/Insert.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/IntrinsicAggregator.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/Negation.h"
@@ -59,18 +61,75 @@
 #include "ram/SignedConstant.h"
 #include "ram/StringConstant.h"
 #include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
 #include "ram/UnpackRecord.h"
 #include "ram/UnsignedConstant.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/utility/Utils.h"
 #include "souffle/TypeAttribute.h"
 #include "souffle/utility/StringUtil.h"
+#include <algorithm>
 #include <map>
+#include <set>
 #include <unordered_set>
 #include <vector>
 
 namespace souffle::ast2ram::seminaive {
 
+namespace {
+
+/**
+ * Tests whether the join of the given atoms is cyclic, i.e. whether the GYO reduction
+ * of the hypergraph with the variables of each atom as an edge leaves any edges.
+ */
+bool isCyclicJoin(const std::vector<ast::Atom*>& atoms) {
+    std::vector<std::set<std::string>> edges;
+    for (const auto* atom : atoms) {
+        std::set<std::string> vars;
+        visit(*atom, [&](const ast::Variable& var) { vars.insert(var.getName()); });
+        edges.push_back(std::move(vars));
+    }
+
+    bool changed = true;
+    while (changed && !edges.empty()) {
+        changed = false;
+
+        // remove variables occurring in a single edge
+        std::map<std::string, std::size_t> occurrences;
+        for (const auto& edge : edges) {
+            for (const auto& var : edge) {
+                occurrences[var]++;
+            }
+        }
+        for (auto& edge : edges) {
+            for (auto it = edge.begin(); it != edge.end();) {
+                if (occurrences[*it] == 1) {
+                    it = edge.erase(it);
+                    changed = true;
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        // remove an edge contained in another edge
+        for (std::size_t i = 0; i < edges.size() && !changed; ++i) {
+            bool isEar = edges[i].empty();
+            for (std::size_t j = 0; j < edges.size() && !isEar; ++j) {
+                isEar = i != j && std::includes(edges[j].begin(), edges[j].end(), edges[i].begin(),
+                                          edges[i].end());
+            }
+            if (isEar) {
+                edges.erase(edges.begin() + i);
+                changed = true;
+            }
+        }
+    }
+    return !edges.empty();
+}
+
+}  // namespace
+
 ClauseTranslator::ClauseTranslator(const TranslatorContext& context, TranslationMode mode)
         : ast2ram::ClauseTranslator(context, mode), valueIndex(mk<ValueIndex>()) {}
 
@@ -106,6 +165,12 @@ std::string ClauseTranslator::getClauseAtomName(const ast::Clause& clause, const
     return getAtomName(clause, atom, sccAtoms, version, isRecursive(), mode);
 }
 
+bool ClauseTranslator::isTaggedDeltaAtom(const ast::Clause& clause, const ast::Atom* atom) const {
+    const auto& name = atom->getQualifiedName();
+    return isRecursive() && context.hasDeltaTagging(name) &&
+           getClauseAtomName(clause, atom) == getDeltaRelationName(name);
+}
+
 Own<ram::Statement> ClauseTranslator::translateRecursiveClause(
         const ast::Clause& clause, const ast::RelationSet& scc, std::size_t version) {
     // Update version config
@@ -202,6 +267,12 @@ Own<ram::Operation> ClauseTranslator::createInsertion(const ast::Clause& clause)
         values.push_back(context.translateValue(*valueIndex, arg));
     }
 
+    // Tuples derived before the fixpoint loop form the delta of its first iteration
+    if (context.hasDeltaTagging(head->getQualifiedName()) &&
+            headRelationName == getConcreteRelationName(head->getQualifiedName())) {
+        values.push_back(mk<ram::UnsignedConstant>(0));
+    }
+
     // Propositions
     if (head->getArity() == 0) {
         return mk<ram::Filter>(mk<ram::EmptinessCheck>(headRelationName),
@@ -220,13 +291,28 @@ Own<ram::Operation> ClauseTranslator::createInsertion(const ast::Clause& clause)
 Own<ram::Operation> ClauseTranslator::addAtomScan(Own<ram::Operation> op, const ast::Atom* atom,
         const ast::Clause& clause, std::size_t curLevel) const {
     const ast::Atom* head = clause.getHead();
+    std::string relationName = getClauseAtomName(clause, atom);
 
     // add constraints
     op = addConstantConstraints(curLevel, atom->getArguments(), std::move(op));
 
-    // add check for emptiness for an atom
-    op = mk<ram::Filter>(
-            mk<ram::Negation>(mk<ram::EmptinessCheck>(getClauseAtomName(clause, atom))), std::move(op));
+    if (isTaggedDeltaAtom(clause, atom)) {
+        // a delta tracked in place is the range of tuples tagged with the previous iteration
+        relationName = getConcreteRelationName(atom->getQualifiedName());
+        op = mk<ram::Filter>(mk<ram::Constraint>(BinaryConstraintOp::EQ,
+                                     mk<ram::TupleElement>(curLevel, atom->getArity()), makeRamDeltaTag()),
+                std::move(op));
+
+        VecOwn<ram::Expression> values;
+        for (std::size_t i = 0; i < atom->getArity(); i++) {
+            values.push_back(mk<ram::UndefValue>());
+        }
+        values.push_back(makeRamDeltaTag());
+        op = mk<ram::Filter>(mk<ram::ExistenceCheck>(relationName, std::move(values)), std::move(op));
+    } else {
+        // add check for emptiness for an atom
+        op = mk<ram::Filter>(mk<ram::Negation>(mk<ram::EmptinessCheck>(relationName)), std::move(op));
+    }
 
     // check whether all arguments are unnamed variables
     bool isAllArgsUnnamed = all_of(
@@ -249,7 +335,7 @@ Own<ram::Operation> ClauseTranslator::addAtomScan(Own<ram::Operation> op, const
             ss << stringify(toString(clause)) << ';';
             ss << curLevel << ';';
         }
-        op = mk<ram::Scan>(getClauseAtomName(clause, atom), curLevel, std::move(op), ss.str());
+        op = mk<ram::Scan>(relationName, curLevel, std::move(op), ss.str());
     }
 
     return op;
@@ -310,6 +396,52 @@ Own<ram::Operation> ClauseTranslator::addAdtUnpack(
     return op;
 }
 
+Own<ram::Operation> ClauseTranslator::addLeapfrogJoin(Own<ram::Operation> op, const ast::Clause& clause,
+        const ast::Variable* var, std::size_t curLevel) const {
+    std::vector<std::string> relations;
+    std::vector<std::size_t> columns;
+    std::vector<VecOwn<ram::Expression>> patterns;
+
+    // join the subsequent atoms on the variable which have columns bound at this level
+    for (std::size_t i = curLevel + 1; i < operators.size(); i++) {
+        const auto* atom = as<ast::Atom>(operators.at(i));
+        if (atom == nullptr) {
+            continue;
+        }
+        auto column = getLeapfrogColumn(atom, var->getName());
+        if (!column.has_value()) {
+            continue;
+        }
+
+        VecOwn<ram::Expression> pattern;
+        bool isBound = false;
+        const auto& args = atom->getArguments();
+        for (std::size_t j = 0; j < args.size(); j++) {
+            if (!isLeapfrogBound(atom, j, curLevel)) {
+                pattern.push_back(mk<ram::UndefValue>());
+            } else if (const auto* constant = as<ast::Constant>(args[j])) {
+                pattern.push_back(translateConstant(*constant));
+                isBound = true;
+            } else {
+                const auto& name = as<ast::Variable>(args[j])->getName();
+                pattern.push_back(makeRamTupleElement(valueIndex->getDefinitionPoint(name)));
+                isBound = true;
+            }
+        }
+        if (!isBound) {
+            continue;
+        }
+
+        relations.push_back(getClauseAtomName(clause, atom));
+        columns.push_back(*column);
+        patterns.push_back(std::move(pattern));
+    }
+    assert(relations.size() >= 2 && "leapfrog join needs at least two atoms");
+
+    return mk<ram::LeapfrogJoin>(
+            curLevel, std::move(relations), std::move(columns), std::move(patterns), std::move(op));
+}
+
 Own<ram::Operation> ClauseTranslator::addVariableIntroductions(
         const ast::Clause& clause, Own<ram::Operation> op) {
     for (std::size_t p = operators.size(); p > 0; p--) {
@@ -318,6 +450,9 @@ Own<ram::Operation> ClauseTranslator::addVariableIntroductions(
         if (const auto* atom = as<ast::Atom>(curOp)) {
             // add atom arguments through a scan
             op = addAtomScan(std::move(op), atom, clause, i);
+        } else if (const auto* var = as<ast::Variable>(curOp)) {
+            // add the values of a variable shared by atoms through a leapfrog join
+            op = addLeapfrogJoin(std::move(op), clause, var, i);
         } else if (const auto* rec = as<ast::RecordInit>(curOp)) {
             // add record arguments through an unpack
             op = addRecordUnpack(std::move(op), rec, i);
@@ -476,6 +611,12 @@ Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
         values.push_back(context.translateValue(*valueIndex, args[i]));
     }
 
+    // a delta tracked in place is looked up with the tag of the previous iteration
+    if (context.hasDeltaTagging(atom->getQualifiedName())) {
+        name = getConcreteRelationName(atom->getQualifiedName());
+        values.push_back(makeRamDeltaTag());
+    }
+
     return mk<ram::Filter>(
             mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
 }
@@ -496,6 +637,9 @@ Own<ram::Operation> ClauseTranslator::addNegatedAtom(
     for (std::size_t i = 0; i < arity; i++) {
         values.push_back(context.translateValue(*valueIndex, args[i]));
     }
+    if (context.hasDeltaTagging(atom->getQualifiedName())) {
+        values.push_back(mk<ram::UndefValue>());
+    }
     return mk<ram::Filter>(
             mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
 }
@@ -747,8 +891,96 @@ void ClauseTranslator::indexGenerator(const ast::Argument& arg) {
     valueIndex->setGeneratorLoc(arg, Location({aggLoc, 0}));
 }
 
+std::optional<std::size_t> ClauseTranslator::getLeapfrogColumn(
+        const ast::Atom* atom, const std::string& var) const {
+    // leapfrogging seeks in b-tree indexes ordered by signed values
+    const auto* relation = context.getProgram()->getRelation(*atom);
+    const auto representation = relation->getRepresentation();
+    if ((representation != RelationRepresentation::DEFAULT &&
+                representation != RelationRepresentation::BTREE) ||
+            context.hasDeltaTagging(atom->getQualifiedName())) {
+        return std::nullopt;
+    }
+
+    const auto& args = atom->getArguments();
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const auto* arg = as<ast::Variable>(args[i]);
+        if (arg == nullptr || arg->getName() != var) {
+            continue;
+        }
+        const auto type = context.getAttributeTypeQualifier(relation->getAttributes()[i]->getTypeName());
+        if (type[0] == 'f' || type[0] == 'u') {
+            return std::nullopt;
+        }
+        return i;
+    }
+    return std::nullopt;
+}
+
+bool ClauseTranslator::isLeapfrogBound(const ast::Atom* atom, std::size_t column, std::size_t level) const {
+    // floats are not compared bitwise, so their columns are left unbound
+    const auto* relation = context.getProgram()->getRelation(*atom);
+    if (context.getAttributeTypeQualifier(relation->getAttributes()[column]->getTypeName())[0] == 'f') {
+        return false;
+    }
+
+    const auto* arg = atom->getArguments()[column];
+    if (const auto* var = as<ast::Variable>(arg)) {
+        return valueIndex->isDefined(var->getName()) &&
+               valueIndex->getDefinitionPoint(var->getName()).identifier < level;
+    }
+    return isA<ast::Constant>(arg);
+}
+
+const ast::Variable* ClauseTranslator::getLeapfrogVariable(
+        const std::vector<ast::Atom*>& atoms, std::size_t pos) const {
+    std::size_t level = operators.size() + generators.size();
+    auto hasBoundColumn = [&](const ast::Atom* atom) {
+        for (std::size_t i = 0; i < atom->getArity(); i++) {
+            if (isLeapfrogBound(atom, i, level)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // pick the unbound variable of the atom shared by most of the remaining atoms
+    const ast::Variable* best = nullptr;
+    std::size_t bestParts = 1;
+    for (const auto* arg : atoms[pos]->getArguments()) {
+        const auto* var = as<ast::Variable>(arg);
+        if (var == nullptr || valueIndex->isDefined(var->getName())) {
+            continue;
+        }
+        std::size_t numParts = 0;
+        for (std::size_t i = pos; i < atoms.size(); i++) {
+            if (getLeapfrogColumn(atoms[i], var->getName()).has_value() && hasBoundColumn(atoms[i])) {
+                numParts++;
+            }
+        }
+        if (numParts > bestParts) {
+            best = var;
+            bestParts = numParts;
+        }
+    }
+    return best;
+}
+
 void ClauseTranslator::indexAtoms(const ast::Clause& clause) {
-    for (const auto* atom : getAtomOrdering(clause)) {
+    const auto atoms = getAtomOrdering(clause);
+    // leapfrog joins are opt-in, the nested scans remain the default plan of cyclic joins
+    const bool isCyclic = context.getGlobal()->config().has("leapfrog-join") && isCyclicJoin(atoms);
+    for (std::size_t i = 0; i < atoms.size(); i++) {
+        const auto* atom = atoms[i];
+
+        // intersect the atoms sharing a variable of a cyclic join before scanning them
+        if (isCyclic && i > 0) {
+            if (const auto* var = getLeapfrogVariable(atoms, i)) {
+                std::size_t joinLevel = addOperatorLevel(var);
+                valueIndex->addVarReference(var->getName(), joinLevel, 0);
+            }
+        }
+
         // give the atom the current level
         std::size_t scanLevel = addOperatorLevel(atom);
         indexNodeArguments(scanLevel, atom->getArguments());
@@ -20,6 +20,8 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace souffle::ast {
@@ -33,6 +35,7 @@ class IntrinsicFunctor;
 class Node;
 class RecordInit;
 class Relation;
+class Variable;
 }  // namespace souffle::ast
 
 namespace souffle::ram {
@@ -67,6 +70,7 @@ protected:
 
     std::string getClauseString(const ast::Clause& clause) const;
     std::string getClauseAtomName(const ast::Clause& clause, const ast::Atom* atom) const;
+    bool isTaggedDeltaAtom(const ast::Clause& clause, const ast::Atom* atom) const;
 
     virtual Own<ram::Operation> addNegatedAtom(
             Own<ram::Operation> op, const ast::Clause& clause, const ast::Atom* atom) const;
@@ -110,6 +114,13 @@ protected:
             Own<ram::Operation> op, const ast::RecordInit* rec, std::size_t curLevel) const;
     Own<ram::Operation> addAdtUnpack(
             Own<ram::Operation> op, const ast::BranchInit* adt, std::size_t curLevel) const;
+    Own<ram::Operation> addLeapfrogJoin(Own<ram::Operation> op, const ast::Clause& clause,
+            const ast::Variable* var, std::size_t curLevel) const;
+
+    /** Leapfrog joins */
+    std::optional<std::size_t> getLeapfrogColumn(const ast::Atom* atom, const std::string& var) const;
+    bool isLeapfrogBound(const ast::Atom* atom, std::size_t column, std::size_t level) const;
+    const ast::Variable* getLeapfrogVariable(const std::vector<ast::Atom*>& atoms, std::size_t pos) const;
 
     /** Helper methods */
     Own<ram::Operation> addConstantConstraints(
@@ -23,6 +23,7 @@
 #include "ram/EmptinessCheck.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Negation.h"
+#include "ram/UndefValue.h"
 
 namespace souffle::ast2ram::seminaive {
 
@@ -57,6 +58,10 @@ Own<ram::Condition> ConstraintTranslator::visit_(type_identity<ast::Negation>, c
     for (const auto* arg : atom->getArguments()) {
         values.push_back(context.translateValue(index, arg));
     }
+    if (context.hasDeltaTagging(atom->getQualifiedName())) {
+        // the iteration tag of a relation with in-place delta tracking is irrelevant
+        values.push_back(mk<ram::UndefValue>());
+    }
     return mk<ram::Negation>(
             mk<ram::ExistenceCheck>(getConcreteRelationName(atom->getQualifiedName()), std::move(values)));
 }
@@ -21,6 +21,8 @@
 #include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/UserDefinedFunctor.h"
+#include "ast/analysis/PrecedenceGraph.h"
+#include "ast/analysis/SCCGraph.h"
 #include "ast/analysis/TopologicallySortedSCCGraph.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
@@ -43,12 +45,15 @@
 #include "ram/Filter.h"
 #include "ram/IO.h"
 #include "ram/Insert.h"
+#include "ram/IntrinsicAggregator.h"
 #include "ram/IntrinsicOperator.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/Parallel.h"
 #include "ram/Program.h"
@@ -183,7 +188,7 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
         const auto* rel = *sccRelations.begin();
         appendStmt(current, generateNonRecursiveRelation(*rel));
 
-        // lub auxiliary arities using the @lub relation
+        // join the tuples of @new into the lattice relation
         if (rel->getAuxiliaryArity() > 0) {
             std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
             std::string newRelation = getNewRelationName(rel->getQualifiedName());
@@ -274,6 +279,23 @@ Own<ram::Statement> UnitTranslator::generateMergeRelations(
     if (rel->getRepresentation() == RelationRepresentation::EQREL) {
         return mk<ram::MergeExtend>(destRelation, srcRelation);
     }
+
+    // Relations with in-place delta tracking tag the merged tuples with the current iteration
+    if (context->hasDeltaTagging(rel->getQualifiedName()) &&
+            destRelation == getConcreteRelationName(rel->getQualifiedName())) {
+        for (std::size_t i = 0; i < rel->getArity(); i++) {
+            values.push_back(mk<ram::TupleElement>(0, i));
+        }
+        values.push_back(makeRamIterationTag());
+        auto insertion = mk<ram::Insert>(destRelation, std::move(values));
+        return mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
+    }
+
+    // Relations of the same kind are merged in bulk; auxiliary relations (such as @new) of
+    // subsumptive and lattice relations have a different representation than their main relation
+    if (rel->getRepresentation() != RelationRepresentation::BTREE_DELETE && rel->getAuxiliaryArity() == 0) {
+        return mk<ram::Merge>(destRelation, srcRelation);
+    }
     for (std::size_t i = 0; i < rel->getArity(); i++) {
         values.push_back(mk<ram::TupleElement>(0, i));
     }
@@ -335,6 +357,9 @@ Own<ram::Statement> UnitTranslator::translateSubsumptiveRecursiveClauses(
     if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
         return mk<ram::Sequence>(std::move(code));
     }
+    if (context->hasKeyedSubsumption(rel->getQualifiedName())) {
+        return translateKeyedSubsumption(rel);
+    }
 
     std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
     std::string newRelation = getNewRelationName(rel->getQualifiedName());
@@ -385,6 +410,74 @@ Own<ram::Statement> UnitTranslator::translateSubsumptiveRecursiveClauses(
     return mk<ram::Sequence>(std::move(code));
 }
 
+Own<ram::Statement> UnitTranslator::translateKeyedSubsumption(const ast::Relation* rel) const {
+    const KeyedSubsumption& keyed = context->getKeyedSubsumption(rel->getQualifiedName());
+    const std::size_t attribute = keyed.attribute;
+    const BinaryConstraintOp better = keyed.better;
+    const std::size_t arity = rel->getArity();
+
+    std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+    std::string newRelation = getNewRelationName(rel->getQualifiedName());
+    std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+    std::string deleteRelation = getDeleteRelationName(rel->getQualifiedName());
+
+    // tuples at the given level sharing the key of the tuple at level 0, whose value is related to
+    // the value of that tuple by the given constraint
+    auto sameKey = [&](std::size_t level, BinaryConstraintOp op) {
+        Own<ram::Condition> condition = mk<ram::Constraint>(
+                op, mk<ram::TupleElement>(level, attribute), mk<ram::TupleElement>(0, attribute));
+        for (std::size_t i = 0; i < arity; i++) {
+            if (i != attribute) {
+                condition = mk<ram::Conjunction>(std::move(condition),
+                        mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(level, i),
+                                mk<ram::TupleElement>(0, i)));
+            }
+        }
+        return condition;
+    };
+
+    VecOwn<ram::Statement> code;
+    appendStmt(code, mk<ram::Clear>(deltaRelation));
+
+    // the best tuple of @new per key is the delta of the key, unless a stored tuple is at least as good
+    VecOwn<ram::Expression> values;
+    for (std::size_t i = 0; i < arity; i++) {
+        values.push_back(mk<ram::TupleElement>(0, i));
+    }
+    Own<ram::Operation> op = mk<ram::Insert>(deltaRelation, std::move(values));
+    op = mk<ram::Filter>(mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(2, 0),
+                                 mk<ram::SignedConstant>(0)),
+            std::move(op));
+    op = mk<ram::Aggregate>(std::move(op), mk<ram::IntrinsicAggregator>(AggregateOp::COUNT), mainRelation,
+            mk<ram::UndefValue>(), sameKey(2, convertStrictToWeakIneqConstraint(better)), 2);
+    op = mk<ram::Filter>(mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(1, 0),
+                                 mk<ram::SignedConstant>(0)),
+            std::move(op));
+    op = mk<ram::Aggregate>(std::move(op), mk<ram::IntrinsicAggregator>(AggregateOp::COUNT), newRelation,
+            mk<ram::UndefValue>(), sameKey(1, better), 1);
+    appendStmt(code, mk<ram::Query>(mk<ram::Scan>(newRelation, 0, std::move(op))));
+    appendStmt(code, mk<ram::Clear>(newRelation));
+
+    // the delta replaces the stored tuples of its keys, which it dominates
+    for (std::size_t i = 0; i < arity; i++) {
+        values.push_back(mk<ram::TupleElement>(1, i));
+    }
+    op = mk<ram::Insert>(deleteRelation, std::move(values));
+    for (std::size_t i = 0; i < arity; i++) {
+        if (i != attribute) {
+            op = mk<ram::Filter>(mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(1, i),
+                                         mk<ram::TupleElement>(0, i)),
+                    std::move(op));
+        }
+    }
+    op = mk<ram::Scan>(mainRelation, 1, std::move(op));
+    appendStmt(code, mk<ram::Query>(mk<ram::Scan>(deltaRelation, 0, std::move(op))));
+    appendStmt(code, generateEraseTuples(rel, mainRelation, deleteRelation));
+    appendStmt(code, mk<ram::Clear>(deleteRelation));
+
+    return mk<ram::Sequence>(std::move(code));
+}
+
 std::vector<ast::Atom*> UnitTranslator::getSccAtoms(
         const ast::Clause* clause, const ast::RelationSet& scc) const {
     const auto& sccAtoms = filter(ast::getBodyLiterals<ast::Atom>(*clause), [&](const ast::Atom* atom) {
@@ -473,7 +566,7 @@ Own<ram::Statement> UnitTranslator::generateStratumPreamble(const ast::RelationS
         std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
         std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
         appendStmt(preamble, generateNonRecursiveRelation(*rel));
-        // lub tuples using the @lub relation
+        // join the tuples of @new into the lattice relation
         if (rel->getAuxiliaryArity() > 0) {
             std::string newRelation = getNewRelationName(rel->getQualifiedName());
             appendStmt(preamble, generateStratumLubSequence(*rel, false));
@@ -482,8 +575,11 @@ Own<ram::Statement> UnitTranslator::generateStratumPreamble(const ast::RelationS
         appendStmt(preamble, generateNonRecursiveDelete(*rel));
     }
 
-    // Generate code for priming relation
+    // Generate code for priming relation; relations with in-place delta tracking are already primed
     for (const ast::Relation* rel : scc) {
+        if (context->hasDeltaTagging(rel->getQualifiedName())) {
+            continue;
+        }
         std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
         std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
         appendStmt(preamble, generateMergeRelations(rel, deltaRelation, mainRelation));
@@ -504,7 +600,9 @@ Own<ram::Statement> UnitTranslator::generateStratumPostamble(const ast::Relation
     VecOwn<ram::Statement> postamble;
     for (const ast::Relation* rel : scc) {
         // Drop temporary tables after recursion
-        appendStmt(postamble, mk<ram::Clear>(getDeltaRelationName(rel->getQualifiedName())));
+        if (!context->hasDeltaTagging(rel->getQualifiedName())) {
+            appendStmt(postamble, mk<ram::Clear>(getDeltaRelationName(rel->getQualifiedName())));
+        }
         appendStmt(postamble, mk<ram::Clear>(getNewRelationName(rel->getQualifiedName())));
     }
     return mk<ram::Sequence>(std::move(postamble));
@@ -522,9 +620,13 @@ Own<ram::Statement> UnitTranslator::generateStratumTableUpdates(const ast::Relat
         // swap new and and delta relation and clear new relation afterwards (if not a subsumptive relation)
         Own<ram::Statement> updateRelTable;
         if (rel->getAuxiliaryArity() > 0) {
-            updateRelTable =
-                    mk<ram::Sequence>(mk<ram::Clear>(deltaRelation), generateStratumLubSequence(*rel, true),
-                            generateMergeRelations(rel, mainRelation, deltaRelation));
+            // the tuples of @new are joined into the main relation in place
+            updateRelTable = mk<ram::Sequence>(
+                    mk<ram::Clear>(deltaRelation), generateStratumLubSequence(*rel, true));
+        } else if (context->hasDeltaTagging(rel->getQualifiedName())) {
+            // the tuples of @new become the delta of the next iteration by being tagged
+            updateRelTable = mk<ram::Sequence>(
+                    generateMergeRelations(rel, mainRelation, newRelation), mk<ram::Clear>(newRelation));
         } else if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
             updateRelTable = mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
                     mk<ram::Swap>(deltaRelation, newRelation), mk<ram::Clear>(newRelation));
@@ -586,131 +688,36 @@ Own<ram::Statement> UnitTranslator::generateStratumLoopBody(const ast::RelationS
 }
 
 /// assuming the @new() relation is populated with new tuples, generate RAM code
-/// to populate the @delta() relation with the lubbed elements from @new()
+/// to join them into the relation, populating the @delta() relation with the
+/// tuples whose lattice values rose
 Own<ram::Statement> UnitTranslator::generateStratumLubSequence(
         const ast::Relation& rel, bool inRecursiveLoop) const {
-    VecOwn<ram::Statement> stmts;
     assert(rel.getAuxiliaryArity() > 0);
 
     auto attributes = rel.getAttributes();
     std::string name = getConcreteRelationName(rel.getQualifiedName());
-    std::string lubName = getLubRelationName(rel.getQualifiedName());
     std::string newName = getNewRelationName(rel.getQualifiedName());
 
-    const std::size_t arity = rel.getArity();
-    const std::size_t auxiliaryArity = rel.getAuxiliaryArity();
-
-    // Step 1 : populate @lub() from @new()
-    VecOwn<ram::Expression> values;
-
-    // index of the first auxiliary element of the relation
-    std::size_t firstAuxiliary = arity - auxiliaryArity;
-
-    for (std::size_t i = 0; i < arity; i++) {
-        if (i >= firstAuxiliary) {
-            values.push_back(mk<ram::TupleElement>(i - firstAuxiliary + 1, 0));
-        } else {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
+    // the auxiliary attributes of a stored tuple t0 are joined with those of an inserted tuple t1
+    VecOwn<ram::Expression> joins;
+    for (std::size_t i = rel.getArity() - rel.getAuxiliaryArity(); i < rel.getArity(); i++) {
+        assert(attributes[i]->getIsLattice());
+        VecOwn<ram::Expression> args;
+        args.push_back(mk<ram::TupleElement>(0, i));
+        args.push_back(mk<ram::TupleElement>(1, i));
+        joins.push_back(context->getLatticeTypeLubFunctor(attributes[i]->getTypeName(), std::move(args)));
     }
-    Own<ram::Operation> op = mk<ram::Insert>(lubName, std::move(values));
-
-    for (std::size_t i = arity; i >= firstAuxiliary + 1; i--) {
-        const auto type = attributes[i - 1]->getTypeName();
-        std::size_t level = i - firstAuxiliary;
-        auto aggregator = context->getLatticeTypeLubAggregator(type, mk<ram::TupleElement>(0, i - 1));
-        Own<ram::Condition> condition = mk<ram::Constraint>(
-                BinaryConstraintOp::NE, mk<ram::TupleElement>(level, i - 1), mk<ram::TupleElement>(0, i - 1));
-        for (std::size_t j = 0; j < attributes.size(); j++) {
-            if (attributes[j]->getIsLattice()) break;
-            condition = mk<ram::Conjunction>(std::move(condition),
-                    mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(level, j),
-                            mk<ram::TupleElement>(0, j)));
-        }
-        op = mk<ram::Aggregate>(std::move(op), std::move(aggregator), newName,
-                mk<ram::TupleElement>(level, i - 1), std::move(condition), level);
-    }
-
-    op = mk<ram::Scan>(newName, 0, std::move(op));
-    appendStmt(stmts, mk<ram::Query>(std::move(op)));
-
-    // clear @new() now that we no longer need it
-    appendStmt(stmts, mk<ram::Clear>(newName));
 
+    Own<ram::Statement> merge;
     if (inRecursiveLoop) {
-        // Step 2 : populate @delta() from @lub() for tuples that have to be lubbed with @concrete
         std::string deltaName = getDeltaRelationName(rel.getQualifiedName());
-
-        Own<ram::Condition> condition;
-        for (std::size_t i = 0; i < arity; i++) {
-            if (i < firstAuxiliary) {
-                values.push_back(mk<ram::TupleElement>(0, i));
-            } else {
-                assert(attributes[i]->getIsLattice());
-                const auto type = attributes[i]->getTypeName();
-                VecOwn<ram::Expression> args;
-                args.push_back(mk<ram::TupleElement>(0, i));
-                args.push_back(mk<ram::TupleElement>(1, i));
-                auto lub = context->getLatticeTypeLubFunctor(type, std::move(args));
-                auto cst =
-                        mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(1, i), clone(lub));
-                if (condition) {
-                    condition = mk<ram::Conjunction>(std::move(condition), std::move(cst));
-                } else {
-                    condition = std::move(cst);
-                }
-                values.push_back(std::move(lub));
-            }
-        }
-        op = mk<ram::Insert>(deltaName, std::move(values));
-        op = mk<ram::Filter>(mk<ram::Negation>(std::move(condition)), std::move(op));
-
-        for (std::size_t i = 0; i < arity - auxiliaryArity; i++) {
-            auto cst = mk<ram::Constraint>(
-                    BinaryConstraintOp::EQ, mk<ram::TupleElement>(0, i), mk<ram::TupleElement>(1, i));
-            if (condition) {
-                condition = mk<ram::Conjunction>(std::move(condition), std::move(cst));
-            } else {
-                condition = std::move(cst);
-            }
-        }
-        if (condition) {
-            op = mk<ram::Filter>(std::move(condition), std::move(op));
-        }
-        op = mk<ram::Scan>(name, 1, std::move(op));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
-
-        // Step 3 : populate @delta() from @lub() for tuples that have nothing to lub in @concrete
-        for (std::size_t i = 0; i < arity; i++) {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
-        op = mk<ram::Insert>(deltaName, std::move(values));
-        for (std::size_t i = 0; i < arity; i++) {
-            if (i < firstAuxiliary) {
-                values.push_back(mk<ram::TupleElement>(0, i));
-            } else {
-                values.push_back(mk<ram::UndefValue>());
-            }
-        }
-        op = mk<ram::Filter>(
-                mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
+        merge = mk<ram::MergeLattice>(name, newName, deltaName, std::move(joins));
     } else {
-        // we are not in the recursive loop, so the concrete relation is empty for now
-        // we can just insert the content of the @lub relation into the concrete one
-        for (std::size_t i = 0; i < arity; i++) {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
-        op = mk<ram::Insert>(name, std::move(values));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
+        merge = mk<ram::MergeLattice>(name, newName, std::move(joins));
     }
 
-    appendStmt(stmts, mk<ram::Clear>(lubName));
-
-    return mk<ram::Sequence>(std::move(stmts));
+    // clear @new() now that we no longer need it
+    return mk<ram::Sequence>(std::move(merge), mk<ram::Clear>(newName));
 }
 
 Own<ram::Statement> UnitTranslator::generateStratumExitSequence(const ast::RelationSet& scc) const {
@@ -782,8 +789,10 @@ Own<ram::Statement> UnitTranslator::generateRecursiveStratum(
 }
 
 void UnitTranslator::addAuxiliaryArity(
-        const ast::Relation* /* relation */, std::map<std::string, std::string>& directives) const {
-    directives.insert(std::make_pair("auxArity", "0"));
+        const ast::Relation* relation, std::map<std::string, std::string>& directives) const {
+    // the iteration tag of relations with in-place delta tracking is not part of their I/O
+    const bool tagged = context->hasDeltaTagging(relation->getQualifiedName());
+    directives.insert(std::make_pair("auxArity", tagged ? "1" : "0"));
 }
 
 Own<ram::Statement> UnitTranslator::generateLoadRelation(const ast::Relation* relation) const {
@@ -849,13 +858,24 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
 
     std::vector<std::string> attributeNames;
     std::vector<std::string> attributeTypeQualifiers;
+    std::vector<std::size_t> attributeDomainSizes;
     for (const auto& attribute : baseRelation->getAttributes()) {
         attributeNames.push_back(attribute->getName());
         attributeTypeQualifiers.push_back(context->getAttributeTypeQualifier(attribute->getTypeName()));
+        attributeDomainSizes.push_back(context->getAttributeDomainSize(attribute->getTypeName()));
+    }
+
+    // Relations with in-place delta tracking carry the iteration deriving a tuple as an extra column
+    if (context->hasDeltaTagging(baseRelation->getQualifiedName()) &&
+            ramRelationName == getConcreteRelationName(baseRelation->getQualifiedName())) {
+        arity++;
+        attributeNames.push_back("@iteration");
+        attributeTypeQualifiers.push_back("u:unsigned");
+        attributeDomainSizes.push_back(0);
     }
 
-    return mk<ram::Relation>(
-            ramRelationName, arity, auxArity, attributeNames, attributeTypeQualifiers, representation);
+    return mk<ram::Relation>(ramRelationName, arity, auxArity, attributeNames, attributeTypeQualifiers,
+            representation, attributeDomainSizes);
 }
 
 VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::size_t>& sccOrdering) const {
@@ -867,12 +887,6 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
             std::string mainName = getConcreteRelationName(rel->getQualifiedName());
             ramRelations.push_back(createRamRelation(rel, mainName));
 
-            if (rel->getAuxiliaryArity() > 0) {
-                // Add lub relation
-                std::string lubName = getLubRelationName(rel->getQualifiedName());
-                ramRelations.push_back(createRamRelation(rel, lubName));
-            }
-
             if (isRecursive || rel->getAuxiliaryArity() > 0) {
                 // Add new relation
                 std::string newName = getNewRelationName(rel->getQualifiedName());
@@ -881,15 +895,19 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
 
             // Recursive relations also require @delta and @new variants, with the same signature
             if (isRecursive) {
-                // Add delta relation
-                std::string deltaName = getDeltaRelationName(rel->getQualifiedName());
-                ramRelations.push_back(createRamRelation(rel, deltaName));
+                // Add delta relation, unless it is tracked in place
+                if (!context->hasDeltaTagging(rel->getQualifiedName())) {
+                    std::string deltaName = getDeltaRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, deltaName));
+                }
 
                 // Add auxiliary relation for subsumption
                 if (context->hasSubsumptiveClause(rel->getQualifiedName())) {
-                    // Add reject relation
-                    std::string rejectName = getRejectRelationName(rel->getQualifiedName());
-                    ramRelations.push_back(createRamRelation(rel, rejectName));
+                    // Add reject relation, unless a single best tuple is kept per key
+                    if (!context->hasKeyedSubsumption(rel->getQualifiedName())) {
+                        std::string rejectName = getRejectRelationName(rel->getQualifiedName());
+                        ramRelations.push_back(createRamRelation(rel, rejectName));
+                    }
 
                     // Add deletion relation
                     std::string toEraseName = getDeleteRelationName(rel->getQualifiedName());
@@ -912,6 +930,7 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
     }
     const auto& sccOrdering =
             translationUnit.getAnalysis<ast::analysis::TopologicallySortedSCCGraphAnalysis>().order();
+    const bool concurrentStrata = glb->config().has("parallel-strata");
     VecOwn<ram::Statement> res;
 
     // Create subroutines for each SCC according to topological order
@@ -919,9 +938,11 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         // Generate the main stratum code
         auto stratum = generateStratum(sccOrdering.at(i));
 
-        // Clear expired relations
-        const auto& expiredRelations = context->getExpiredRelations(i);
-        stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        // Clear expired relations, concurrent strata clear them once all readers completed
+        if (!concurrentStrata) {
+            const auto& expiredRelations = context->getExpiredRelations(i);
+            stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        }
 
         // Add the subroutine
         const ast::Relation* rel = *context->getRelationsInSCC(sccOrdering.at(i)).begin();
@@ -933,6 +954,10 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         appendStmt(res, mk<ram::Call>("stratum_" + stratumID));
     }
 
+    if (concurrentStrata) {
+        res = generateConcurrentStrata(translationUnit, std::move(res));
+    }
+
     // Add main timer if profiling
     if (!res.empty() && glb->config().has("profile")) {
         auto newStmt = mk<ram::LogTimer>(mk<ram::Sequence>(std::move(res)), LogStatement::runtime());
@@ -944,6 +969,63 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
     return mk<ram::Sequence>(std::move(res));
 }
 
+VecOwn<ram::Statement> UnitTranslator::generateConcurrentStrata(
+        const ast::TranslationUnit& translationUnit, VecOwn<ram::Statement> strata) const {
+    const auto& sccGraph = translationUnit.getAnalysis<ast::analysis::SCCGraphAnalysis>();
+    const auto& precedenceGraph = translationUnit.getAnalysis<ast::analysis::PrecedenceGraphAnalysis>();
+    const auto& sccOrdering =
+            translationUnit.getAnalysis<ast::analysis::TopologicallySortedSCCGraphAnalysis>().order();
+
+    // A stratum is evaluated in the wave after the latest wave of the strata it depends on
+    std::map<std::size_t, std::size_t> sccWave;
+    std::vector<std::size_t> waves(sccOrdering.size());
+    std::size_t numWaves = 0;
+    for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+        std::size_t wave = 0;
+        for (std::size_t pred : sccGraph.getPredecessorSCCs(sccOrdering.at(i))) {
+            wave = std::max(wave, sccWave.at(pred) + 1);
+        }
+        sccWave[sccOrdering.at(i)] = wave;
+        waves[i] = wave;
+        numWaves = std::max(numWaves, wave + 1);
+    }
+
+    // An expired relation is cleared after the latest wave of the strata computing or reading it
+    std::map<const ast::Relation*, std::size_t> lastReadWave;
+    for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+        for (const auto* rel : sccGraph.getInternalRelations(sccOrdering.at(i))) {
+            lastReadWave[rel] = std::max(lastReadWave[rel], waves[i]);
+            for (const auto* pred : precedenceGraph.graph().predecessors(rel)) {
+                lastReadWave[pred] = std::max(lastReadWave[pred], waves[i]);
+            }
+        }
+    }
+    std::vector<ast::RelationSet> expiredRelations(numWaves);
+    for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+        for (const auto* rel : context->getExpiredRelations(i)) {
+            expiredRelations[lastReadWave[rel]].insert(rel);
+        }
+    }
+
+    // The strata of a wave are independent of each other and evaluated concurrently
+    std::vector<VecOwn<ram::Statement>> waveStrata(numWaves);
+    for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+        waveStrata[waves[i]].push_back(std::move(strata[i]));
+    }
+    VecOwn<ram::Statement> res;
+    for (std::size_t wave = 0; wave < numWaves; wave++) {
+        if (waveStrata[wave].size() == 1) {
+            appendStmt(res, std::move(waveStrata[wave].front()));
+        } else {
+            appendStmt(res, mk<ram::Parallel>(std::move(waveStrata[wave])));
+        }
+        if (!expiredRelations[wave].empty()) {
+            appendStmt(res, generateClearExpiredRelations(expiredRelations[wave]));
+        }
+    }
+    return res;
+}
+
 Own<ram::TranslationUnit> UnitTranslator::translateUnit(ast::TranslationUnit& tu) {
     glb = &tu.global();
 
@@ -59,6 +59,7 @@ protected:
             const ast::RelationSet& scc, const ast::Relation* rel) const;
     Own<ram::Statement> translateSubsumptiveRecursiveClauses(
             const ast::RelationSet& scc, const ast::Relation* rel) const;
+    Own<ram::Statement> translateKeyedSubsumption(const ast::Relation* rel) const;
     VecOwn<ram::Statement> generateClauseVersions(
             const ast::Clause* clause, const ast::RelationSet& scc) const;
     std::vector<ast::Atom*> getSccAtoms(const ast::Clause* clause, const ast::RelationSet& scc) const;
@@ -70,6 +71,8 @@ protected:
 
     /** High-level relation translation */
     virtual Own<ram::Sequence> generateProgram(const ast::TranslationUnit& translationUnit);
+    VecOwn<ram::Statement> generateConcurrentStrata(
+            const ast::TranslationUnit& translationUnit, VecOwn<ram::Statement> strata) const;
     Own<ram::Statement> generateNonRecursiveRelation(const ast::Relation& rel) const;
     Own<ram::Statement> generateRecursiveStratum(const ast::RelationSet& scc, std::size_t sccNum) const;
 
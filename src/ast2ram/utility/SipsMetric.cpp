@@ -23,6 +23,7 @@
 #include "ast/analysis/ProfileUse.h"
 #include "ast/analysis/SCCGraph.h"
 #include "ast/analysis/typesystem/PolymorphicObjects.h"
+#include "ast/transform/MaterializeHotJoins.h"
 #include "ast/utility/BindingStore.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
@@ -42,6 +43,94 @@
 
 namespace souffle::ast {
 
+namespace {
+
+/** Translates an AST constant to the RAM constant of the profiled join-size statistics */
+Own<ram::Expression> translateConstant(
+        const analysis::PolymorphicObjectsAnalysis& poly, const ast::Constant& constant) {
+    if (auto strConstant = as<ast::StringConstant>(constant)) {
+        return mk<ram::StringConstant>(strConstant->getConstant());
+    } else if (isA<ast::NilConstant>(&constant)) {
+        return mk<ram::SignedConstant>(0);
+    } else if (auto* numConstant = as<ast::NumericConstant>(constant)) {
+        switch (poly.getInferredType(*numConstant)) {
+            case ast::NumericConstant::Type::Int:
+                return mk<ram::SignedConstant>(RamSignedFromString(numConstant->getConstant(), nullptr, 0));
+            case ast::NumericConstant::Type::Uint:
+                return mk<ram::UnsignedConstant>(
+                        RamUnsignedFromString(numConstant->getConstant(), nullptr, 0));
+            case ast::NumericConstant::Type::Float:
+                return mk<ram::FloatConstant>(RamFloatFromString(numConstant->getConstant()));
+        }
+    }
+    fatal("unaccounted-for constant");
+    return nullptr;
+}
+
+/** Looks up the size of a join with an atom in the statistics of the profile */
+double getProfileJoinSize(const analysis::ProfileUseAnalysis& prof, bool isRecursive, const std::string& rel,
+        std::set<std::size_t> joinKeys, const std::map<std::size_t, const ram::Expression*>& constantsMap,
+        const std::string& iteration) {
+    std::map<std::size_t, std::string> constantsStringMap;
+    for (auto& [k, v] : constantsMap) {
+        joinKeys.insert(k);
+        std::stringstream ss;
+        ss << *v;
+        constantsStringMap.insert(std::make_pair(k, ss.str()));
+    }
+
+    if (joinKeys.empty() && !isRecursive) {
+        return static_cast<double>(prof.getRelationSize(QualifiedName::fromString(rel)));
+    }
+
+    std::stringstream ss;
+    ss << joinKeys;
+    std::string attributes = ss.str();
+
+    std::stringstream cc;
+    cc << constantsStringMap;
+    std::string constants = cc.str();
+
+    try {
+        if (isRecursive) {
+            return prof.getRecursiveJoinSize(rel, attributes, constants, iteration);
+        } else {
+            return prof.getNonRecursiveJoinSize(rel, attributes, constants);
+        }
+    } catch (...) {
+        fatal("Error: profile used for auto-scheduling doesn't match the provided program.");
+    }
+}
+
+/**
+ * Tests whether the profile covers the relations of a clause. Joins materialised after
+ * profiling are not in the profile, their sizes are estimated from the relations they join.
+ */
+bool isProfiled(const analysis::ProfileUseAnalysis& prof, const Clause& clause) {
+    auto isCovered = [&](const Atom* atom) {
+        const auto& name = atom->getQualifiedName();
+        return prof.hasRelationSize(name) ||
+               transform::MaterializeHotJoinsTransformer::isMaterializedJoin(name);
+    };
+    return isCovered(clause.getHead()) && all_of(getBodyLiterals<Atom>(clause), isCovered);
+}
+
+/** Estimates the size of a join materialised after profiling by the largest relation it joins */
+double getMaterializedJoinSize(
+        const analysis::ProfileUseAnalysis& prof, const Program& program, const QualifiedName& name) {
+    std::size_t size = 1;
+    for (const auto* clause : program.getClauses(name)) {
+        for (const auto* atom : getBodyLiterals<Atom>(*clause)) {
+            if (prof.hasRelationSize(atom->getQualifiedName())) {
+                size = std::max(size, prof.getRelationSize(atom->getQualifiedName()));
+            }
+        }
+    }
+    return static_cast<double>(size);
+}
+
+}  // namespace
+
 SipsMetric::SipsMetric(const TranslationUnit& tu) : program(tu.getProgram()) {
     sccGraph = &tu.getAnalysis<ast::analysis::SCCGraphAnalysis>();
 }
@@ -84,12 +173,25 @@ std::vector<std::size_t> StaticSipsMetric::getReordering(
 }
 
 SelingerProfileSipsMetric::SelingerProfileSipsMetric(const TranslationUnit& tu) : SipsMetric(tu) {
-    profileUseAnalysis = &tu.getAnalysis<ast::analysis::ProfileUseAnalysis>();
+    if (tu.global().config().has("auto-schedule")) {
+        profileUseAnalysis = &tu.getAnalysis<ast::analysis::ProfileUseAnalysis>();
+    }
     polyAnalysis = &tu.getAnalysis<ast::analysis::PolymorphicObjectsAnalysis>();
+    unprofiledSips = mk<AllBoundSips>(tu);
 }
 
 std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
         const Clause* clause, const std::vector<std::string>& atomNames) const {
+    if (!isProfiled(*profileUseAnalysis, *clause)) {
+        return unprofiledSips->getReordering(clause, atomNames);
+    }
+
+    assert(profileUseAnalysis->hasAutoSchedulerStats() && "Must have stats in order to auto-schedule!");
+    return getSelingerOrdering(clause, atomNames, profileUseAnalysis);
+}
+
+std::vector<std::size_t> SelingerProfileSipsMetric::getSelingerOrdering(const Clause* clause,
+        const std::vector<std::string>& atomNames, const ast::analysis::ProfileUseAnalysis* prof) const {
     auto atoms = ast::getBodyLiterals<ast::Atom>(*clause);
 
     // remember to exit for single atom bodies
@@ -102,25 +204,8 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
 
     // create ast constant translator
     auto* poly = polyAnalysis;
-    auto astConstantTranslator = [poly](const ast::Constant& constant) -> Own<ram::Expression> {
-        if (auto strConstant = as<ast::StringConstant>(constant)) {
-            return mk<ram::StringConstant>(strConstant->getConstant());
-        } else if (isA<ast::NilConstant>(&constant)) {
-            return mk<ram::SignedConstant>(0);
-        } else if (auto* numConstant = as<ast::NumericConstant>(constant)) {
-            switch (poly->getInferredType(*numConstant)) {
-                case ast::NumericConstant::Type::Int:
-                    return mk<ram::SignedConstant>(
-                            RamSignedFromString(numConstant->getConstant(), nullptr, 0));
-                case ast::NumericConstant::Type::Uint:
-                    return mk<ram::UnsignedConstant>(
-                            RamUnsignedFromString(numConstant->getConstant(), nullptr, 0));
-                case ast::NumericConstant::Type::Float:
-                    return mk<ram::FloatConstant>(RamFloatFromString(numConstant->getConstant()));
-            }
-        }
-        fatal("unaccounted-for constant");
-        return nullptr;
+    auto astConstantTranslator = [poly](const ast::Constant& constant) {
+        return translateConstant(*poly, constant);
     };
 
     SipGraph sipGraph(clause, astConstantTranslator);
@@ -131,41 +216,28 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
     auto sccAtoms = filter(ast::getBodyLiterals<ast::Atom>(*clause),
             [&](auto* atom) { return contains(sccRelations, program.getRelation(*atom)); });
 
-    assert(profileUseAnalysis->hasAutoSchedulerStats() && "Must have stats in order to auto-schedule!");
-
-    auto* prof = profileUseAnalysis;
-    auto getJoinSize = [&prof](bool isRecursive, const std::string& rel, std::set<std::size_t> joinKeys,
-                               const std::map<std::size_t, const ram::Expression*>& constantsMap,
-                               const std::string& iteration) {
-        std::map<std::size_t, std::string> constantsStringMap;
+    // without statistics, assume deltas to be a fraction of their relation and each bound
+    // column to be equally selective
+    auto getJoinSize = [&](bool isRecursive, const std::string& rel, std::set<std::size_t> joinKeys,
+                          const std::map<std::size_t, const ram::Expression*>& constantsMap,
+                          const std::string& iteration, const Atom* atom) {
+        if (prof != nullptr && prof->hasRelationSize(atom->getQualifiedName())) {
+            return getProfileJoinSize(*prof, isRecursive, rel, joinKeys, constantsMap, iteration);
+        }
+        if (atom->getArity() == 0) {
+            return 1.0;
+        }
         for (auto& [k, v] : constantsMap) {
             joinKeys.insert(k);
-            std::stringstream ss;
-            ss << *v;
-            constantsStringMap.insert(std::make_pair(k, ss.str()));
         }
-
-        if (joinKeys.empty() && !isRecursive) {
-            return static_cast<double>(prof->getRelationSize(QualifiedName::fromString(rel)));
-        }
-
-        std::stringstream ss;
-        ss << joinKeys;
-        std::string attributes = ss.str();
-
-        std::stringstream cc;
-        cc << constantsStringMap;
-        std::string constants = cc.str();
-
-        try {
-            if (isRecursive) {
-                return prof->getRecursiveJoinSize(rel, attributes, constants, iteration);
-            } else {
-                return prof->getNonRecursiveJoinSize(rel, attributes, constants);
-            }
-        } catch (...) {
-            fatal("Error: profile used for auto-scheduling doesn't match the provided program.");
+        double size = 0;
+        if (prof != nullptr) {
+            size = getMaterializedJoinSize(*prof, program, atom->getQualifiedName());
+        } else {
+            size = isPrefix("@delta_", rel) ? DEFAULT_SIZE / 10 : DEFAULT_SIZE;
         }
+        return std::pow(size, 1.0 - static_cast<double>(joinKeys.size()) /
+                                            static_cast<double>(atom->getArity()));
     };
 
     AtomSet recursiveInCurrentStratum;
@@ -185,7 +257,7 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
     for (std::size_t i = 0; i < atoms.size(); ++i) {
         std::string name = atomNames[i];
         bool isRecursive = recursiveInCurrentStratum.count(i) > 0;
-        if (isRecursive) {
+        if (isRecursive && prof != nullptr) {
             iterations = prof->getIterations(name);
             break;
         }
@@ -201,8 +273,8 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
         PlanTuplesCost p;
         p.plan = plan;
         for (std::size_t iter = 0; iter < iterations; ++iter) {
-            double tuples =
-                    getJoinSize(isRecursive, name, {}, sipGraph.getConstantsMap(atom), std::to_string(iter));
+            double tuples = getJoinSize(
+                    isRecursive, name, {}, sipGraph.getConstantsMap(atom), std::to_string(iter), atom);
             double cost = static_cast<double>(tuples * atom->getArity());
             p.tuplesPerIteration.push_back(tuples);
             p.costsPerIteration.push_back(cost);
@@ -257,9 +329,9 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
                     if (numBound == to->getArity()) {
                         expectedTuples = 1;
                     } else {
-                        // get the join size from the profile
+                        // get the join size from the profile or its estimate
                         expectedTuples = getJoinSize(isRecursive, atomNames[atomIdx], joinColumns,
-                                constantsMap, std::to_string(iter));
+                                constantsMap, std::to_string(iter), to);
                     }
 
                     // calculate new number of tuples
@@ -307,9 +379,26 @@ std::vector<std::size_t> SelingerProfileSipsMetric::getReordering(
     return newOrder;
 }
 
+std::vector<std::size_t> DynamicProgrammingSips::getReordering(
+        const Clause* clause, const std::vector<std::string>& atomNames) const {
+    if (getBodyLiterals<Atom>(*clause).size() > MAX_ATOMS) {
+        return unprofiledSips->getReordering(clause, atomNames);
+    }
+
+    const auto* prof = profileUseAnalysis;
+    if (prof != nullptr && !isProfiled(*prof, *clause)) {
+        prof = nullptr;
+    }
+    assert((prof == nullptr || prof->hasAutoSchedulerStats()) &&
+            "Must have stats in order to auto-schedule!");
+    return getSelingerOrdering(clause, atomNames, prof);
+}
+
 /** Create a SIPS metric based on a given heuristic. */
 std::unique_ptr<SipsMetric> SipsMetric::create(const std::string& heuristic, const TranslationUnit& tu) {
-    if (tu.global().config().has("auto-schedule")) {
+    if (heuristic == "dp")
+        return mk<DynamicProgrammingSips>(tu);
+    else if (tu.global().config().has("auto-schedule")) {
         return mk<SelingerProfileSipsMetric>(tu);
     } else if (heuristic == "strict")
         return mk<StrictSips>(tu);
@@ -80,6 +80,24 @@ public:
     using AtomSet = std::set<std::size_t>;
     using ArgIdx = std::size_t;
 
+protected:
+    /**
+     * Selinger's algorithm: finds the cheapest join order by dynamic programming over all
+     * subsets of the body atoms. Join sizes are taken from the given profile, or estimated
+     * from the bound columns of each atom if there is none.
+     */
+    std::vector<std::size_t> getSelingerOrdering(const Clause* clause,
+            const std::vector<std::string>& atomNames, const ast::analysis::ProfileUseAnalysis* prof) const;
+
+    /** Assumed relation size in the absence of profile statistics */
+    static constexpr double DEFAULT_SIZE = 10000;
+
+    const ast::analysis::PolymorphicObjectsAnalysis* polyAnalysis = nullptr;
+    const ast::analysis::ProfileUseAnalysis* profileUseAnalysis = nullptr;
+
+    /** Metric for clauses over relations introduced after profiling */
+    Own<SipsMetric> unprofiledSips;
+
 private:
     /* helper struct for Selinger */
     struct PlanTuplesCost {
@@ -87,9 +105,21 @@ private:
         std::vector<double> tuplesPerIteration;
         std::vector<double> costsPerIteration;
     };
+};
 
-    const ast::analysis::PolymorphicObjectsAnalysis* polyAnalysis = nullptr;
-    const ast::analysis::ProfileUseAnalysis* profileUseAnalysis = nullptr;
+/**
+ * Goal: minimise the estimated cost of the whole join order rather than of the next atom.
+ * Runs Selinger's algorithm with the profile when auto-scheduling, and with join sizes
+ * estimated from the bound columns of each atom otherwise.
+ */
+class DynamicProgrammingSips : public SelingerProfileSipsMetric {
+public:
+    DynamicProgrammingSips(const TranslationUnit& tu) : SelingerProfileSipsMetric(tu) {}
+    std::vector<std::size_t> getReordering(
+            const Clause* clause, const std::vector<std::string>& atomNames) const override;
+
+    /** Bodies with more atoms than this are ordered by the all-bound SIPS instead */
+    static constexpr std::size_t MAX_ATOMS = 12;
 };
 
 class StaticSipsMetric : public SipsMetric {
@@ -14,16 +14,20 @@
 
 #include "ast2ram/utility/TranslatorContext.h"
 #include "Global.h"
+#include "RelationTag.h"
 #include "ast/Aggregator.h"
 #include "ast/Atom.h"
+#include "ast/BinaryConstraint.h"
 #include "ast/BranchInit.h"
 #include "ast/Directive.h"
 #include "ast/Functor.h"
 #include "ast/IntrinsicFunctor.h"
 #include "ast/QualifiedName.h"
+#include "ast/Relation.h"
 #include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/UserDefinedAggregator.h"
+#include "ast/Variable.h"
 #include "ast/analysis/Functor.h"
 #include "ast/analysis/IOType.h"
 #include "ast/analysis/JoinSize.h"
@@ -49,7 +53,6 @@
 #include "ram/IntrinsicOperator.h"
 #include "ram/Statement.h"
 #include "ram/UndefValue.h"
-#include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/StringUtil.h"
@@ -58,6 +61,74 @@
 
 namespace souffle::ast2ram {
 
+namespace {
+/**
+ * Checks whether a subsumptive clause has the form
+ *     R(k1, ..., v1, ..., kn) <= R(k1, ..., v2, ..., kn) :- v1 < v2.
+ * i.e., it orders the tuples agreeing on all attributes but one by that attribute.
+ */
+std::optional<KeyedSubsumption> analyseKeyedSubsumption(
+        const ast::Clause& clause, const ast::analysis::PolymorphicObjectsAnalysis& polyAnalysis) {
+    const auto body = clause.getBodyLiterals();
+    if (body.size() != 3) {
+        return std::nullopt;
+    }
+    const auto* dominated = as<ast::Atom>(body[0]);
+    const auto* dominating = as<ast::Atom>(body[1]);
+    const auto* constraint = as<ast::BinaryConstraint>(body[2]);
+    if (dominated == nullptr || dominating == nullptr || constraint == nullptr) {
+        return std::nullopt;
+    }
+
+    // all attributes but one are bound to the same distinct variables in both atoms
+    const auto dominatedArgs = dominated->getArguments();
+    const auto dominatingArgs = dominating->getArguments();
+    std::optional<std::size_t> attribute;
+    std::set<std::string> names;
+    for (std::size_t i = 0; i < dominatedArgs.size(); i++) {
+        const auto* lhs = as<ast::Variable>(dominatedArgs[i]);
+        const auto* rhs = as<ast::Variable>(dominatingArgs[i]);
+        if (lhs == nullptr || rhs == nullptr || !names.insert(lhs->getName()).second) {
+            return std::nullopt;
+        }
+        if (lhs->getName() == rhs->getName()) {
+            continue;
+        }
+        if (attribute.has_value() || !names.insert(rhs->getName()).second) {
+            return std::nullopt;
+        }
+        attribute = i;
+    }
+    if (!attribute.has_value()) {
+        return std::nullopt;
+    }
+
+    // the constraint orders the values of the attribute numerically
+    const BinaryConstraintOp op = polyAnalysis.getOverloadedOperator(*constraint);
+    const auto* lhs = as<ast::Variable>(constraint->getLHS());
+    const auto* rhs = as<ast::Variable>(constraint->getRHS());
+    if (!isIneqConstraint(op) || lhs == nullptr || rhs == nullptr) {
+        return std::nullopt;
+    }
+    const std::string& dominatedValue = as<ast::Variable>(dominatedArgs[*attribute])->getName();
+    const std::string& dominatingValue = as<ast::Variable>(dominatingArgs[*attribute])->getName();
+    bool dominatingIsGreater = isLessThan(op) || isLessEqual(op);
+    if (lhs->getName() == dominatingValue && rhs->getName() == dominatedValue) {
+        dominatingIsGreater = !dominatingIsGreater;
+    } else if (lhs->getName() != dominatedValue || rhs->getName() != dominatingValue) {
+        return std::nullopt;
+    }
+
+    // distinct tuples of a key have distinct values, hence the strict constraint
+    const auto type = getBinaryConstraintTypes(op).front();
+    const std::string qualifier = (type == TypeAttribute::Float)      ? "f"
+                                  : (type == TypeAttribute::Unsigned) ? "u"
+                                                                      : "i";
+    return KeyedSubsumption{*attribute,
+            dominatingIsGreater ? getGreaterThanConstraint(qualifier) : getLessThanConstraint(qualifier)};
+}
+}  // namespace
+
 TranslatorContext::TranslatorContext(const ast::TranslationUnit& tu) {
     program = &tu.getProgram();
     global = &tu.global();
@@ -92,8 +163,8 @@ TranslatorContext::TranslatorContext(const ast::TranslationUnit& tu) {
     }
     sipsMetric = ast::SipsMetric::create(sipsChosen, tu);
 
-    // Set up the correct strategy
-    if (global->config().has("provenance")) {
+    // Set up the correct strategy, lazy provenance evaluates the clauses without annotations
+    if (global->config().has("provenance") && !global->config().has("lazy-provenance")) {
         translationStrategy = mk<provenance::TranslationStrategy>();
     } else {
         translationStrategy = mk<seminaive::TranslationStrategy>();
@@ -107,6 +178,45 @@ TranslatorContext::TranslatorContext(const ast::TranslationUnit& tu) {
         }
     }
 
+    // populates relations with in-place delta tracking
+    if (global->config().has("delta-tagging") && !global->config().has("provenance") &&
+            !global->config().has("emit-statistics")) {
+        const auto selected = splitString(global->config().get("delta-tagging"), ',');
+        const bool all = contains(selected, "*");
+        for (const ast::Relation* rel : program->getRelations()) {
+            const auto& name = rel->getQualifiedName();
+            if (!all && !contains(selected, toString(name))) {
+                continue;
+            }
+
+            // only plain b-tree relations of a recursive stratum qualify; the tag is an extra column
+            // and the interpreter supports b-trees of at most 20 columns
+            const auto representation = rel->getRepresentation();
+            if ((representation != RelationRepresentation::DEFAULT &&
+                        representation != RelationRepresentation::BTREE) ||
+                    rel->getArity() == 0 || rel->getArity() >= 20 || rel->getAuxiliaryArity() > 0 ||
+                    !sccGraph->isRecursive(sccGraph->getSCC(rel)) || hasSubsumptiveClause(name) ||
+                    !rel->getFunctionalDependencies().empty() || contains(deltaRel, rel)) {
+                continue;
+            }
+            deltaTagged.insert(name);
+        }
+    }
+
+    // populates relations whose subsumption keeps a single best tuple per key
+    if (!global->config().has("provenance")) {
+        for (const ast::Relation* rel : program->getRelations()) {
+            const auto subsumptive = filter(program->getClauses(*rel),
+                    [](const ast::Clause* clause) { return isA<ast::SubsumptiveClause>(clause); });
+            if (subsumptive.size() != 1 || rel->getAuxiliaryArity() > 0) {
+                continue;
+            }
+            if (auto keyed = analyseKeyedSubsumption(*subsumptive.front(), *polyAnalysis)) {
+                keyedSubsumptions.emplace(rel->getQualifiedName(), *keyed);
+            }
+        }
+    }
+
     // populates map type name -> lattice
     for (const ast::Lattice* lattice : program->getLattices()) {
         lattices.emplace(lattice->getQualifiedName(), lattice);
@@ -128,6 +238,16 @@ std::string TranslatorContext::getAttributeTypeQualifier(const ast::QualifiedNam
     return getTypeQualifier(typeEnv->getType(name));
 }
 
+std::size_t TranslatorContext::getAttributeDomainSize(const ast::QualifiedName& name) const {
+    // values of enum-like ADTs are the branch ids, anything else is unbounded
+    const auto* adt = as<ast::analysis::AlgebraicDataType>(
+            ast::analysis::getBaseType(&typeEnv->getType(name)));
+    if (adt == nullptr || !ast::analysis::isADTEnum(*adt)) {
+        return 0;
+    }
+    return adt->getBranches().size();
+}
+
 Own<ram::AbstractOperator> TranslatorContext::getLatticeTypeLubFunctor(
         const ast::QualifiedName& typeName, VecOwn<ram::Expression> args) const {
     const ast::Lattice* lattice = lattices.at(typeName);
@@ -146,22 +266,6 @@ Own<ram::AbstractOperator> TranslatorContext::getLatticeTypeLubFunctor(
     return {};
 }
 
-Own<ram::Aggregator> TranslatorContext::getLatticeTypeLubAggregator(
-        const ast::QualifiedName& typeName, Own<ram::Expression> init) const {
-    const ast::Lattice* lattice = lattices.at(typeName);
-    if (const auto* lub = as<ast::UserDefinedFunctor>(lattice->getLub())) {
-        const auto typeAttributes = getFunctorParamTypeAtributes(*lub);
-        const auto returnAttribute = getFunctorReturnTypeAttribute(*lub);
-        bool stateful = isStatefulFunctor(*lub);
-        return mk<ram::UserDefinedAggregator>(
-                lub->getName(), std::move(init), typeAttributes, returnAttribute, stateful);
-    } else if (const auto* lub = as<ast::IntrinsicFunctor>(lattice->getLub())) {
-        assert(false && lub && "intrinsic aggregators not yet supported in lattice");
-    }
-    assert(false);
-    return {};
-}
-
 std::size_t TranslatorContext::getNumberOfSCCs() const {
     return sccGraph->getNumberOfSCCs();
 }
@@ -178,6 +282,19 @@ const ast::Relation* TranslatorContext::getDeltaDebugRelation(const ast::Relatio
     return nullptr;
 }
 
+bool TranslatorContext::hasDeltaTagging(const ast::QualifiedName& name) const {
+    return contains(deltaTagged, name);
+}
+
+bool TranslatorContext::hasKeyedSubsumption(const ast::QualifiedName& name) const {
+    return contains(keyedSubsumptions, name);
+}
+
+const KeyedSubsumption& TranslatorContext::getKeyedSubsumption(const ast::QualifiedName& name) const {
+    assert(hasKeyedSubsumption(name) && "relation does not have keyed subsumption");
+    return keyedSubsumptions.at(name);
+}
+
 std::vector<ast::Directive*> TranslatorContext::getStoreDirectives(const ast::QualifiedName& name) const {
     return filter(program->getDirectives(name), [&](const ast::Directive* dir) {
         return dir->getType() == ast::DirectiveType::printsize ||
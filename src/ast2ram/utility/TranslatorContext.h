@@ -77,6 +77,18 @@ namespace souffle::ast2ram {
 class TranslationStrategy;
 class ValueIndex;
 
+/**
+ * Subsumption of a relation keeping a single best tuple per key, where the key
+ * is given by all attributes but the one whose values are ordered.
+ */
+struct KeyedSubsumption {
+    /** The attribute whose values are ordered */
+    std::size_t attribute;
+
+    /** Strict constraint holding if a value is better than another */
+    BinaryConstraintOp better;
+};
+
 class TranslatorContext {
 public:
     TranslatorContext(const ast::TranslationUnit& tu);
@@ -94,17 +106,25 @@ public:
     std::vector<ast::Directive*> getStoreDirectives(const ast::QualifiedName& name) const;
     std::vector<ast::Directive*> getLoadDirectives(const ast::QualifiedName& name) const;
     std::string getAttributeTypeQualifier(const ast::QualifiedName& name) const;
+    std::size_t getAttributeDomainSize(const ast::QualifiedName& name) const;
     bool hasSizeLimit(const ast::Relation* relation) const;
     std::size_t getSizeLimit(const ast::Relation* relation) const;
 
-    Own<ram::Aggregator> getLatticeTypeLubAggregator(
-            const ast::QualifiedName& typeName, Own<ram::Expression> init) const;
     Own<ram::AbstractOperator> getLatticeTypeLubFunctor(
             const ast::QualifiedName& typeName, VecOwn<ram::Expression> args) const;
 
     /** Associates a relation with its delta_debug relation if present */
     const ast::Relation* getDeltaDebugRelation(const ast::Relation* rel) const;
 
+    /** Whether the delta of a recursive relation is tracked in place, by tagging each tuple with the
+     * iteration that derived it, instead of in a separate @delta relation */
+    bool hasDeltaTagging(const ast::QualifiedName& name) const;
+
+    /** Whether the subsumption of a recursive relation is evaluated by keeping a single best tuple per
+     * key, instead of rejecting and deleting the dominated tuples by joins */
+    bool hasKeyedSubsumption(const ast::QualifiedName& name) const;
+    const KeyedSubsumption& getKeyedSubsumption(const ast::QualifiedName& name) const;
+
     /** Clause methods */
     bool hasSubsumptiveClause(const ast::QualifiedName& name) const;
     bool isRecursiveClause(const ast::Clause* clause) const;
@@ -178,6 +198,8 @@ private:
     Own<ast::SipsMetric> sipsMetric;
     Own<TranslationStrategy> translationStrategy;
     std::map<const ast::Relation*, const ast::Relation*> deltaRel;
+    ast::UnorderedQualifiedNameSet deltaTagged;
+    ast::UnorderedQualifiedNameMap<KeyedSubsumption> keyedSubsumptions;
     ast::UnorderedQualifiedNameMap<const ast::Lattice*> lattices;
 };
 
@@ -28,7 +28,10 @@
 #include "ram/Clear.h"
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
+#include "ram/IntrinsicOperator.h"
 #include "ram/TupleElement.h"
+#include "ram/UnsignedConstant.h"
+#include "ram/Variable.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <string>
@@ -104,10 +107,6 @@ std::string getNewRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@new_");
 }
 
-std::string getLubRelationName(const ast::QualifiedName& name) {
-    return getConcreteRelationName(name, "@lub_");
-}
-
 std::string getRejectRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@reject_");
 }
@@ -163,6 +162,17 @@ Own<ram::TupleElement> makeRamTupleElement(const Location& loc) {
     return mk<ram::TupleElement>(loc.identifier, loc.element);
 }
 
+Own<ram::Expression> makeRamIterationTag() {
+    return mk<ram::Variable>("loop_counter");
+}
+
+Own<ram::Expression> makeRamDeltaTag() {
+    VecOwn<ram::Expression> args;
+    args.push_back(makeRamIterationTag());
+    args.push_back(mk<ram::UnsignedConstant>(1));
+    return mk<ram::IntrinsicOperator>(FunctorOp::USUB, std::move(args));
+}
+
 Own<ram::Condition> addConjunctiveTerm(Own<ram::Condition> curCondition, Own<ram::Condition> newTerm) {
     return curCondition ? mk<ram::Conjunction>(std::move(curCondition), std::move(newTerm))
                         : std::move(newTerm);
@@ -30,6 +30,7 @@ class Relation;
 namespace souffle::ram {
 class Clear;
 class Condition;
+class Expression;
 class Statement;
 class TupleElement;
 }  // namespace souffle::ram
@@ -54,9 +55,6 @@ std::string getDeltaRelationName(const ast::QualifiedName& name);
 /** Get the corresponding RAM 'new' relation name for the relation */
 std::string getNewRelationName(const ast::QualifiedName& name);
 
-/** Get the corresponding RAM 'lub' relation name for the relation */
-std::string getLubRelationName(const ast::QualifiedName& name);
-
 /** Get the corresponding RAM 'reject' relation name for the relation */
 std::string getRejectRelationName(const ast::QualifiedName& name);
 
@@ -75,6 +73,12 @@ void nameUnnamedVariables(ast::Clause* clause);
 /** Create a RAM element access node */
 Own<ram::TupleElement> makeRamTupleElement(const Location& loc);
 
+/** Create the iteration tag of tuples derived in the current iteration of a fixpoint loop */
+Own<ram::Expression> makeRamIterationTag();
+
+/** Create the iteration tag of tuples forming the delta of the current iteration of a fixpoint loop */
+Own<ram::Expression> makeRamDeltaTag();
+
 /** Add a term to a conjunction */
 Own<ram::Condition> addConjunctiveTerm(Own<ram::Condition> curCondition, Own<ram::Condition> newTerm);
 
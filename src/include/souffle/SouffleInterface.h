@@ -930,6 +930,14 @@ public:
         fatal("unknown subroutine");
     }
 
+    /**
+     * Prepare the evaluation of the strata through executeSubroutine, such as
+     * when taking over the evaluation from the interpreter.
+     * @param performIO Whether the strata load and store relations (bool)
+     * @param pruneImdtRels Whether the strata clear relations no longer needed (bool)
+     */
+    virtual void prepareStrata(bool /* performIO */, bool /* pruneImdtRels */) {}
+
     /**
      * Get the symbol table of the program.
      */
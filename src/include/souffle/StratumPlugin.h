@@ -0,0 +1,71 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file StratumPlugin.h
+ *
+ * Interface of strata compiled to a shared library and evaluated by a host
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/datastructure/ConcurrentCache.h"
+#include "souffle/datastructure/HostRelation.h"
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * The state of the host shared with the strata of a plugin.
+ */
+struct PluginHost {
+    SymbolTable& symTable;
+    RecordTable& recordTable;
+    ConcurrentCache<std::string, std::regex>& regexCache;
+
+    /** Counter of the auto-increment functor */
+    std::atomic<RamDomain>& counter;
+
+    /** Relations of the host by name */
+    std::map<std::string, HostRelation*> relations;
+};
+
+/**
+ * Strata synthesised as a shared library, which are evaluated on the
+ * relations of a host such as the interpreter.
+ *
+ * The library exports the function souffle_stratum_plugin of type
+ * StratumPluginFactory, creating the plugin for a host. It returns nullptr
+ * if the program of the host differs from the program the plugin was
+ * synthesised from, as given by the fingerprint of the program.
+ */
+class StratumPlugin {
+public:
+    virtual ~StratumPlugin() = default;
+
+    /** Get the names of the strata evaluated by the plugin */
+    virtual std::vector<std::string> getStrata() = 0;
+
+    /** Evaluate a stratum */
+    virtual void executeStratum(
+            const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret) = 0;
+};
+
+using StratumPluginFactory = StratumPlugin* (*)(PluginHost& host, std::size_t fingerprint);
+
+}  // namespace souffle
@@ -1124,6 +1124,18 @@ public:
      * Inserts the given key into this tree.
      */
     bool insert(const Key& k, operation_hints& hints) {
+        auto update = [this](Key& old_k, const Key& new_k) { return this->update(old_k, new_k); };
+        return insert(k, hints, update);
+    }
+
+    /**
+     * Inserts the given key into this tree, updating an element equal to it
+     * under the weak comparator with the given function instead of the updater.
+     * The function is applied while the node of the element is locked, and it
+     * returns whether it changed the element.
+     */
+    template <typename Update>
+    bool insert(const Key& k, operation_hints& hints, Update& update) {
 #ifdef IS_PARALLEL
 
         // special handling for inserting first element
@@ -1221,14 +1233,14 @@ public:
                     // validate results
                     if (!cur->lock.validate(cur_lease)) {
                         // start over again
-                        return insert(k, hints);
+                        return insert(k, hints, update);
                     }
 
                     // update provenance information
                     if (typeid(Comparator) != typeid(WeakComparator)) {
                         if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                             // start again
-                            return insert(k, hints);
+                            return insert(k, hints, update);
                         }
                         bool updated = update(*pos, k);
                         cur->lock.end_write();
@@ -1248,7 +1260,7 @@ public:
                 // check whether there was a write
                 if (!cur->lock.end_read(cur_lease)) {
                     // start over
-                    return insert(k, hints);
+                    return insert(k, hints, update);
                 }
 
                 // go to next
@@ -1276,14 +1288,14 @@ public:
                 // validate result
                 if (!cur->lock.validate(cur_lease)) {
                     // start over again
-                    return insert(k, hints);
+                    return insert(k, hints, update);
                 }
 
                 // update provenance information
                 if (typeid(Comparator) != typeid(WeakComparator)) {
                     if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                         // start again
-                        return insert(k, hints);
+                        return insert(k, hints, update);
                     }
                     bool updated = update(*(pos - 1), k);
                     cur->lock.end_write();
@@ -1298,7 +1310,7 @@ public:
             if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                 // something has changed => restart
                 hints.last_insert.access(cur);
-                return insert(k, hints);
+                return insert(k, hints, update);
             }
 
             if (cur->numElements >= node::maxKeys) {
@@ -1365,7 +1377,7 @@ public:
                     cur->lock.end_write();
 
                     // insert in sibling
-                    return insert(k, hints);
+                    return insert(k, hints, update);
                 }
             }
 
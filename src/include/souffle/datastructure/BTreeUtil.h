@@ -16,7 +16,23 @@
 
 #pragma once
 
+#include "souffle/utility/MiscUtil.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SOUFFLE_BTREE_SIMD_AVX2
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define SOUFFLE_BTREE_SIMD_SSE4
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOUFFLE_BTREE_SIMD_SSE2
+#endif
 
 namespace souffle {
 
@@ -46,6 +62,36 @@ struct comparator {
     }
 };
 
+// ---------- lexicographic orders --------------
+
+/**
+ * The interpretation of a column's raw value when tuples are compared.
+ */
+enum class lex_kind { Signed, Unsigned };
+
+/**
+ * A column taking part in a lexicographic order on tuples.
+ */
+struct lex_column {
+    std::size_t index;
+    lex_kind kind;
+};
+
+/**
+ * Tuple comparators may describe the order they implement by exposing a
+ *
+ *     static constexpr std::array<lex_column, M> lex_order
+ *
+ * member, listing the compared columns from most to least significant.
+ * Search strategies use it to reproduce the comparison without calling
+ * the comparator (e.g. with vector instructions).
+ */
+template <typename Comp, typename = void>
+struct has_lex_order : std::false_type {};
+
+template <typename Comp>
+struct has_lex_order<Comp, std::void_t<decltype(Comp::lex_order)>> : std::true_type {};
+
 // ---------- search strategies --------------
 
 /**
@@ -188,6 +234,256 @@ struct binary_search : public search_strategy {
     }
 };
 
+namespace simd {
+
+/**
+ * Vector operations on lanes of type T; specialised for each supported
+ * lane width and instruction set.
+ */
+template <typename T, typename = void>
+struct lanes {
+    static constexpr bool supported = false;
+};
+
+#if defined(SOUFFLE_BTREE_SIMD_AVX2)
+
+template <typename T>
+struct lanes<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 4>> {
+    static constexpr bool supported = true;
+    static constexpr std::size_t width = 8;
+    using vec = __m256i;
+    static vec load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static vec flip(vec a, vec b) {
+        return _mm256_xor_si256(a, b);
+    }
+    static unsigned gt(vec a, vec b) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b)));
+    }
+    static unsigned eq(vec a, vec b) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    }
+};
+
+template <typename T>
+struct lanes<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 8>> {
+    static constexpr bool supported = true;
+    static constexpr std::size_t width = 4;
+    using vec = __m256i;
+    static vec load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static vec flip(vec a, vec b) {
+        return _mm256_xor_si256(a, b);
+    }
+    static unsigned gt(vec a, vec b) {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b)));
+    }
+    static unsigned eq(vec a, vec b) {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+    }
+};
+
+#elif defined(SOUFFLE_BTREE_SIMD_SSE4) || defined(SOUFFLE_BTREE_SIMD_SSE2)
+
+template <typename T>
+struct lanes<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 4>> {
+    static constexpr bool supported = true;
+    static constexpr std::size_t width = 4;
+    using vec = __m128i;
+    static vec load(const T* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static vec flip(vec a, vec b) {
+        return _mm_xor_si128(a, b);
+    }
+    static unsigned gt(vec a, vec b) {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b)));
+    }
+    static unsigned eq(vec a, vec b) {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+    }
+};
+
+#if defined(SOUFFLE_BTREE_SIMD_SSE4)
+
+template <typename T>
+struct lanes<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 8>> {
+    static constexpr bool supported = true;
+    static constexpr std::size_t width = 2;
+    using vec = __m128i;
+    static vec load(const T* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static vec flip(vec a, vec b) {
+        return _mm_xor_si128(a, b);
+    }
+    static unsigned gt(vec a, vec b) {
+        return _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(a, b)));
+    }
+    static unsigned eq(vec a, vec b) {
+        return _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, b)));
+    }
+};
+#endif
+
+#endif
+
+/**
+ * Determines whether keys of the given type, ordered by the given
+ * comparator, can be searched with vector instructions.
+ */
+template <typename Key, typename Comp, typename = void>
+struct searchable : std::false_type {};
+
+template <typename T, std::size_t N, typename Comp>
+struct searchable<std::array<T, N>, Comp, std::enable_if_t<has_lex_order<Comp>::value>>
+        : std::integral_constant<bool, lanes<T>::supported && (1 <= N && N <= 4) &&
+                                               sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+/**
+ * Searches the sorted range [a, a + count) for the position of the first key
+ * that is not less than (upper = false), or greater than (upper = true), the
+ * given key with respect to the lexicographic order of Comp.
+ *
+ * The range is processed in blocks of `width` keys; each block is loaded as N
+ * vectors that are compared column-wise against the key, yielding bit masks
+ * for the per-column less/equal/greater outcomes. These are then folded into
+ * one bit per key following the column order of the comparator. Since the
+ * range is sorted, the number of qualifying keys in a block is the offset of
+ * the result within it.
+ */
+template <bool upper, typename T, std::size_t N, typename Comp>
+std::size_t search(const std::array<T, N>& k, const std::array<T, N>* a, std::size_t count, Comp& comp) {
+    using L = lanes<T>;
+    using vec = typename L::vec;
+    constexpr std::size_t W = L::width;
+    constexpr auto& order = std::decay_t<Comp>::lex_order;
+    constexpr std::size_t M = order.size();
+    static_assert(1 <= M && M <= N, "invalid lexicographic order");
+
+    // the key and sign flips for each of the N vectors of a block
+    using MT = std::make_unsigned_t<T>;
+    constexpr MT sign = MT(1) << (sizeof(T) * 8 - 1);
+    vec pattern[N];
+    vec flips[N];
+    for (std::size_t r = 0; r < N; ++r) {
+        alignas(32) T p[W];
+        alignas(32) T f[W];
+        for (std::size_t l = 0; l < W; ++l) {
+            f[l] = 0;
+            for (std::size_t c = 0; c < M; ++c) {
+                if (order[c].index == (r * W + l) % N && order[c].kind == lex_kind::Unsigned) {
+                    f[l] = static_cast<T>(sign);
+                }
+            }
+            p[l] = static_cast<T>(static_cast<MT>(k[(r * W + l) % N]) ^ static_cast<MT>(f[l]));
+        }
+        flips[r] = L::load(f);
+        pattern[r] = L::load(p);
+    }
+
+    // the bits of the most significant column of each key
+    uint64_t lead = 0;
+    for (std::size_t l = 0; l < W; ++l) {
+        lead |= uint64_t(1) << (l * N + order[0].index);
+    }
+
+    auto shift = [](uint64_t m, std::ptrdiff_t d) { return (d >= 0) ? (m >> d) : (m << -d); };
+
+    const T* flat = reinterpret_cast<const T*>(a);
+    std::size_t pos = 0;
+    for (; pos + W <= count; pos += W) {
+        uint64_t hit = 0;
+        uint64_t same = 0;
+        for (std::size_t r = 0; r < N; ++r) {
+            vec x = L::flip(L::load(flat + pos * N + r * W), flips[r]);
+            unsigned h = upper ? L::gt(x, pattern[r]) : L::gt(pattern[r], x);
+            hit |= uint64_t(h) << (r * W);
+            same |= uint64_t(L::eq(x, pattern[r])) << (r * W);
+        }
+        // fold: res(c) = hit(c) | (same(c) & res(c + 1)) along the column order
+        uint64_t res = hit;
+        for (std::size_t c = M - 1; c-- > 0;) {
+            auto d = static_cast<std::ptrdiff_t>(order[c + 1].index) -
+                     static_cast<std::ptrdiff_t>(order[c].index);
+            res = hit | (same & shift(res, d));
+        }
+        // lower bound: keys less than k; upper bound: keys not greater than k
+        auto qualifying = static_cast<std::size_t>(__builtin_popcountll(res & lead));
+        if (upper) {
+            qualifying = W - qualifying;
+        }
+        if (qualifying < W) {
+            return pos + qualifying;
+        }
+    }
+
+    // scan the remainder that does not fill a full block
+    for (; pos < count; ++pos) {
+        auto r = comp(a[pos], k);
+        if (upper ? (r > 0) : (r >= 0)) {
+            return pos;
+        }
+    }
+    return count;
+}
+
+}  // namespace simd
+
+/**
+ * A vectorised search strategy for looking up keys in b-tree nodes.
+ *
+ * Applies to small tuples of integers whose comparator describes its order
+ * through a `lex_order` member and when compiling for a target providing
+ * SSE2 (32-bit values), SSE4.2 (64-bit values) or AVX2. All other cases
+ * fall back to a binary search.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator referencing an element equivalent to the
+     * given key in the given range. If no such element is present,
+     * a reference to the first element not less than the given key
+     * is returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        return lower_bound(k, a, b, comp);
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (std::is_pointer_v<Iter> && simd::searchable<Key, std::decay_t<Comp>>::value) {
+            return a + simd::search<false>(k, a, static_cast<std::size_t>(b - a), comp);
+        } else {
+            return binary_search().lower_bound(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (std::is_pointer_v<Iter> && simd::searchable<Key, std::decay_t<Comp>>::value) {
+            return a + simd::search<true>(k, a, static_cast<std::size_t>(b - a), comp);
+        } else {
+            return binary_search().upper_bound(k, a, b, comp);
+        }
+    }
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -201,6 +497,7 @@ struct strategy_selection {
 
 struct linear : public strategy_selection<linear_search> {};
 struct binary : public strategy_selection<binary_search> {};
+struct vectorised : public strategy_selection<simd_search> {};
 
 // by default every key utilizes binary search
 template <typename Key>
@@ -212,6 +509,13 @@ struct default_strategy<int> : public linear {};
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
 
+// small integer tuples are searched with vector instructions where available
+template <typename T, std::size_t N>
+struct default_strategy<std::array<T, N>>
+        : public std::conditional_t<std::is_integral_v<T> && (sizeof(T) == 4 || sizeof(T) == 8) &&
+                                            (1 <= N && N <= 4),
+                  vectorised, binary> {};
+
 /**
  * The default non-updater
  */
@@ -0,0 +1,51 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Bitmap.h
+ *
+ * Datastructure for unary and binary relations over small integer domains
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/Brie.h"
+
+namespace souffle {
+
+namespace detail::bitmap {
+
+template <unsigned Arity>
+struct levels;
+
+// a single bitmap of 2^10 words, i.e. 65536 values, per leaf node
+template <>
+struct levels<1u> {
+    using type = TrieLevels<10>;
+};
+
+// a bit-matrix with one bitmap row per value of the first column,
+// the rows consist of leaf nodes of 2^6 words, i.e. 4096 values
+template <>
+struct levels<2u> {
+    using type = TrieLevels<8, 6>;
+};
+
+}  // namespace detail::bitmap
+
+/**
+ * A bitmap relation of arity 1 or 2. Values are stored as bits of wide bitmap
+ * nodes, thus dense ranges of values take a bit each and set-at-a-time unions
+ * (insertAll) and intersections (retainAll) proceed word by word.
+ */
+template <unsigned Arity>
+using Bitmap = Trie<Arity, typename detail::bitmap::levels<Arity>::type>;
+
+}  // namespace souffle
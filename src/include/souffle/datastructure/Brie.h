@@ -59,7 +59,32 @@
 
 namespace souffle {
 
-template <unsigned Dim>
+/**
+ * The number of bits consumed per node by each level of a Trie, listed from the
+ * outermost to the innermost level. Inner levels index their nested tries by a
+ * SparseArray with 2^Bits cells per node, the innermost level is a SparseBitMap
+ * with 2^Bits words per leaf node. A level whose node covers the domain of its
+ * column is a single dense node.
+ */
+template <unsigned... Bits>
+struct TrieLevels {};
+
+namespace detail::brie {
+
+/**
+ * The default levels of a trie: 2^6 entries per inner node, 2^4 words per leaf node.
+ */
+template <unsigned Dim, unsigned... Bits>
+struct default_trie_levels : default_trie_levels<Dim - 1, 6, Bits...> {};
+
+template <unsigned... Bits>
+struct default_trie_levels<1u, Bits...> {
+    using type = TrieLevels<Bits..., 4>;
+};
+
+}  // namespace detail::brie
+
+template <unsigned Dim, typename Levels = typename detail::brie::default_trie_levels<Dim>::type>
 class Trie;
 
 namespace detail::brie {
@@ -207,7 +232,7 @@ struct SparseArrayIter {
         int level = 1;
 
         // get current index on this level
-        x = SparseArray::getIndex(brie_element_type(value.first), level);
+        x = SparseArray::getIndex(value.first, level);
         x++;
 
         while (level > 0 && node) {
@@ -233,7 +258,7 @@ struct SparseArrayIter {
                 level++;
 
                 // get current index on this level
-                x = SparseArray::getIndex(brie_element_type(value.first), level);
+                x = SparseArray::getIndex(value.first, level);
                 x++;  // go one step further
             }
         }
@@ -838,7 +863,7 @@ private:
         unsigned level = info.levels;
         while (level != 0) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // decrease level counter
             --level;
@@ -955,7 +980,7 @@ public:
         unsigned level = unsynced.levels;
         while (level != 0) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // decrease level counter
             --level;
@@ -1046,7 +1071,7 @@ public:
         Node** node = &unsynced.root;
         while (level > other.unsynced.levels) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(other.unsynced.offset), level);
+            auto x = getIndex(other.unsynced.offset, level);
 
             // decrease level counter
             --level;
@@ -1201,7 +1226,7 @@ public:
         unsigned level = unsynced.levels;
         while (true) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // check next node
             Node* next = node->cell[x].ptr;
@@ -1408,7 +1433,7 @@ private:
         node->parent = nullptr;
 
         // insert existing root as child
-        auto x = getIndex(brie_element_type(unsynced.offset), unsynced.levels + 1);
+        auto x = getIndex(unsynced.offset, unsynced.levels + 1);
         node->cell[x].ptr = unsynced.root;
 
         // swap the root
@@ -1435,7 +1460,7 @@ private:
         newRoot->parent = nullptr;
 
         // insert existing root as child
-        auto x = getIndex(brie_element_type(info.offset), info.levels + 1);
+        auto x = getIndex(info.offset, info.levels + 1);
         newRoot->cell[x].ptr = info.root;
 
         // exchange the root in the info struct
@@ -1479,7 +1504,7 @@ private:
      * Obtains the index within the arrays of cells of a given index on a given
      * level of the internally maintained tree.
      */
-    static index_type getIndex(brie_element_type a, unsigned level) {
+    static index_type getIndex(index_type a, unsigned level) {
         return (a & (INDEX_MASK << (level * BIT_PER_STEP))) >> (level * BIT_PER_STEP);
     }
 
@@ -1488,7 +1513,7 @@ private:
      * given tree level.
      */
     static index_type getLevelMask(unsigned level) {
-        if (level > (sizeof(index_type) * 8 / BITS)) return 0;
+        if (level * BIT_PER_STEP >= sizeof(index_type) * 8) return 0;
         return (~(index_type(0)) << (level * BIT_PER_STEP));
     }
 };
@@ -1787,6 +1812,25 @@ public:
         store.addAll(other.store);
     }
 
+    /**
+     * Resets all bits to 0 within this bit map that are not set in other.
+     */
+    void retainAll(const SparseBitMap& other) {
+        // nothing to do if it is a self-assignment
+        if (this == &other) return;
+
+        // keep the non-zero conjunctions of the stored bit masks
+        data_store_t res;
+        op_context ctxt;
+        for (const auto& cur : store) {
+            value_t mask = cur.second & other.store.lookup(cur.first);
+            if (mask != 0) {
+                res.update(cur.first, mask, ctxt);
+            }
+        }
+        store = std::move(res);
+    }
+
     // ---------------------------------------------------------------------
     //                           Iterator
     // ---------------------------------------------------------------------
@@ -2001,7 +2045,7 @@ public:
     }
 };
 
-template <unsigned Dim>
+template <unsigned Dim, typename Levels>
 struct TrieTypes;
 
 /**
@@ -2009,9 +2053,10 @@ struct TrieTypes;
  * specializations of the Trie template to inherit common functionality.
  *
  * @tparam Dim the number of dimensions / arity of the stored tuples
+ * @tparam Levels the node sizes of the levels of the trie
  * @tparam Derived the type derived from this base class
  */
-template <unsigned Dim, typename Derived>
+template <unsigned Dim, typename Levels, typename Derived>
 class TrieBase {
     Derived& impl() {
         return static_cast<Derived&>(*this);
@@ -2022,7 +2067,7 @@ class TrieBase {
     }
 
 protected:
-    using types = TrieTypes<Dim>;
+    using types = TrieTypes<Dim, Levels>;
     using store_type = typename types::store_type;
 
     store_type store;
@@ -2164,9 +2209,6 @@ public:
     }
 };
 
-template <unsigned Dim>
-struct TrieTypes;
-
 // FIXME: THIS KILLS COMPILE PERF - O(n^2)
 /**
  * A functor extracting a reference to a nested iterator core from an enclosing
@@ -2344,8 +2386,7 @@ struct fix_binding<0, Dim, Dim> {
  */
 template <unsigned Dim>
 struct fix_lower_bound {
-    using types = TrieTypes<Dim>;
-    using const_entry_span_type = typename types::const_entry_span_type;
+    using const_entry_span_type = span<const brie_element_type, Dim>;
 
     template <unsigned bits, typename iterator>
     bool operator()(const SparseBitMap<bits>& store, iterator&& iter, const_entry_span_type entry) const {
@@ -2395,8 +2436,7 @@ struct fix_lower_bound {
  */
 template <unsigned Dim>
 struct fix_upper_bound {
-    using types = TrieTypes<Dim>;
-    using const_entry_span_type = typename types::const_entry_span_type;
+    using const_entry_span_type = span<const brie_element_type, Dim>;
 
     template <unsigned bits, typename iterator>
     bool operator()(const SparseBitMap<bits>& store, iterator&& iter, const_entry_span_type entry) const {
@@ -2440,14 +2480,16 @@ struct fix_upper_bound {
     }
 };
 
-template <unsigned Dim>
-struct TrieTypes {
+template <unsigned Dim, unsigned Bits, unsigned... Nested>
+struct TrieTypes<Dim, TrieLevels<Bits, Nested...>> {
+    static_assert(sizeof...(Nested) + 1 == Dim, "one node size per trie level required");
+
     using entry_type = std::array<brie_element_type, Dim>;
     using entry_span_type = span<brie_element_type, Dim>;
     using const_entry_span_type = span<const brie_element_type, Dim>;
 
     // the type of the nested tries (1 dimension less)
-    using nested_trie_type = Trie<Dim - 1>;
+    using nested_trie_type = Trie<Dim - 1, TrieLevels<Nested...>>;
 
     // the merge operation capable of merging two nested tries
     struct nested_trie_merger {
@@ -2469,7 +2511,7 @@ struct TrieTypes {
 
     // the data structure utilized for indexing nested tries
     using store_type = SparseArray<nested_trie_type*,
-            6,  // = 2^6 entries per block
+            Bits,  // = 2^Bits entries per block
             nested_trie_merger, nested_trie_cloner>;
 
     // The iterator core for trie iterators involving this level.
@@ -2559,15 +2601,15 @@ struct TrieTypes {
     };
 };
 
-template <>
-struct TrieTypes<1u> {
+template <unsigned Bits>
+struct TrieTypes<1u, TrieLevels<Bits>> {
     using entry_type = std::array<brie_element_type, 1>;
     using entry_span_type = span<brie_element_type, 1>;
     using const_entry_span_type = span<const brie_element_type, 1>;
 
     // the map type utilized internally
-    using store_type = SparseBitMap<>;
-    using op_context = store_type::op_context;
+    using store_type = SparseBitMap<Bits>;
+    using op_context = typename store_type::op_context;
 
     /**
      * The iterator core of this level contributing to the construction of
@@ -2634,14 +2676,14 @@ struct TrieTypes<1u> {
 
 // use an inner class so `TrieN` is fully defined before the recursion, allowing us to use
 // `op_context` in `TrieBase`
-template <unsigned Dim>
-class Trie : public TrieBase<Dim, Trie<Dim>> {
-    template <unsigned N>
+template <unsigned Dim, typename Levels>
+class Trie : public TrieBase<Dim, Levels, Trie<Dim, Levels>> {
+    template <unsigned N, typename L>
     friend class Trie;
 
     // a shortcut for the common base class type
-    using base = TrieBase<Dim, Trie<Dim>>;
-    using types = TrieTypes<Dim>;
+    using base = TrieBase<Dim, Levels, Trie<Dim, Levels>>;
+    using types = TrieTypes<Dim, Levels>;
     using nested_trie_type = typename types::nested_trie_type;
     using store_type = typename types::store_type;
 
@@ -2709,6 +2751,33 @@ public:
         store.clear();
     }
 
+    /**
+     * Removes all entries within this trie not present in the given trie.
+     * The intersection is computed level by level, on the bit masks of the
+     * leaf level.
+     *
+     * @param other the trie containing the entries to be retained
+     */
+    void retainAll(const Trie& other) {
+        // nothing to do if it is a self-intersection
+        if (this == &other) return;
+
+        // keep the nested tries with a non-empty intersection
+        store_type res;
+        typename store_type::op_context ctxt;
+        for (auto&& [k, v] : store) {
+            if (const nested_trie_type* nested = other.store.lookup(k)) {
+                v->retainAll(*nested);
+                if (!v->empty()) {
+                    res.update(k, v, ctxt);
+                    continue;
+                }
+            }
+            delete v;
+        }
+        store = std::move(res);
+    }
+
     /**
      * Inserts a new entry. A operation context may be provided to exploit temporal
      * locality.
@@ -2911,10 +2980,10 @@ public:
  * of all tries exhibiting an arity >= 1. Internally, values are stored utilizing
  * sparse bit maps.
  */
-template <>
-class Trie<1u> : public TrieBase<1u, Trie<1u>> {
-    using base = TrieBase<1u, Trie<1u>>;
-    using types = TrieTypes<1u>;
+template <unsigned Bits>
+class Trie<1u, TrieLevels<Bits>> : public TrieBase<1u, TrieLevels<Bits>, Trie<1u, TrieLevels<Bits>>> {
+    using base = TrieBase<1u, TrieLevels<Bits>, Trie<1u, TrieLevels<Bits>>>;
+    using types = TrieTypes<1u, TrieLevels<Bits>>;
     using store_type = typename types::store_type;
 
     using base::store;
@@ -2962,6 +3031,13 @@ public:
         store.clear();
     }
 
+    /**
+     * Removes all elements from this trie not present in the given trie.
+     */
+    void retainAll(const Trie& other) {
+        store.retainAll(other.store);
+    }
+
     /**
      * Inserts the given tuple into this trie.
      * An operation context can be provided to exploit temporal locality.
@@ -91,6 +91,16 @@ public:
         return insert(tuple[0], tuple[1], hints);
     }
 
+    /**
+     * Insert the tuple symbolically.
+     * @param tuple The tuple to be inserted
+     * @param hints the hints to where the tuple should be inserted (not applicable atm)
+     * @return true if the tuple is new to the data structure
+     */
+    bool insert(const TupleType& tuple, operation_hints& hints) {
+        return insert(tuple[0], tuple[1], hints);
+    }
+
     /**
      * Insert the two values symbolically as a binary relation
      * @param x node to be added/paired
@@ -0,0 +1,238 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HostRelation.h
+ *
+ * Datastructure for relations of the host of a stratum plugin
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/Iteration.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A relation owned by the host of a stratum plugin, such as the interpreter.
+ *
+ * The plugin accesses the indexes of the host in place through this interface.
+ * Indexes are numbered as in the index selection of the program, and the
+ * bounds of ranges as well as the tuples of iterators are given in the order
+ * of the attributes.
+ */
+class HostRelation {
+public:
+    /**
+     * A virtualized iterator, which yields the tuples regardless of the
+     * structure of the relation.
+     */
+    class iterator_base {
+    public:
+        virtual ~iterator_base() = default;
+
+        virtual iterator_base& operator++() = 0;
+
+        virtual const RamDomain* operator*() = 0;
+
+        virtual iterator_base* clone() const = 0;
+
+        virtual bool equal(const iterator_base& other) const = 0;
+    };
+
+    /**
+     * The iterator interface, copying an iterator clones its state.
+     */
+    class Iterator {
+        Own<iterator_base> iter;
+
+    public:
+        Iterator(const Iterator& other) : iter(other.iter->clone()) {}
+        Iterator(Iterator&& other) = default;
+        Iterator(iterator_base* iter) : iter(iter) {}
+
+        Iterator& operator=(const Iterator& other) {
+            iter.reset(other.iter->clone());
+            return *this;
+        }
+        Iterator& operator=(Iterator&& other) = default;
+
+        Iterator& operator++() {
+            ++(*iter);
+            return *this;
+        }
+
+        const RamDomain* operator*() {
+            return **iter;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return iter->equal(*other.iter);
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    virtual ~HostRelation() = default;
+
+    virtual Iterator begin() const = 0;
+
+    virtual Iterator end() const = 0;
+
+    virtual void insert(const RamDomain*) = 0;
+
+    virtual bool contains(const RamDomain*) const = 0;
+
+    virtual std::size_t size() const = 0;
+
+    virtual bool empty() const = 0;
+
+    virtual void purge() = 0;
+
+    /**
+     * Obtains the tuples of an index between the given bounds.
+     */
+    virtual std::pair<Iterator, Iterator> lowerUpperRange(
+            std::size_t indexPos, const RamDomain* low, const RamDomain* high) const = 0;
+
+    /**
+     * Splits the tuples into about the given number of ranges for parallel scans.
+     */
+    virtual std::vector<std::pair<Iterator, Iterator>> partition(std::size_t partitionCount) const = 0;
+};
+
+/**
+ * Relation of a stratum plugin accessing a relation of its host.
+ *
+ * The type synthesised for each relation of a plugin derives from it, adding
+ * the range queries of the searches on the relation.
+ */
+template <Relation::arity_type Arity_>
+class t_host {
+public:
+    static constexpr Relation::arity_type Arity = Arity_;
+
+    using t_tuple = Tuple<RamDomain, Arity>;
+    struct context {};
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = t_tuple;
+        using difference_type = ptrdiff_t;
+        using pointer = const t_tuple*;
+        using reference = const t_tuple&;
+
+        iterator(HostRelation::Iterator iter) : iter(std::move(iter)) {}
+
+        const t_tuple& operator*() const {
+            std::copy_n(*iter, Arity, tuple.begin());
+            return tuple;
+        }
+
+        iterator& operator++() {
+            ++iter;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return iter == other.iter;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        mutable HostRelation::Iterator iter;
+        mutable t_tuple tuple{};
+    };
+
+    explicit t_host(HostRelation& relation) : relation(relation) {}
+
+    context createContext() {
+        return context();
+    }
+
+    void insert(const t_tuple& t) {
+        relation.insert(t.data());
+    }
+    void insert(const t_tuple& t, context& /* ctxt */) {
+        relation.insert(t.data());
+    }
+    void insert(const RamDomain* ramDomain) {
+        relation.insert(ramDomain);
+    }
+
+    /** Insert all tuples of another relation */
+    template <typename Other>
+    void insertAll(const Other& other) {
+        for (const auto& t : other) {
+            insert(t);
+        }
+    }
+
+    bool contains(const t_tuple& t) const {
+        return relation.contains(t.data());
+    }
+    bool contains(const t_tuple& t, context& /* ctxt */) const {
+        return relation.contains(t.data());
+    }
+
+    std::size_t size() const {
+        return relation.size();
+    }
+    bool empty() const {
+        return relation.empty();
+    }
+    void purge() {
+        relation.purge();
+    }
+
+    iterator begin() const {
+        return iterator(relation.begin());
+    }
+    iterator end() const {
+        return iterator(relation.end());
+    }
+
+    std::vector<range<iterator>> partition() const {
+        std::vector<range<iterator>> res;
+        for (auto& part : relation.partition(400)) {
+            res.push_back(make_range(iterator(std::move(part.first)), iterator(std::move(part.second))));
+        }
+        return res;
+    }
+
+    void printStatistics(std::ostream& /* o */) const {}
+
+protected:
+    /** Obtain the tuples of an index between the given bounds */
+    range<iterator> lowerUpperRange(std::size_t indexPos, const t_tuple& lower, const t_tuple& upper) const {
+        auto tuples = relation.lowerUpperRange(indexPos, lower.data(), upper.data());
+        return make_range(iterator(std::move(tuples.first)), iterator(std::move(tuples.second)));
+    }
+
+private:
+    HostRelation& relation;
+};
+
+}  // namespace souffle
@@ -0,0 +1,95 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HyperLogLog.h
+ *
+ * Cardinality sketch estimating the number of distinct values of a stream
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace souffle {
+
+/**
+ * A HyperLogLog sketch of 2^Precision one-byte registers. Each hashed value
+ * updates a single register, sketches of disjoint streams are combined by
+ * merge, and the number of distinct values is estimated with a standard error
+ * of about 1.04 / sqrt(2^Precision), i.e. 1.6% for the default precision.
+ */
+template <unsigned Precision = 12>
+class HyperLogLog {
+    static_assert(4 <= Precision && Precision <= 16, "unsupported HyperLogLog precision");
+
+    static constexpr std::size_t NUM_REGISTERS = std::size_t(1) << Precision;
+
+    // the maximal number of leading zeros observed per register, plus one
+    std::array<uint8_t, NUM_REGISTERS> registers{};
+
+public:
+    /**
+     * Mixes a value into a hash, such that the bits of the result are
+     * uniformly distributed as required by the sketch.
+     */
+    static uint64_t hash(uint64_t seed, RamDomain value) {
+        uint64_t x = seed ^ (static_cast<uint64_t>(ramBitCast<RamUnsigned>(value)) + 0x9e3779b97f4a7c15ULL +
+                                    (seed << 6U) + (seed >> 2U));
+        x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31U);
+    }
+
+    /** Adds a hashed value to the sketch. */
+    void insert(uint64_t hash) {
+        std::size_t pos = hash >> (64 - Precision);
+        // the guard bit bounds the rank for hashes without further set bits
+        uint64_t rest = hash | (uint64_t(1) << (64 - Precision));
+        auto rank = static_cast<uint8_t>(__builtin_ctzll(rest) + 1);
+        registers[pos] = std::max(registers[pos], rank);
+    }
+
+    /** Combines the values of another sketch into this sketch. */
+    void merge(const HyperLogLog& other) {
+        for (std::size_t i = 0; i < NUM_REGISTERS; ++i) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+
+    /** Estimates the number of distinct values added to the sketch. */
+    double estimate() const {
+        const double m = NUM_REGISTERS;
+        double sum = 0;
+        std::size_t zeros = 0;
+        for (auto cur : registers) {
+            sum += std::ldexp(1.0, -static_cast<int>(cur));
+            zeros += (cur == 0);
+        }
+        double res = (0.7213 / (1.0 + 1.079 / m)) * m * m / sum;
+        // use linear counting for small cardinalities
+        if (res <= 2.5 * m && zeros != 0) {
+            res = m * std::log(m / static_cast<double>(zeros));
+        }
+        return res;
+    }
+
+    void clear() {
+        registers.fill(0);
+    }
+};
+
+}  // namespace souffle
@@ -559,6 +559,45 @@ public:
     }
 } frequencyAtomProcessor;
 
+/**
+ * Parallel Imbalance Processor
+ */
+const class ParallelImbalanceProcessor : public EventProcessor {
+public:
+    ParallelImbalanceProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@parallel-imbalance", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& version = signature[2];
+        const std::string& rule = signature[3];
+        const std::string& originalRule = signature[5];
+        std::size_t numThreads = va_arg(args, std::size_t);
+        std::size_t maxTime = va_arg(args, std::size_t);
+        std::size_t totalTime = va_arg(args, std::size_t);
+        std::size_t numSplits = va_arg(args, std::size_t);
+        std::size_t iteration = va_arg(args, std::size_t);
+        std::vector<std::string> path;
+        // non-recursive rule
+        if (rule == originalRule) {
+            path = {"program", "relation", relation, "non-recursive-rule", rule, "parallel-imbalance"};
+        } else {
+            path = {"program", "relation", relation, "iteration", std::to_string(iteration),
+                    "recursive-rule", originalRule, version, "parallel-imbalance"};
+        }
+        auto entry = [&](const std::string& key, std::size_t value) {
+            path.push_back(key);
+            db.addSizeEntry(path, value);
+            path.pop_back();
+        };
+        entry("num-threads", numThreads);
+        entry("max-thread-time", maxTime);
+        entry("total-thread-time", totalTime);
+        entry("num-splits", numSplits);
+    }
+} parallelImbalanceProcessor;
+
 /**
  * Reads Processor
  */
@@ -93,6 +93,13 @@ public:
         profile::EventProcessorSingleton::instance().process(database, txt.c_str(), joinSize, iteration);
     }
 
+    /** create an event for the time the threads of a parallel loop spent scanning */
+    void makeParallelImbalanceEvent(const std::string& txt, std::size_t numThreads, std::size_t maxTime,
+            std::size_t totalTime, std::size_t numSplits, std::size_t iteration) {
+        profile::EventProcessorSingleton::instance().process(
+                database, txt.c_str(), numThreads, maxTime, totalTime, numSplits, iteration);
+    }
+
     /** create utilisation event */
     void makeUtilisationEvent(const std::string& txt) {
         /* current time */
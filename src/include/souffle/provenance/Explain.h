@@ -101,6 +101,32 @@ public:
             }
             query = parseTuple(command[1]);
             printTree(prov.explain(query.first, query.second, ExplainConfig::getExplainConfig().depthLimit));
+        } else if (command[0] == "explainall") {
+            const std::string usage =
+                    "Usage: explainall <relation1>(<element1>, ...), <relation2>(<element1>, ...), ...\n";
+            if (command.size() != 2) {
+                printError(usage);
+                return true;
+            }
+            // regex for each tuple of the batch, whose values are numbers or strings
+            std::regex relationRegex(
+                    "([a-zA-Z0-9_.-]*)[[:blank:]]*\\(([[:blank:]]*([0-9]+|\"[^\"]*\")"
+                    "([[:blank:]]*,[[:blank:]]*([0-9]+|\"[^\"]*\"))*)?\\)",
+                    std::regex_constants::extended);
+            std::smatch relationMatcher;
+            std::string relationStr = command[1];
+            std::vector<std::pair<std::string, std::vector<std::string>>> queries;
+            while (std::regex_search(relationStr, relationMatcher, relationRegex)) {
+                queries.push_back(parseTuple(relationMatcher[0]));
+                relationStr = relationMatcher.suffix().str();
+            }
+            if (queries.empty()) {
+                printError(usage);
+                return true;
+            }
+            for (auto& tree : prov.explainAll(queries, ExplainConfig::getExplainConfig().depthLimit)) {
+                printTree(std::move(tree));
+            }
         } else if (command[0] == "subproof") {
             std::pair<std::string, std::vector<std::string>> query;
             int label = -1;
@@ -253,6 +279,8 @@ public:
                     "----------\n"
                     "setdepth <depth>: Set a limit for printed derivation tree height\n"
                     "explain <relation>(<element1>, <element2>, ...): Prints derivation tree\n"
+                    "explainall <relation1>(<element1>, ...), <relation2>(<element1>, ...), ...: Prints\n"
+                    "    the derivation trees of several tuples, sharing their subproofs\n"
                     "explainnegation <relation>(<element1>, <element2>, ...): Enters an interactive\n"
                     "    interface where the non-existence of a tuple can be explained\n"
                     "subproof <relation>(<label>): Prints derivation tree for a subproof, label is\n"
@@ -624,8 +652,8 @@ private:
 };
 #endif
 
-inline void explain(SouffleProgram& prog, bool ncurses) {
-    ExplainProvenanceImpl prov(prog);
+inline void explain(SouffleProgram& prog, bool ncurses, bool lazy = false) {
+    ExplainProvenanceImpl prov(prog, lazy);
 
     if (ncurses) {
 #ifdef USE_NCURSES
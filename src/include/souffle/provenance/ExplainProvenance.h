@@ -167,6 +167,14 @@ public:
     virtual Own<TreeNode> explain(
             std::string relName, std::vector<std::string> tuple, std::size_t depthLimit) = 0;
 
+    /**
+     * Explain several tuples in one pass, sharing the subproofs found between them
+     * @param tuples, vector of relation, argument pairs
+     */
+    virtual std::vector<Own<TreeNode>> explainAll(
+            const std::vector<std::pair<std::string, std::vector<std::string>>>& tuples,
+            std::size_t depthLimit) = 0;
+
     virtual Own<TreeNode> explainSubproof(std::string relName, RamDomain label, std::size_t depthLimit) = 0;
 
     virtual std::vector<std::string> explainNegationGetVariables(
@@ -24,15 +24,18 @@
 #include "souffle/provenance/ExplainTree.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
@@ -49,7 +52,12 @@ class ExplainProvenanceImpl : public ExplainProvenance {
     using arity_type = Relation::arity_type;
 
 public:
-    ExplainProvenanceImpl(SouffleProgram& prog) : ExplainProvenance(prog) {
+    /**
+     * With lazy provenance, the relations carry no rule and level numbers. The
+     * proofs are instead re-derived on demand by a search bounded by the level,
+     * running the subproof subroutines on the tuples of the proof.
+     */
+    ExplainProvenanceImpl(SouffleProgram& prog, bool lazy = false) : ExplainProvenance(prog), lazy(lazy) {
         setup();
     }
 
@@ -91,145 +99,57 @@ public:
 
     Own<TreeNode> explain(std::string relName, std::vector<RamDomain> tuple, int ruleNum, int levelNum,
             std::size_t depthLimit) {
-        std::stringstream joinedArgs;
-        joinedArgs << join(decodeArguments(relName, tuple), ", ");
-        auto joinedArgsStr = joinedArgs.str();
-
-        // if fact
-        if (levelNum == 0) {
-            return mk<LeafNode>(relName + "(" + joinedArgsStr + ")");
-        }
-
-        assert(contains(info, std::make_pair(relName, ruleNum)) && "invalid rule for tuple");
-
-        // if depth limit exceeded
-        if (depthLimit <= 1) {
-            tuple.push_back(ruleNum);
-            tuple.push_back(levelNum);
-
-            // find if subproof exists already
-            std::size_t idx = 0;
-            auto it = std::find(subproofs.begin(), subproofs.end(), tuple);
-            if (it != subproofs.end()) {
-                idx = it - subproofs.begin();
-            } else {
-                subproofs.push_back(tuple);
-                idx = subproofs.size() - 1;
-            }
-
-            return mk<LeafNode>("subproof " + relName + "(" + std::to_string(idx) + ")");
-        }
-
-        tuple.push_back(levelNum);
-
-        auto internalNode =
-                mk<InnerNode>(relName + "(" + joinedArgsStr + ")", "(R" + std::to_string(ruleNum) + ")");
-
-        // make return vector pointer
-        std::vector<RamDomain> ret;
-
-        // execute subroutine to get subproofs
-        prog.executeSubroutine(relName + "_" + std::to_string(ruleNum) + "_subproof", tuple, ret);
-
-        // recursively get nodes for subproofs
-        std::size_t tupleCurInd = 0;
-        auto bodyRelations = info.at(std::make_pair(relName, ruleNum));
-
-        // start from begin + 1 because the first element represents the head atom
-        for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
-            std::string bodyLiteral = *it;
-            // split bodyLiteral since it contains relation name plus arguments
-            std::string bodyRel = splitString(bodyLiteral, ',')[0];
-
-            // check whether the current atom is a constraint
-            assert(bodyRel.size() > 0 && "body of a relation should have positive length");
-            bool isConstraint = contains(constraintList, bodyRel);
-
-            // handle negated atom names
-            auto bodyRelAtomName = bodyRel;
-            if (bodyRel[0] == '!' && bodyRel != "!=") {
-                bodyRelAtomName = bodyRel.substr(1);
-            }
-
-            // traverse subroutine return
-            std::size_t arity;
-            std::size_t auxiliaryArity;
-            if (isConstraint) {
-                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
-                // annotations
-                arity = 4;
-                auxiliaryArity = 2;
-            } else {
-                arity = prog.getRelation(bodyRelAtomName)->getArity();
-                auxiliaryArity = prog.getRelation(bodyRelAtomName)->getAuxiliaryArity();
-            }
-            auto tupleEnd = tupleCurInd + arity;
-
-            // store current tuple
-            std::vector<RamDomain> subproofTuple;
-
-            for (; tupleCurInd < tupleEnd - auxiliaryArity; tupleCurInd++) {
-                subproofTuple.push_back(ret[tupleCurInd]);
-            }
-
-            int subproofRuleNum = ret[tupleCurInd];
-            int subproofLevelNum = ret[tupleCurInd + 1];
-
-            tupleCurInd += 2;
-
-            // for a negation, display the corresponding tuple and do not recurse
-            if (bodyRel[0] == '!' && bodyRel != "!=") {
-                std::stringstream joinedTuple;
-                joinedTuple << join(decodeArguments(bodyRelAtomName, subproofTuple), ", ");
-                auto joinedTupleStr = joinedTuple.str();
-                internalNode->add_child(mk<LeafNode>(bodyRel + "(" + joinedTupleStr + ")"));
-                internalNode->setSize(internalNode->getSize() + 1);
-                // for a binary constraint, display the corresponding values and do not recurse
-            } else if (isConstraint) {
-                std::stringstream joinedConstraint;
-
-                // FIXME: We need type info in order to figure out how to print arguments.
-                BinaryConstraintOp rawBinOp = toBinaryConstraintOp(bodyRel);
-                if (isOrderedBinaryConstraintOp(rawBinOp)) {
-                    joinedConstraint << subproofTuple[0] << " " << bodyRel << " " << subproofTuple[1];
-                } else {
-                    joinedConstraint << bodyRel << "(\"" << symTable.decode(subproofTuple[0]) << "\", \""
-                                     << symTable.decode(subproofTuple[1]) << "\")";
-                }
-
-                internalNode->add_child(mk<LeafNode>(joinedConstraint.str()));
-                internalNode->setSize(internalNode->getSize() + 1);
-                // otherwise, for a normal tuple, recurse
-            } else {
-                auto child =
-                        explain(bodyRel, subproofTuple, subproofRuleNum, subproofLevelNum, depthLimit - 1);
-                internalNode->setSize(internalNode->getSize() + child->getSize());
-                internalNode->add_child(std::move(child));
-            }
-
-            tupleCurInd = tupleEnd;
-        }
-
-        return internalNode;
+        // explore the subproofs concurrently, then build the tree in order such that labels are stable
+        prefetchSubproofs(relName, tuple, ruleNum, levelNum, depthLimit);
+        return buildTree(relName, std::move(tuple), ruleNum, levelNum, depthLimit);
     }
 
     Own<TreeNode> explain(
             std::string relName, std::vector<std::string> args, std::size_t depthLimit) override {
-        auto tuple = argsToNums(relName, args);
-        if (tuple.empty()) {
-            return mk<LeafNode>("Relation not found");
+        std::vector<RamDomain> tuple;
+        int ruleNum;
+        int levelNum;
+        if (auto error = findDerivation(relName, args, tuple, ruleNum, levelNum)) {
+            return error;
         }
 
-        std::tuple<int, int> tupleInfo = findTuple(relName, tuple);
-
-        int ruleNum = std::get<0>(tupleInfo);
-        int levelNum = std::get<1>(tupleInfo);
+        return explain(relName, tuple, ruleNum, levelNum, depthLimit);
+    }
 
-        if (ruleNum < 0 || levelNum == -1) {
-            return mk<LeafNode>("Tuple not found");
+    std::vector<Own<TreeNode>> explainAll(
+            const std::vector<std::pair<std::string, std::vector<std::string>>>& tuples,
+            std::size_t depthLimit) override {
+        std::vector<Own<TreeNode>> trees(tuples.size());
+        std::vector<std::vector<RamDomain>> nums(tuples.size());
+        std::vector<int> ruleNums(tuples.size());
+        std::vector<int> levelNums(tuples.size());
+
+        // explore the subproofs of all tuples concurrently, sharing them between the trees; lazy
+        // searches are serialised, hence the tuples are derived in turn
+        std::vector<std::function<void()>> tasks;
+        for (std::size_t i = 0; i < tuples.size(); i++) {
+            tasks.push_back([&, i]() {
+                const auto& [relName, args] = tuples[i];
+                trees[i] = findDerivation(relName, args, nums[i], ruleNums[i], levelNums[i]);
+                if (trees[i] == nullptr) {
+                    prefetchSubproofs(relName, nums[i], ruleNums[i], levelNums[i], depthLimit);
+                }
+            });
+        }
+        if (lazy) {
+            for (auto& task : tasks) {
+                task();
+            }
+        } else {
+            parallelInvoke(tasks);
         }
 
-        return explain(relName, tuple, ruleNum, levelNum, depthLimit);
+        for (std::size_t i = 0; i < tuples.size(); i++) {
+            if (trees[i] == nullptr) {
+                trees[i] = buildTree(tuples[i].first, nums[i], ruleNums[i], levelNums[i], depthLimit);
+            }
+        }
+        return trees;
     }
 
     Own<TreeNode> explainSubproof(
@@ -242,15 +162,16 @@ public:
 
         auto rel = prog.getRelation(relName);
 
-        assert(rel->getAuxiliaryArity() == 2 && "unexpected auxiliary arity in provenance context");
+        assert((lazy || rel->getAuxiliaryArity() == 2) && "unexpected auxiliary arity in provenance context");
 
+        // the subproof is stored with its rule and level number
         RamDomain ruleNum;
-        ruleNum = tup[rel->getArity() - 2];
+        ruleNum = tup[rel->getPrimaryArity()];
 
         RamDomain levelNum;
-        levelNum = tup[rel->getArity() - 1];
+        levelNum = tup[rel->getPrimaryArity() + 1];
 
-        tup.erase(tup.begin() + rel->getArity() - 2, tup.end());
+        tup.erase(tup.begin() + rel->getPrimaryArity(), tup.end());
 
         return explain(relName, tup, ruleNum, levelNum, depthLimit);
     }
@@ -557,10 +478,13 @@ public:
             }
 
             RamDomain ruleNum;
-            tuple >> ruleNum;
-
             RamDomain levelNum;
-            tuple >> levelNum;
+            if (lazy) {
+                std::tie(ruleNum, levelNum) = deriveTuple(relName, currentTuple);
+            } else {
+                tuple >> ruleNum;
+                tuple >> levelNum;
+            }
 
             std::cout << "Tuples expanded: "
                       << explain(relName, currentTuple, ruleNum, levelNum, 10000)->getSize();
@@ -740,6 +664,410 @@ private:
     std::vector<std::string> constraintList = {
             "=", "!=", "<", "<=", ">=", ">", "match", "contains", "not_match", "not_contains"};
 
+    /** Whether proofs are re-derived on demand, as the relations carry no annotations */
+    bool lazy;
+
+    /** Subproofs of the explained tuples by relation, tuple, rule and level, shared between explanations */
+    std::map<std::tuple<std::string, std::vector<RamDomain>, int, int>, std::vector<RamDomain>> subproofCache;
+
+    /**
+     * Locks of the state shared by concurrent explorations. The search of lazy
+     * proofs holds the search lock throughout, hence lazy explorations are
+     * serialised and only share the subproofs they found.
+     */
+    std::mutex cacheLock;
+    std::mutex searchLock;
+
+    /** A literal of the body of a subproof */
+    struct BodyLiteral {
+        /** Relation of an atom, prefixed by ! for a negation, or the operator of a constraint */
+        std::string relName;
+        std::vector<RamDomain> tuple;
+        int ruleNum;
+        int levelNum;
+    };
+
+    /**
+     * Find the tuple of the given arguments with the rule and level number of
+     * its derivation, returning a node describing the error if there is none
+     */
+    Own<TreeNode> findDerivation(const std::string& relName, const std::vector<std::string>& args,
+            std::vector<RamDomain>& tuple, int& ruleNum, int& levelNum) {
+        tuple = argsToNums(relName, args);
+        if (tuple.empty()) {
+            return mk<LeafNode>("Relation not found");
+        }
+
+        std::tie(ruleNum, levelNum) = findTuple(relName, tuple);
+
+        if (ruleNum < 0 || levelNum == -1) {
+            return mk<LeafNode>("Tuple not found");
+        }
+
+        if (lazy) {
+            std::tie(ruleNum, levelNum) = deriveTuple(relName, tuple);
+        }
+
+        return nullptr;
+    }
+
+    /** Get the literals of the body of the subproof of a tuple */
+    std::vector<BodyLiteral> getBody(
+            const std::string& relName, const std::vector<RamDomain>& tuple, int ruleNum, int levelNum) {
+        // get the subproofs, which are shared between the explanations
+        const std::vector<RamDomain>& ret = getSubproofs(relName, tuple, ruleNum, levelNum);
+
+        std::vector<BodyLiteral> body;
+        std::size_t tupleCurInd = 0;
+        const auto& bodyRelations = info.at(std::make_pair(relName, ruleNum));
+
+        // start from begin + 1 because the first element represents the head atom
+        for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
+            std::string bodyLiteral = *it;
+            // split bodyLiteral since it contains relation name plus arguments
+            std::string bodyRel = splitString(bodyLiteral, ',')[0];
+
+            // check whether the current atom is a constraint
+            assert(bodyRel.size() > 0 && "body of a relation should have positive length");
+            bool isConstraint = contains(constraintList, bodyRel);
+
+            // handle negated atom names
+            auto bodyRelAtomName = bodyRel;
+            if (bodyRel[0] == '!' && bodyRel != "!=") {
+                bodyRelAtomName = bodyRel.substr(1);
+            }
+
+            // traverse subroutine return
+            std::size_t arity;
+            std::size_t auxiliaryArity;
+            if (isConstraint) {
+                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
+                // annotations
+                arity = 4;
+                auxiliaryArity = 2;
+            } else {
+                // the rule and level number follow the values of an atom, also if they are not annotations
+                arity = prog.getRelation(bodyRelAtomName)->getPrimaryArity() + 2;
+                auxiliaryArity = 2;
+            }
+            auto tupleEnd = tupleCurInd + arity;
+
+            // store current tuple
+            std::vector<RamDomain> subproofTuple;
+
+            for (; tupleCurInd < tupleEnd - auxiliaryArity; tupleCurInd++) {
+                subproofTuple.push_back(ret[tupleCurInd]);
+            }
+
+            int subproofRuleNum = ret[tupleCurInd];
+            int subproofLevelNum = ret[tupleCurInd + 1];
+
+            body.push_back({bodyRel, std::move(subproofTuple), subproofRuleNum, subproofLevelNum});
+
+            tupleCurInd = tupleEnd;
+        }
+
+        return body;
+    }
+
+    /**
+     * Compute the subproofs of a tree up to its depth limit, exploring the atoms of a body concurrently.
+     * Lazy subproofs are left to building the tree, as their searches are serialised.
+     */
+    void prefetchSubproofs(const std::string& relName, const std::vector<RamDomain>& tuple, int ruleNum,
+            int levelNum, std::size_t depthLimit) {
+        if (lazy || levelNum == 0 || depthLimit <= 1) {
+            return;
+        }
+
+        std::vector<std::function<void()>> tasks;
+        for (auto& literal : getBody(relName, tuple, ruleNum, levelNum)) {
+            if (literal.relName[0] != '!' && !contains(constraintList, literal.relName)) {
+                tasks.push_back([&, literal = std::move(literal)]() {
+                    prefetchSubproofs(literal.relName, literal.tuple, literal.ruleNum, literal.levelNum,
+                            depthLimit - 1);
+                });
+            }
+        }
+        parallelInvoke(tasks);
+    }
+
+    /** Build the proof tree of a tuple */
+    Own<TreeNode> buildTree(const std::string& relName, std::vector<RamDomain> tuple, int ruleNum,
+            int levelNum, std::size_t depthLimit) {
+        std::stringstream joinedArgs;
+        joinedArgs << join(decodeArguments(relName, tuple), ", ");
+        auto joinedArgsStr = joinedArgs.str();
+
+        // if fact
+        if (levelNum == 0) {
+            return mk<LeafNode>(relName + "(" + joinedArgsStr + ")");
+        }
+
+        assert(contains(info, std::make_pair(relName, ruleNum)) && "invalid rule for tuple");
+
+        // if depth limit exceeded
+        if (depthLimit <= 1) {
+            tuple.push_back(ruleNum);
+            tuple.push_back(levelNum);
+
+            // find if subproof exists already
+            std::size_t idx = 0;
+            auto it = std::find(subproofs.begin(), subproofs.end(), tuple);
+            if (it != subproofs.end()) {
+                idx = it - subproofs.begin();
+            } else {
+                subproofs.push_back(tuple);
+                idx = subproofs.size() - 1;
+            }
+
+            return mk<LeafNode>("subproof " + relName + "(" + std::to_string(idx) + ")");
+        }
+
+        auto internalNode =
+                mk<InnerNode>(relName + "(" + joinedArgsStr + ")", "(R" + std::to_string(ruleNum) + ")");
+
+        // recursively get nodes for subproofs
+        for (const auto& literal : getBody(relName, tuple, ruleNum, levelNum)) {
+            const auto& bodyRel = literal.relName;
+            const auto& subproofTuple = literal.tuple;
+
+            // for a negation, display the corresponding tuple and do not recurse
+            if (bodyRel[0] == '!' && bodyRel != "!=") {
+                std::stringstream joinedTuple;
+                joinedTuple << join(decodeArguments(bodyRel.substr(1), subproofTuple), ", ");
+                auto joinedTupleStr = joinedTuple.str();
+                internalNode->add_child(mk<LeafNode>(bodyRel + "(" + joinedTupleStr + ")"));
+                internalNode->setSize(internalNode->getSize() + 1);
+                // for a binary constraint, display the corresponding values and do not recurse
+            } else if (contains(constraintList, bodyRel)) {
+                std::stringstream joinedConstraint;
+
+                // FIXME: We need type info in order to figure out how to print arguments.
+                BinaryConstraintOp rawBinOp = toBinaryConstraintOp(bodyRel);
+                if (isOrderedBinaryConstraintOp(rawBinOp)) {
+                    joinedConstraint << subproofTuple[0] << " " << bodyRel << " " << subproofTuple[1];
+                } else {
+                    joinedConstraint << bodyRel << "(\"" << symTable.decode(subproofTuple[0]) << "\", \""
+                                     << symTable.decode(subproofTuple[1]) << "\")";
+                }
+
+                internalNode->add_child(mk<LeafNode>(joinedConstraint.str()));
+                internalNode->setSize(internalNode->getSize() + 1);
+                // otherwise, for a normal tuple, recurse
+            } else {
+                auto child = buildTree(
+                        bodyRel, subproofTuple, literal.ruleNum, literal.levelNum, depthLimit - 1);
+                internalNode->setSize(internalNode->getSize() + child->getSize());
+                internalNode->add_child(std::move(child));
+            }
+        }
+
+        return internalNode;
+    }
+
+    /** Get the subproofs of a tuple, laid out as returned by its subproof subroutine */
+    const std::vector<RamDomain>& getSubproofs(
+            const std::string& relName, const std::vector<RamDomain>& tuple, int ruleNum, int levelNum) {
+        auto key = std::make_tuple(relName, tuple, ruleNum, levelNum);
+        {
+            std::lock_guard<std::mutex> guard(cacheLock);
+            auto it = subproofCache.find(key);
+            if (it != subproofCache.end()) {
+                return it->second;
+            }
+        }
+
+        // the subproofs are computed without holding the lock, a concurrent duplicate is dropped
+        std::vector<RamDomain> ret;
+        if (lazy) {
+            std::lock_guard<std::mutex> guard(searchLock);
+            ret = findSubproofs(relName, tuple, ruleNum, levelNum);
+        } else {
+            std::vector<RamDomain> args(tuple);
+            args.push_back(levelNum);
+            prog.executeSubroutine(relName + "_" + std::to_string(ruleNum) + "_subproof", args, ret);
+        }
+        std::lock_guard<std::mutex> guard(cacheLock);
+        return subproofCache.emplace(std::move(key), std::move(ret)).first->second;
+    }
+
+    using TupleKey = std::pair<std::string, std::vector<RamDomain>>;
+
+    /** Rule and level number of the derived tuples */
+    std::map<TupleKey, std::pair<int, int>> derivations;
+
+    /** Highest level below which a tuple is known to have no proof */
+    std::map<TupleKey, int> unprovable;
+
+    /** Body instantiations of a rule for a head tuple, as returned by its subproof subroutine */
+    std::map<std::pair<TupleKey, int>, std::vector<RamDomain>> instantiations;
+
+    /** Get the body instantiations of a rule for a head tuple */
+    const std::vector<RamDomain>& getInstantiations(
+            const std::string& relName, const std::vector<RamDomain>& tuple, int ruleNum) {
+        auto key = std::make_pair(std::make_pair(relName, tuple), ruleNum);
+        auto it = instantiations.find(key);
+        if (it == instantiations.end()) {
+            std::vector<RamDomain> ret;
+            prog.executeSubroutine(relName + "_" + std::to_string(ruleNum) + "_subproof", tuple, ret);
+            it = instantiations.emplace(key, std::move(ret)).first;
+        }
+        return it->second;
+    }
+
+    /** Get the number of values of a body instantiation of a rule */
+    std::size_t getInstantiationWidth(const std::string& relName, int ruleNum) {
+        std::size_t width = 0;
+        const auto& bodyRelations = info.at(std::make_pair(relName, ruleNum));
+        for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
+            std::string bodyRel = splitString(*it, ',')[0];
+            if (contains(constraintList, bodyRel)) {
+                width += 2;
+            } else {
+                // atoms and negations are followed by their rule and level number
+                auto bodyRelAtomName = bodyRel[0] == '!' ? bodyRel.substr(1) : bodyRel;
+                width += prog.getRelation(bodyRelAtomName)->getPrimaryArity() + 2;
+            }
+        }
+        return width;
+    }
+
+    /**
+     * Complete a body instantiation of a rule with the rule and level numbers
+     * of its atoms, if all atoms have a proof of at most the given level.
+     * Returns the level of the resulting proof of the head, or -1 otherwise.
+     */
+    int completeInstantiation(
+            const std::string& relName, int ruleNum, std::vector<RamDomain>& instantiation, int levelNum) {
+        int level = 1;
+        std::size_t pos = 0;
+        const auto& bodyRelations = info.at(std::make_pair(relName, ruleNum));
+        for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
+            std::string bodyRel = splitString(*it, ',')[0];
+            if (contains(constraintList, bodyRel)) {
+                pos += 2;
+                continue;
+            }
+            if (bodyRel[0] == '!') {
+                pos += prog.getRelation(bodyRel.substr(1))->getPrimaryArity() + 2;
+                continue;
+            }
+            std::size_t arity = prog.getRelation(bodyRel)->getPrimaryArity();
+            std::vector<RamDomain> bodyTuple(
+                    instantiation.begin() + pos, instantiation.begin() + pos + arity);
+            if (!proveTuple(bodyRel, bodyTuple, levelNum)) {
+                return -1;
+            }
+            const auto& derivation = derivations.at(std::make_pair(bodyRel, bodyTuple));
+            instantiation[pos + arity] = derivation.first;
+            instantiation[pos + arity + 1] = derivation.second;
+            level = std::max(level, derivation.second + 1);
+            pos += arity + 2;
+        }
+        return level;
+    }
+
+    /**
+     * Check whether a tuple has a proof of at most the given level, recording
+     * the rule and level number of the proof found.
+     *
+     * Tuples of input relations, program facts and tuples that no rule derives
+     * are facts of level 0 at any level; program facts are accepted before any
+     * rule is tried, as a fact may also be derived through a cycle. The failures
+     * are recorded per level, hence a tuple is searched at most once per level.
+     */
+    bool proveTuple(const std::string& relName, const std::vector<RamDomain>& tuple, int levelNum) {
+        auto key = std::make_pair(relName, tuple);
+        auto derivation = derivations.find(key);
+        if (derivation != derivations.end() && derivation->second.second <= levelNum) {
+            return true;
+        }
+        auto failure = unprovable.find(key);
+        if (failure != unprovable.end() && levelNum <= failure->second) {
+            return false;
+        }
+
+        bool derived = false;
+        auto rel = prog.getRelation(relName);
+        if (contains(prog.getInputRelations(), rel) || isProgramFact(relName, tuple)) {
+            derivations[key] = std::make_pair(0, 0);
+            return true;
+        }
+        for (auto it = info.lower_bound(std::make_pair(relName, 0));
+                it != info.end() && it->first.first == relName; ++it) {
+            int ruleNum = it->first.second;
+            const auto& values = getInstantiations(relName, tuple, ruleNum);
+            std::size_t width = getInstantiationWidth(relName, ruleNum);
+            for (std::size_t pos = 0; pos + width <= values.size() && width > 0; pos += width) {
+                derived = true;
+                if (levelNum == 0) {
+                    break;
+                }
+                std::vector<RamDomain> instantiation(values.begin() + pos, values.begin() + pos + width);
+                int level = completeInstantiation(relName, ruleNum, instantiation, levelNum - 1);
+                if (level != -1) {
+                    derivations[key] = std::make_pair(ruleNum, level);
+                    return true;
+                }
+            }
+        }
+
+        // a tuple that no rule derives is a fact, whichever level it is first searched at
+        if (!derived) {
+            derivations[key] = std::make_pair(0, 0);
+            return true;
+        }
+
+        unprovable[key] = levelNum;
+        return false;
+    }
+
+    /**
+     * Derive a tuple by iterative deepening of the level, returning the rule
+     * and level number of its proof.
+     *
+     * The height of a proof is bounded by the number of tuples, hence a search
+     * exhausting the bound is an error.
+     */
+    std::pair<int, int> deriveTuple(const std::string& relName, const std::vector<RamDomain>& tuple) {
+        std::lock_guard<std::mutex> guard(searchLock);
+        std::size_t bound = 0;
+        for (auto* rel : prog.getAllRelations()) {
+            bound += rel->size();
+        }
+        for (std::size_t levelNum = 0; levelNum <= bound; levelNum++) {
+            if (proveTuple(relName, tuple, levelNum)) {
+                return derivations.at(std::make_pair(relName, tuple));
+            }
+        }
+        fatal("no proof for a tuple of `%s`", relName);
+    }
+
+    /** Check whether a tuple is a fact of the program */
+    bool isProgramFact(const std::string& relName, const std::vector<RamDomain>& tuple) {
+        std::vector<RamDomain> ret;
+        prog.executeSubroutine(relName + "_fact", tuple, ret);
+        return !ret.empty();
+    }
+
+    /**
+     * Find the subproofs of a derived tuple, laid out as returned by the
+     * subproof subroutine of annotated relations
+     */
+    std::vector<RamDomain> findSubproofs(
+            const std::string& relName, const std::vector<RamDomain>& tuple, int ruleNum, int levelNum) {
+        const auto& values = getInstantiations(relName, tuple, ruleNum);
+        std::size_t width = getInstantiationWidth(relName, ruleNum);
+        for (std::size_t pos = 0; pos + width <= values.size() && width > 0; pos += width) {
+            std::vector<RamDomain> instantiation(values.begin() + pos, values.begin() + pos + width);
+            if (completeInstantiation(relName, ruleNum, instantiation, levelNum - 1) != -1) {
+                return instantiation;
+            }
+        }
+        fatal("no subproof for a derived tuple of `%s`", relName);
+    }
+
     RamDomain lookupExisting(const std::string& symbol) {
         auto Res = symTable.findOrInsert(symbol);
         if (Res.second) {
@@ -787,6 +1115,11 @@ private:
             }
 
             if (match) {
+                // without annotations, the rule and level are only known once the tuple is derived
+                if (lazy) {
+                    return std::make_tuple(0, 0);
+                }
+
                 RamDomain ruleNum;
                 tuple >> ruleNum;
 
@@ -17,9 +17,14 @@
 #pragma once
 
 #include "souffle/RamTypes.h"
+#include "souffle/datastructure/HyperLogLog.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
+#include <algorithm>
 #include <csignal>
+#include <cstddef>
+#include <cstdint>
 
 namespace souffle::evaluator {
 
@@ -109,4 +114,100 @@ lxor_infix::curry<A> operator+(A x, lxor_infix) {
     return lxor_infix::curry<A>{x};
 }
 
+/**
+ * Estimates the join size of a relation, i.e. the average number of tuples per
+ * distinct key among the tuples matching the constants of the estimate, or the
+ * number of matching tuples if the key consists of constants only.
+ *
+ * The partitions of the relation are scanned once in parallel. Each thread
+ * sketches the keys it encounters and the sketches are merged at the end, so
+ * neither a sorted scan nor a comparison with the previous tuple is required.
+ */
+template <typename Partitions, typename Matches /* tuple -> bool */, typename HashKey /* tuple -> uint64_t */>
+double estimateJoinSize(
+        const Partitions& partitions, bool onlyConstants, Matches&& matches, HashKey&& hashKey) {
+    HyperLogLog<> keys;
+    std::size_t total = 0;
+    Lock lock;
+
+    const auto count = static_cast<int>(partitions.size());
+    PARALLEL_START
+        HyperLogLog<> localKeys;
+        std::size_t localTotal = 0;
+        pfor(int i = 0; i < count; i++) {
+            for (const auto& tuple : partitions[i]) {
+                if (!matches(tuple)) {
+                    continue;
+                }
+                ++localTotal;
+                if (!onlyConstants) {
+                    localKeys.insert(hashKey(tuple));
+                }
+            }
+        }
+        lock.lock();
+        keys.merge(localKeys);
+        total += localTotal;
+        lock.unlock();
+    PARALLEL_END
+
+    if (onlyConstants) {
+        return static_cast<double>(total);
+    }
+    // the number of distinct keys can not exceed the number of tuples
+    double distinct = std::min(keys.estimate(), static_cast<double>(total));
+    return static_cast<double>(total) / std::max(1.0, distinct);
+}
+
+/**
+ * Intersects the values of a column over several relations by leapfrogging.
+ *
+ * The seek function obtains the least value not below a given value in the
+ * column of a relation, among the tuples matching the pattern of the relation,
+ * and returns false if there is no such value. The relations are seeked in
+ * turn to the largest value found so far, until all of them agree on it.
+ */
+template <typename Seek /* (std::size_t part, RamDomain value, RamDomain& found) -> bool */>
+class Leapfrog {
+public:
+    Leapfrog(std::size_t numParts, Seek seek) : numParts(numParts), seek(std::move(seek)) {}
+
+    /** Obtains the next value common to all relations in ascending order, returns false if there is none */
+    bool next(RamDomain& value) {
+        std::size_t agreeing = 0;
+        while (!exhausted) {
+            RamDomain found;
+            if (!seek(part, candidate, found)) {
+                exhausted = true;
+                break;
+            }
+            part = (part + 1) % numParts;
+            if (found != candidate) {
+                candidate = found;
+                agreeing = 1;
+                continue;
+            }
+            if (++agreeing < numParts) {
+                continue;
+            }
+
+            value = candidate;
+            if (candidate == MAX_RAM_SIGNED) {
+                exhausted = true;
+            } else {
+                ++candidate;
+            }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const std::size_t numParts;
+    Seek seek;
+    RamDomain candidate = MIN_RAM_SIGNED;
+    std::size_t part = 0;
+    bool exhausted = false;
+};
+
 }  // namespace souffle::evaluator
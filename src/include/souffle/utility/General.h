@@ -18,10 +18,18 @@
 
 #if defined(_MSC_VER)
 #define SOUFFLE_ALWAYS_INLINE /* TODO: MSVC equiv */
+#define SOUFFLE_HOT
+#define SOUFFLE_COLD __declspec(noinline)
+#define SOUFFLE_UNLIKELY(x) (x)
 #else
 // clang / gcc recognize this attribute
 // NB: GCC will only inline when optimisation is on, and will warn about it.
 //     Adding `inline` (even though the KW nominally has nothing to do with
 //     inlining) will force it to inline in all cases. Lovely.
 #define SOUFFLE_ALWAYS_INLINE [[gnu::always_inline]] inline
+// Hot functions are optimised more aggressively, cold functions are optimised for size.
+// Both are grouped in sections of their own, keeping the hot code contiguous.
+#define SOUFFLE_HOT [[gnu::hot]]
+#define SOUFFLE_COLD [[gnu::cold, gnu::noinline]]
+#define SOUFFLE_UNLIKELY(x) __builtin_expect(!!(x), 0)
 #endif
@@ -0,0 +1,153 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NumaUtil.h
+ *
+ * @brief Utilities for non-uniform memory access (NUMA) machines
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace souffle {
+
+/**
+ * The NUMA nodes of the machine, each given by the processors it holds.
+ *
+ * On Linux the nodes are read from sysfs, restricted to the processors the
+ * process may run on. Elsewhere, or if the information is unavailable, the
+ * machine has a single node holding all processors.
+ */
+class NumaTopology {
+public:
+    /** Create a topology of the given processors of each node */
+    explicit NumaTopology(std::vector<std::vector<int>> processors) : nodes(std::move(processors)) {
+        nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const auto& node) { return node.empty(); }),
+                nodes.end());
+        for (std::size_t node = 0; node < nodes.size(); ++node) {
+            for (int cpu : nodes[node]) {
+                if (static_cast<std::size_t>(cpu) >= nodeOf.size()) {
+                    nodeOf.resize(cpu + 1, 0);
+                }
+                nodeOf[cpu] = node;
+            }
+        }
+    }
+
+    /** Obtain the topology of this machine */
+    static const NumaTopology& instance() {
+        static const NumaTopology topology(readProcessors());
+        return topology;
+    }
+
+    /** Get the number of nodes, which is at least one */
+    std::size_t getNumNodes() const {
+        return std::max<std::size_t>(nodes.size(), 1);
+    }
+
+    /** Get the processors of a node */
+    const std::vector<int>& getProcessors(std::size_t node) const {
+        return nodes[node];
+    }
+
+    /** Get the node of a processor */
+    std::size_t getNode(int cpu) const {
+        return cpu >= 0 && static_cast<std::size_t>(cpu) < nodeOf.size() ? nodeOf[cpu] : 0;
+    }
+
+    /** Get the node the calling thread currently runs on */
+    std::size_t getCurrentNode() const {
+#ifdef __linux__
+        if (nodes.size() > 1) {
+            return getNode(sched_getcpu());
+        }
+#endif
+        return 0;
+    }
+
+    /**
+     * Parse a list of processors in the format of sysfs, such as "0-3,8,10-11"
+     */
+    static std::vector<int> parseList(const std::string& list) {
+        std::vector<int> result;
+        std::stringstream in(list);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            if (item.find_first_of("0123456789") == std::string::npos) {
+                continue;
+            }
+            const std::size_t dash = item.find('-');
+            const int first = std::stoi(item.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        }
+        return result;
+    }
+
+private:
+    static std::vector<std::vector<int>> readProcessors() {
+        std::vector<std::vector<int>> processors;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+        for (int node : parseList(readLine("/sys/devices/system/node/online"))) {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            std::vector<int> cpus;
+            for (int cpu : parseList(readLine(path))) {
+                if (!restricted || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+                    cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty()) {
+                processors.push_back(std::move(cpus));
+            }
+        }
+#endif
+        if (processors.empty()) {
+            std::vector<int> cpus;
+            for (unsigned cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu) {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+            processors.push_back(std::move(cpus));
+        }
+        return processors;
+    }
+
+    static std::string readLine(const std::string& path) {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    /** Processors of each node */
+    std::vector<std::vector<int>> nodes;
+
+    /** Node of each processor */
+    std::vector<std::size_t> nodeOf;
+};
+
+}  // namespace souffle
@@ -17,11 +17,23 @@
 
 #pragma once
 
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/NumaUtil.h"
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // https://bugs.llvm.org/show_bug.cgi?id=41423
 #if defined(__cpp_lib_hardware_interference_size) && (__cpp_lib_hardware_interference_size != 201703L)
@@ -881,4 +893,394 @@ inline Lock& getOutputLock() {
     return outputLock;
 }
 
+/**
+ * Executes independent tasks concurrently and waits until all of them have
+ * completed. The threads are shared evenly among the tasks, such that the
+ * parallel regions nested in a task run on the share of the task.
+ */
+inline void parallelInvoke(const std::vector<std::function<void()>>& tasks) {
+#if defined(IS_PARALLEL) && _OPENMP >= 200805
+    const int numTasks = static_cast<int>(tasks.size());
+    const int numThreads = omp_get_max_threads();
+    if (numTasks > 1 && numThreads > 1) {
+        const int share = std::max(numThreads / numTasks, 1);
+        omp_set_max_active_levels(std::max(omp_get_max_active_levels(), omp_get_level() + 2));
+#pragma omp parallel for schedule(dynamic, 1) num_threads(std::min(numTasks, numThreads))
+        for (int i = 0; i < numTasks; ++i) {
+            omp_set_num_threads(share);
+            tasks[i]();
+        }
+        return;
+    }
+#endif
+    for (const auto& task : tasks) {
+        task();
+    }
+}
+
+/**
+ * Whether bindThreads has bound the threads to the NUMA nodes of the machine.
+ */
+inline std::atomic<bool>& threadsBound() {
+    static std::atomic<bool> bound{false};
+    return bound;
+}
+
+/**
+ * Binds the threads of a team to the NUMA nodes of the machine, filling the
+ * processors of one node before moving on to the next. A thread may run on any
+ * processor of its node, such that the threads of nested teams, which inherit
+ * the binding, stay on the node as well. Since the threads of OpenMP persist
+ * between parallel regions, memory allocated by a thread is placed on its node
+ * on first touch, and so are the nodes of the relations it inserts into.
+ */
+inline void bindThreads() {
+#if defined(IS_PARALLEL) && defined(__linux__)
+    const NumaTopology& topology = NumaTopology::instance();
+    if (topology.getNumNodes() < 2) {
+        return;
+    }
+    threadsBound() = true;
+    std::vector<std::size_t> nodeOfSlot;
+    for (std::size_t node = 0; node < topology.getNumNodes(); ++node) {
+        nodeOfSlot.insert(nodeOfSlot.end(), topology.getProcessors(node).size(), node);
+    }
+#pragma omp parallel
+    {
+        const std::size_t node = nodeOfSlot[omp_get_thread_num() % nodeOfSlot.size()];
+        cpu_set_t processors;
+        CPU_ZERO(&processors);
+        for (int cpu : topology.getProcessors(node)) {
+            CPU_SET(cpu, &processors);
+        }
+        sched_setaffinity(0, sizeof(processors), &processors);
+    }
+#endif
+}
+
+/**
+ * Obtains the share of a range of the index-th of a team of workers.
+ */
+template <typename Range>
+auto getShare(Range&& range, std::size_t index, std::size_t size) {
+    using iterator = std::decay_t<decltype(range.begin())>;
+    std::size_t length = 0;
+    for (iterator it = range.begin(); it != range.end(); ++it) {
+        length++;
+    }
+    iterator first = range.begin();
+    for (std::size_t i = 0; i < length * index / size; ++i) {
+        ++first;
+    }
+    iterator last = first;
+    for (std::size_t i = length * index / size; i < length * (index + 1) / size; ++i) {
+        ++last;
+    }
+    return make_range(first, last);
+}
+
+/**
+ * A parallel scan over a partition of ranges, which splits ranges on demand.
+ *
+ * Each thread of a team obtains a worker, which scans the ranges taken from a
+ * shared pool. Once the pool runs dry, a worker about to scan a tuple hands the
+ * remainder of its range to the idle workers of the team, such that a few
+ * expensive tuples do not leave the rest of the team waiting. Nested scans are
+ * used as follows, where a break ends the scan of the current range:
+ *
+ *     auto worker = scan.worker();
+ *     while (worker.next()) {
+ *         for (; !worker.done(); worker.advance()) {
+ *             const auto& tuple = worker.get();
+ *             ...
+ *         }
+ *     }
+ *
+ * If the partition holds fewer tuples than the given threshold, the scan is
+ * replicated instead: each worker scans all tuples and the first nested loop
+ * is split among the team by taking the share of the worker of its range.
+ *
+ * Once bindThreads has bound the threads to the NUMA nodes, the pool is split
+ * into a block of consecutive ranges of the partition per node. Workers take
+ * ranges from the block of the node they run on, and the remainders they hand
+ * over, before taking ranges of other nodes once their own block is exhausted.
+ * The blocks are assigned by position in the partition, not by the node the
+ * memory of their tuples is placed on.
+ *
+ * The time each worker spent scanning is recorded to expose the imbalance of
+ * the team.
+ */
+template <typename Range>
+class WorkStealingScan {
+public:
+    using iterator = std::decay_t<decltype(std::declval<const Range&>().begin())>;
+
+    class Worker {
+    public:
+        explicit Worker(WorkStealingScan& scan) : scan(scan) {
+#ifdef _OPENMP
+            teamIndex = omp_get_thread_num();
+            teamSize = omp_get_num_threads();
+#endif
+            node = NumaTopology::instance().getCurrentNode() % scan.pools.size();
+        }
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        ~Worker() {
+            if (part) {
+                release();
+            }
+            scan.record(busy);
+        }
+
+        /** Take the next range to scan, return false once the scan completed */
+        bool next() {
+            if (part) {
+                release();
+            }
+            if (scan.replicated) {
+                if (numReplicated == scan.ranges.size()) {
+                    return false;
+                }
+                part.emplace(scan.ranges[numReplicated++]);
+            } else if (!scan.acquire(part, node)) {
+                return false;
+            }
+            start = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        /** Check whether the current range is exhausted */
+        bool done() const {
+            return part->first == part->second;
+        }
+
+        /** Move to the next tuple, handing the rest of the range to idle workers */
+        void advance() {
+            auto& [cur, end] = *part;
+            ++cur;
+            if (cur != end && scan.idle.load(std::memory_order_relaxed) > 0) {
+                iterator keep = cur;
+                part.emplace(keep, scan.donate(cur, end, node));
+            }
+        }
+
+        /** Get the current tuple */
+        decltype(auto) get() {
+            return *part->first;
+        }
+
+        /** Get the position of the worker in its team */
+        std::size_t getTeamIndex() const {
+            return teamIndex;
+        }
+
+        /** Get the number of workers in the team */
+        std::size_t getTeamSize() const {
+            return teamSize;
+        }
+
+        /** Get the share of a nested range, which is the whole range unless the scan is replicated */
+        template <typename Nested>
+        auto share(Nested&& range) const {
+            if (scan.replicated) {
+                return getShare(range, teamIndex, teamSize);
+            }
+            return make_range(range.begin(), range.end());
+        }
+
+    private:
+        void release() {
+            busy += std::chrono::steady_clock::now() - start;
+            part.reset();
+            if (!scan.replicated) {
+                scan.active--;
+            }
+        }
+
+        WorkStealingScan& scan;
+
+        /** Remainder of the range scanned */
+        std::optional<std::pair<iterator, iterator>> part;
+
+        /** Number of ranges scanned if the scan is replicated */
+        std::size_t numReplicated = 0;
+
+        /** Position of the worker in its team */
+        std::size_t teamIndex = 0;
+        std::size_t teamSize = 1;
+
+        /** NUMA node of the worker */
+        std::size_t node = 0;
+
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration busy{0};
+    };
+
+    explicit WorkStealingScan(const std::vector<Range>& partition, std::size_t replicateBelow = 0,
+            std::size_t numNodes = threadsBound() ? NumaTopology::instance().getNumNodes() : 1)
+            : pools(std::max<std::size_t>(numNodes, 1)) {
+        for (const Range& range : partition) {
+            if (range.begin() != range.end()) {
+                ranges.emplace_back(range.begin(), range.end());
+            }
+        }
+        // ranges are taken from the back, such that each node scans its block in order
+        for (std::size_t node = 0; node < pools.size(); ++node) {
+            std::size_t first = ranges.size() * node / pools.size();
+            for (std::size_t i = ranges.size() * (node + 1) / pools.size(); i > first; --i) {
+                pools[node].push_back(ranges[i - 1]);
+            }
+        }
+        pooled = ranges.size();
+
+        std::size_t size = 0;
+        for (auto cur = ranges.begin(); cur != ranges.end() && size < replicateBelow; ++cur) {
+            for (iterator it = cur->first; it != cur->second && size < replicateBelow; ++it) {
+                size++;
+            }
+        }
+        replicated = size < replicateBelow;
+    }
+
+    /** Check whether each worker scans all tuples */
+    bool isReplicated() const {
+        return replicated;
+    }
+
+    /** Obtain the worker of a thread of the team */
+    Worker worker() {
+        return Worker(*this);
+    }
+
+    /** Get the number of workers taking part in the scan */
+    std::size_t getNumWorkers() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return busyTimes.size();
+    }
+
+    /** Get the scan time of the busiest worker in microseconds */
+    std::size_t getMaxBusyTime() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return busyTimes.empty() ? 0 : *std::max_element(busyTimes.begin(), busyTimes.end());
+    }
+
+    /** Get the scan time of all workers in microseconds */
+    std::size_t getTotalBusyTime() const {
+        std::lock_guard<std::mutex> guard(lock);
+        std::size_t total = 0;
+        for (std::size_t time : busyTimes) {
+            total += time;
+        }
+        return total;
+    }
+
+    /** Get the number of ranges split on demand */
+    std::size_t getNumSplits() const {
+        return splits;
+    }
+
+private:
+    bool acquire(std::optional<std::pair<iterator, iterator>>& part, std::size_t node) {
+        bool waiting = false;
+        while (true) {
+            // wait without the lock while others may still hand out work
+            if (pooled.load() == 0 && active.load() > 0) {
+                if (!waiting) {
+                    waiting = true;
+                    idle++;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            if (waiting) {
+                idle--;
+            }
+            if (pooled.load() == 0) {
+                if (active.load() == 0) {
+                    return false;
+                }
+                waiting = false;
+                continue;
+            }
+            if (!pools[node].empty()) {
+                part.emplace(pools[node].back());
+                pools[node].pop_back();
+            } else {
+                // take the last range of the fullest other node, leaving its next ranges to itself
+                auto& pool = *std::max_element(pools.begin(), pools.end(),
+                        [](const auto& a, const auto& b) { return a.size() < b.size(); });
+                part.emplace(pool.front());
+                pool.pop_front();
+            }
+            pooled--;
+            active++;
+            return true;
+        }
+    }
+
+    /** Split the rest of a range after the current tuple among idle workers, return its new end */
+    iterator donate(const iterator& cur, const iterator& end, std::size_t node) {
+        iterator rest = cur;
+        ++rest;
+        std::size_t size = 0;
+        for (iterator it = rest; it != end; ++it) {
+            size++;
+        }
+        if (size == 0) {
+            return end;
+        }
+        std::size_t numPieces = std::min<std::size_t>(std::max(idle.load(), 1), size);
+        std::size_t pieceSize = (size + numPieces - 1) / numPieces;
+        std::vector<std::pair<iterator, iterator>> pieces;
+        for (iterator it = rest; it != end;) {
+            iterator pieceBegin = it;
+            for (std::size_t i = 0; i < pieceSize && it != end; ++i) {
+                ++it;
+            }
+            pieces.emplace_back(pieceBegin, it);
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto piece = pieces.rbegin(); piece != pieces.rend(); ++piece) {
+            pools[node].push_back(*piece);
+        }
+        pooled += pieces.size();
+        splits++;
+        return rest;
+    }
+
+    void record(std::chrono::steady_clock::duration busy) {
+        std::lock_guard<std::mutex> guard(lock);
+        busyTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(busy).count());
+    }
+
+    mutable std::mutex lock;
+
+    /** Flag whether each worker scans all ranges */
+    bool replicated = false;
+
+    /** Ranges of the partition */
+    std::vector<std::pair<iterator, iterator>> ranges;
+
+    /** Ranges not yet taken by a worker, per block of a NUMA node */
+    std::vector<std::deque<std::pair<iterator, iterator>>> pools;
+
+    /** Number of ranges in the pools */
+    std::atomic<std::size_t> pooled{0};
+
+    /** Number of workers scanning a range */
+    std::atomic<std::size_t> active{0};
+
+    /** Number of workers waiting for a range */
+    std::atomic<int> idle{0};
+
+    /** Number of ranges split on demand */
+    std::atomic<std::size_t> splits{0};
+
+    /** Scan time of the workers in microseconds */
+    std::vector<std::size_t> busyTimes;
+};
+
 }  // namespace souffle
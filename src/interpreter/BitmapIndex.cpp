@@ -0,0 +1,35 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BitmapIndex.cpp
+ *
+ * Interpreter bitmap index with generic interface.
+ *
+ ***********************************************************************/
+
+#include "interpreter/Relation.h"
+#include "ram/Relation.h"
+#include "ram/analysis/Index.h"
+#include "souffle/utility/MiscUtil.h"
+
+namespace souffle::interpreter {
+
+#define CREATE_BITMAP_REL(Structure, Arity, AuxiliaryArity, ...)              \
+    if (id.getArity() == Arity && id.getAuxiliaryArity() == AuxiliaryArity) { \
+        return mk<BitmapRelation<Arity>>(id.getName(), indexSelection);       \
+    }
+
+Own<RelationWrapper> createBitmapRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection) {
+    FOR_EACH_BITMAP(CREATE_BITMAP_REL);
+    fatal("Bitmap relations must be unary or binary.");
+}
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,107 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompiledTier.cpp
+ *
+ * Implements the compiled tier taking over the evaluation from the interpreter
+ *
+ ***********************************************************************/
+
+#include "interpreter/CompiledTier.h"
+#include <filesystem>
+#include <chrono>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifndef _MSC_VER
+#include <dlfcn.h>
+#endif
+
+namespace souffle::interpreter {
+
+namespace {
+/** Instantiates the program of a factory, whose instantiation is only accessible to subclasses */
+struct FactoryAccess : public ProgramFactory {
+    static SouffleProgram* instantiate(ProgramFactory& factory) {
+        SouffleProgram* (ProgramFactory::*create)() = &FactoryAccess::newInstance;
+        return (factory.*create)();
+    }
+};
+
+/** Removes a directory and its files, ignoring errors */
+void removeDirectory(const std::string& directory) {
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+}
+}  // namespace
+
+CompiledTier::CompiledTier(
+        std::function<bool()> compile, std::string library, std::string id, std::string directory)
+        : status(std::make_shared<std::atomic<Status>>(Compiling)), library(std::move(library)),
+          id(std::move(id)), directory(std::move(directory)) {
+    // the thread is detached, such that a compilation outlasting the interpreter does not delay the exit
+    std::thread([compile = std::move(compile), status = status, directory = this->directory]() {
+        Status expected = Compiling;
+        if (!status->compare_exchange_strong(expected, compile() ? Compiled : Failed)) {
+            // the tier was destroyed meanwhile, so the files the compilation left behind are removed
+            removeDirectory(directory);
+        }
+    }).detach();
+}
+
+CompiledTier::~CompiledTier() {
+    // the program must be destroyed before its code is unloaded
+    program.reset();
+#ifndef _MSC_VER
+    if (handle != nullptr) {
+        dlclose(handle);
+    }
+#endif
+    *status = Abandoned;
+    removeDirectory(directory);
+}
+
+SouffleProgram* CompiledTier::poll(bool wait) {
+    while (wait && *status == Compiling) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (wait && *status == Failed && program == nullptr) {
+        std::cerr << "Warning: compilation of the compiled tier failed, interpreting only\n";
+    }
+    if (program != nullptr || *status != Compiled) {
+        return program.get();
+    }
+#ifndef _MSC_VER
+    handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        std::cerr << "Warning: cannot load compiled tier " << library << ": " << dlerror() << "\n";
+        *status = Failed;
+        return nullptr;
+    }
+    // the factory of the program is exported by name, since the library has its own factory registry
+    const std::string factoryName = "__factory_Sf_" + id + "_instance";
+    auto* factory = static_cast<ProgramFactory*>(dlsym(handle, factoryName.c_str()));
+    if (factory == nullptr) {
+        std::cerr << "Warning: cannot find the program of compiled tier " << library << "\n";
+        *status = Failed;
+        return nullptr;
+    }
+    program.reset(FactoryAccess::instantiate(*factory));
+    // the library stays mapped once loaded, so its files are no longer needed
+    removeDirectory(directory);
+#else
+    *status = Failed;
+#endif
+    return program.get();
+}
+
+}  // namespace souffle::interpreter
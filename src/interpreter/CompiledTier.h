@@ -0,0 +1,70 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompiledTier.h
+ *
+ * Defines the compiled tier taking over the evaluation from the interpreter
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/SouffleInterface.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace souffle::interpreter {
+
+/**
+ * @class CompiledTier
+ * @brief Compiled program taking over the evaluation of the strata from the interpreter
+ *
+ * The program is synthesised as a shared library and compiled in the background
+ * while the interpreter starts evaluating. Once the library is ready, the engine
+ * hands the relations computed so far to the compiled program, which evaluates
+ * the remaining strata. The directory of the synthesised sources and the library
+ * is removed once the library is loaded, or with the tier otherwise.
+ */
+class CompiledTier {
+public:
+    /**
+     * @brief Start compiling the library in the background
+     * @param compile Compilation of the library, returning whether it succeeded
+     * @param library Path of the shared library
+     * @param id Identifier of the synthesised program
+     * @param directory Temporary directory of the sources and the library, owned by the tier
+     */
+    CompiledTier(std::function<bool()> compile, std::string library, std::string id, std::string directory);
+    ~CompiledTier();
+
+    /**
+     * @brief Get the compiled program, or nullptr while it is compiled or if its compilation failed
+     * @param wait Whether to wait for a compilation still running
+     */
+    SouffleProgram* poll(bool wait = false);
+
+private:
+    /** Status of the compilation shared with the compiling thread */
+    enum Status { Compiling, Compiled, Failed, Abandoned };
+    std::shared_ptr<std::atomic<Status>> status;
+
+    std::string library;
+    std::string id;
+    std::string directory;
+
+    /** Handle of the loaded library and the program instantiated from it */
+    void* handle = nullptr;
+    Own<SouffleProgram> program;
+};
+
+}  // namespace souffle::interpreter
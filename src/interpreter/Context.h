@@ -18,7 +18,9 @@
 
 #include "interpreter/Index.h"
 #include "interpreter/Relation.h"
+#include "ram/Operation.h"
 #include "souffle/RamTypes.h"
+#include "souffle/utility/ParallelUtil.h"
 #include <cassert>
 #include <cstddef>
 #include <memory>
@@ -34,21 +36,25 @@ class Context {
     using ViewPtr = Own<ViewWrapper>;
 
 public:
-    Context(std::size_t size = 0) : data(size) {}
+    /** The frame of tuple and variable slots is resolved by the generator and allocated once */
+    Context(std::size_t frameSize = 0, std::size_t numVariables = 0)
+            : data(frameSize), variables(numVariables) {}
 
     /** This constructor is used when program enter a new scope.
-     * Only Subroutine value needs to be copied */
-    Context(Context& ctxt) : returnValues(ctxt.returnValues), args(ctxt.args) {}
+     * Subroutine values and variables, such as the loop counter read by delta tags, are copied, and a
+     * frame of the same size is allocated */
+    Context(Context& ctxt)
+            : data(ctxt.data.size()), returnValues(ctxt.returnValues), args(ctxt.args),
+              variables(ctxt.variables), iteration(ctxt.iteration) {}
     virtual ~Context() = default;
 
     const RamDomain*& operator[](std::size_t index) {
-        if (index >= data.size()) {
-            data.resize((index + 1));
-        }
+        assert(index < data.size() && "tuple id out of frame");
         return data[index];
     }
 
     const RamDomain* const& operator[](std::size_t index) const {
+        assert(index < data.size() && "tuple id out of frame");
         return data[index];
     }
 
@@ -109,12 +115,49 @@ public:
         return views[id].get();
     }
 
-    RamDomain getVariable(const std::string& name) {
-        return variables[name];
+    /** @brief Get the value of the variable in the given slot */
+    RamDomain getVariable(std::size_t slot) const {
+        assert(slot < variables.size() && "variable out of frame");
+        return variables[slot];
+    }
+
+    /** @brief Set the value of the variable in the given slot */
+    void setVariable(std::size_t slot, RamDomain value) {
+        assert(slot < variables.size() && "variable out of frame");
+        variables[slot] = value;
+    }
+
+    /** @brief Return current iteration number for loop operation */
+    std::size_t getIterationNumber() const {
+        return iteration;
+    }
+
+    /** @brief Increase iteration number by one */
+    void incIterationNumber() {
+        ++iteration;
+    }
+
+    /** @brief Reset iteration number */
+    void resetIterationNumber() {
+        iteration = 0;
+    }
+
+    /** @brief Split a loop among a team replicating the enclosing parallel loop */
+    void setSharedLoop(const ram::Operation* loop, std::size_t index, std::size_t size) {
+        sharedLoop = loop;
+        shareIndex = index;
+        shareSize = size;
+    }
+
+    /** @brief Check whether the loop is split among a team */
+    bool isSharedLoop(const ram::Operation& loop) const {
+        return &loop == sharedLoop;
     }
 
-    void setVariable(const std::string& name, RamDomain value) {
-        variables[name] = value;
+    /** @brief Return the share of this context of the range of the shared loop */
+    template <typename Range>
+    auto getShare(Range&& range) const {
+        return souffle::getShare(range, shareIndex, shareSize);
     }
 
 private:
@@ -128,7 +171,14 @@ private:
     VecOwn<RamDomain[]> allocatedDataContainer;
     /** @brief Views */
     VecOwn<ViewWrapper> views;
-    std::map<std::string, RamDomain> variables;
+    /** @brief Values of the variables */
+    std::vector<RamDomain> variables;
+    /** @brief Loop iteration counter, strata evaluated concurrently count separately */
+    std::size_t iteration = 0;
+    /** @brief Loop split among a team and the share of this context */
+    const ram::Operation* sharedLoop = nullptr;
+    std::size_t shareIndex = 0;
+    std::size_t shareSize = 1;
 };
 
 }  // namespace souffle::interpreter
@@ -22,6 +22,7 @@
 #include "interpreter/Node.h"
 #include "interpreter/Relation.h"
 #include "interpreter/ViewContext.h"
+#include "ram/AbstractParallel.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/Assign.h"
@@ -39,6 +40,7 @@
 #include "ram/Exit.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/Fork.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -47,11 +49,14 @@
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NumericConstant.h"
@@ -83,13 +88,16 @@
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
 #include "ram/Variable.h"
+#include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SignalHandler.h"
+#include "souffle/StratumPlugin.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/TypeAttribute.h"
+#include "souffle/datastructure/HyperLogLog.h"
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/io/IOSystem.h"
@@ -366,6 +374,8 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
         res = createEqrelRelation(id, isa.getIndexSelection(id.getName()));
     } else if (id.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         res = createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::BITMAP) {
+        res = createBitmapRelation(id, isa.getIndexSelection(id.getName()));
     } else {
         res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
     }
@@ -421,16 +431,84 @@ const std::vector<void*>& Engine::loadDLL() {
     return dll;
 }
 
-std::size_t Engine::getIterationNumber() const {
-    return iteration;
+void Engine::loadPlugins() {
+    if (!global.config().has("plugin")) {
+        return;
+    }
+
+    // the plugins access the relations created by the generator in place
+    PluginHost host{symbolTable, recordTable, regexCache, counter, {}};
+    for (auto& handle : relations) {
+        if (handle != nullptr) {
+            host.relations[(*handle)->getName()] = handle->get();
+        }
+    }
+
+    const std::size_t fingerprint = ram::fingerprint(tUnit.getProgram());
+    for (auto&& library : global.config().getMany("plugin")) {
+#ifndef EMSCRIPTEN
+        void* tmp = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+#else
+        void* tmp = nullptr;
+#endif
+        if (tmp == nullptr) {
+            std::cerr << "Warning: cannot load plugin " << library << "\n";
+            continue;
+        }
+        // like functor libraries, plugins stay loaded until the process exits
+        auto factory = reinterpret_cast<StratumPluginFactory>(dlsym(tmp, "souffle_stratum_plugin"));
+        StratumPlugin* plugin = factory != nullptr ? factory(host, fingerprint) : nullptr;
+        if (plugin == nullptr) {
+            std::cerr << "Warning: plugin " << library << " was not synthesised from this program\n";
+            continue;
+        }
+        plugins.emplace_back(plugin);
+        for (const auto& name : plugin->getStrata()) {
+            pluginStrata["stratum_" + name] = plugin;
+        }
+    }
 }
 
-void Engine::incIterationNumber() {
-    ++iteration;
+void Engine::setCompiledTier(Own<CompiledTier> tier) {
+    compiledTier = std::move(tier);
 }
 
-void Engine::resetIterationNumber() {
-    iteration = 0;
+SouffleProgram* Engine::switchTier() {
+    // the compiled tier may be awaited after a given number of strata, making the switch deterministic
+    const bool wait = global.config().has("tiered-wait") &&
+                      interpretedStrata >= std::stoul(global.config().get("tiered-wait"));
+    SouffleProgram* program = compiledTier->poll(wait);
+    if (program == nullptr) {
+        return nullptr;
+    }
+    if (global.config().has("verbose")) {
+        std::cout << "Switching to the compiled tier" << std::endl;
+    }
+    // copy the relations computed so far, re-encoding their symbols
+    for (auto& handle : relations) {
+        if (handle == nullptr) {
+            continue;
+        }
+        RelationWrapper& source = **handle;
+        souffle::Relation* target = program->getRelation(source.getName());
+        if (target == nullptr || target->getArity() != source.getArity()) {
+            continue;
+        }
+        for (auto it = source.begin(); it != source.end(); ++it) {
+            const RamDomain* values = *it;
+            souffle::tuple t(target);
+            for (std::size_t i = 0; i < source.getArity(); ++i) {
+                t[i] = *target->getAttrType(i) == 's'
+                               ? program->getSymbolTable().encode(symbolTable.decode(values[i]))
+                               : values[i];
+            }
+            target->insert(t);
+        }
+        source.purge();
+    }
+    program->setNumThreads(numOfThreads);
+    program->prepareStrata(true, true);
+    return program;
 }
 
 void Engine::executeMain() {
@@ -438,6 +516,9 @@ void Engine::executeMain() {
     if (global.config().has("verbose")) {
         SignalHandler::instance()->enableLogging();
     }
+    if (global.config().has("numa")) {
+        bindThreads();
+    }
 
     /* Must load functor libraries before generating IR, because the generator
      * must be able to find actual functions for each user-defined functor. */
@@ -446,19 +527,22 @@ void Engine::executeMain() {
     generateIR();
     assert(main != nullptr && "Executing an empty program");
 
+    loadPlugins();
+
     if (!profileEnabled) {
-        Context ctxt;
+        Context ctxt(frameSize, numVariables);
         execute(main.get(), ctxt);
     } else {
         ProfileEventSingleton::instance().setOutputFile(global.config().get("profile"));
-        // Prepare the frequency table for threaded use
+        // Prepare the frequency table for threaded use, strata evaluated concurrently only look it up
         const ram::Program& program = tUnit.getProgram();
-        visit(program, [&](const ram::TupleOperation& node) {
-            if (!node.getProfileText().empty()) {
-                frequencies.emplace(node.getProfileText(), std::deque<std::atomic<std::size_t>>());
-                frequencies[node.getProfileText()].emplace_back(0);
+        auto addFrequency = [&](const std::string& profileText) {
+            if (!profileText.empty() && !contains(frequencies, profileText)) {
+                frequencies[profileText].emplace_back(0);
             }
-        });
+        };
+        visit(program, [&](const ram::TupleOperation& node) { addFrequency(node.getProfileText()); });
+        visit(program, [&](const ram::Filter& node) { addFrequency(node.getProfileText()); });
         // Enable profiling for execution of main
         ProfileEventSingleton::instance().startTimer();
         ProfileEventSingleton::instance().makeTimeEvent("@time;starttime");
@@ -484,7 +568,7 @@ void Engine::executeMain() {
 
         SignalHandler::instance()->enableProfiling();
 
-        Context ctxt;
+        Context ctxt(frameSize, numVariables);
         execute(main.get(), ctxt);
         ProfileEventSingleton::instance().stopTimer();
         for (auto const& cur : frequencies) {
@@ -512,15 +596,17 @@ void Engine::generateIR() {
     if (main == nullptr) {
         main = generator.generateTree(program.getMain());
     }
+    frameSize = std::max(frameSize, generator.getFrameSize());
+    numVariables = std::max(numVariables, generator.getNumVariables());
 }
 
 void Engine::executeSubroutine(
         const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret) {
-    Context ctxt;
+    std::call_once(subroutineIR, [&]() { generateIR(); });
+    Context ctxt(frameSize, numVariables);
     ctxt.setReturnValues(ret);
     ctxt.setArguments(args);
-    generateIR();
-    execute(subroutine["stratum_" + name].get(), ctxt);
+    execute(subroutine.at("stratum_" + name).get(), ctxt);
 }
 
 RamDomain Engine::execute(const Node* node, Context& ctxt) {
@@ -581,7 +667,7 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(NumericConstant)
 
         CASE(Variable)
-            return ctxt.getVariable(cur.getName());
+            return ctxt.getVariable(shadow.getSlot());
         ESAC(Variable)
 
         CASE(StringConstant)
@@ -1126,14 +1212,14 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         CASE(TupleOperation)
             bool result = execute(shadow.getChild(), ctxt);
 
-            auto& currentFrequencies = frequencies[cur.getProfileText()];
-            while (currentFrequencies.size() <= getIterationNumber()) {
+            auto& currentFrequencies = frequencies.at(cur.getProfileText());
+            while (currentFrequencies.size() <= ctxt.getIterationNumber()) {
 #ifdef _OPENMP
 #pragma omp critical(frequencies)
 #endif
                 currentFrequencies.emplace_back(0);
             }
-            frequencies[cur.getProfileText()][getIterationNumber()]++;
+            currentFrequencies[ctxt.getIterationNumber()]++;
 
             return result;
         ESAC(TupleOperation)
@@ -1226,6 +1312,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return execute(shadow.getNestedOperation(), ctxt);
         ESAC(UnpackRecord)
 
+        CASE(LeapfrogJoin)
+            return evalLeapfrogJoin(cur, shadow, ctxt);
+        ESAC(LeapfrogJoin)
+
 #define PARALLEL_AGGREGATE(Structure, Arity, AuxiliaryArity, ...)       \
     CASE(ParallelAggregate, Structure, Arity, AuxiliaryArity)           \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
@@ -1277,11 +1367,14 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             }
 
             if (profileEnabled && frequencyCounterEnabled && !cur.getProfileText().empty()) {
-                auto& currentFrequencies = frequencies[cur.getProfileText()];
-                while (currentFrequencies.size() <= getIterationNumber()) {
+                auto& currentFrequencies = frequencies.at(cur.getProfileText());
+                while (currentFrequencies.size() <= ctxt.getIterationNumber()) {
+#ifdef _OPENMP
+#pragma omp critical(frequencies)
+#endif
                     currentFrequencies.emplace_back(0);
                 }
-                frequencies[cur.getProfileText()][getIterationNumber()]++;
+                currentFrequencies[ctxt.getIterationNumber()]++;
             }
             return result;
         ESAC(Filter)
@@ -1314,6 +1407,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH_BTREE_DELETE(ERASE)
 #undef ERASE
 
+        CASE(Fork)
+            for (const auto& child : shadow.getChildren()) {
+                if (!execute(child.get(), ctxt)) {
+                    return false;
+                }
+            }
+            return true;
+        ESAC(Fork)
+
         CASE(SubroutineReturn)
             for (std::size_t i = 0; i < cur.getNumValues(); ++i) {
                 if (shadow.getChild(i) == nullptr) {
@@ -1335,22 +1437,29 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Sequence)
 
         CASE(Parallel)
+            // each statement is evaluated in a scope of its own
+            std::atomic<bool> result{true};
+            std::vector<std::function<void()>> tasks;
             for (const auto& child : shadow.getChildren()) {
-                if (!execute(child.get(), ctxt)) {
-                    return false;
-                }
+                tasks.push_back([&, child = child.get()]() {
+                    Context branchCtxt(ctxt);
+                    if (!execute(child, branchCtxt)) {
+                        result = false;
+                    }
+                });
             }
-            return true;
+            parallelInvoke(tasks);
+            return result.load();
         ESAC(Parallel)
 
         CASE(Loop)
-            resetIterationNumber();
+            ctxt.resetIterationNumber();
 
             while (execute(shadow.getChild(), ctxt)) {
-                incIterationNumber();
+                ctxt.incIterationNumber();
             }
 
-            resetIterationNumber();
+            ctxt.resetIterationNumber();
             return true;
         ESAC(Loop)
 
@@ -1359,13 +1468,13 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Exit)
 
         CASE(LogRelationTimer)
-            Logger logger(cur.getMessage(), getIterationNumber(),
+            Logger logger(cur.getMessage(), ctxt.getIterationNumber(),
                     std::bind(&RelationWrapper::size, shadow.getRelation()));
             return execute(shadow.getChild(), ctxt);
         ESAC(LogRelationTimer)
 
         CASE(LogTimer)
-            Logger logger(cur.getMessage(), getIterationNumber());
+            Logger logger(cur.getMessage(), ctxt.getIterationNumber());
             return execute(shadow.getChild(), ctxt);
         ESAC(LogTimer)
 
@@ -1390,6 +1499,19 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #undef ESTIMATEJOINSIZE
 
         CASE(Call)
+            // the compiled tier evaluates all strata once it took over
+            if (compiledTier != nullptr && (compiled != nullptr || (compiled = switchTier()) != nullptr)) {
+                std::vector<RamDomain> args, ret;
+                compiled->executeSubroutine(cur.getName().substr(std::strlen("stratum_")), args, ret);
+                return true;
+            }
+            interpretedStrata++;
+            // strata of plugins are evaluated by their synthesised code
+            if (auto pos = pluginStrata.find(cur.getName()); pos != pluginStrata.end()) {
+                std::vector<RamDomain> args, ret;
+                pos->second->executeStratum(cur.getName().substr(std::strlen("stratum_")), args, ret);
+                return true;
+            }
             execute(subroutine[shadow.getSubroutineName()].get(), ctxt);
             return true;
         ESAC(Call)
@@ -1397,7 +1519,7 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         CASE(LogSize)
             const auto& rel = *shadow.getRelation();
             ProfileEventSingleton::instance().makeQuantityEvent(
-                    cur.getMessage(), rel.size(), static_cast<int>(getIterationNumber()));
+                    cur.getMessage(), rel.size(), static_cast<int>(ctxt.getIterationNumber()));
             return true;
         ESAC(LogSize)
 
@@ -1470,6 +1592,30 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(Query)
 
+#define MERGE(Structure, Arity, AuxiliaryArity, ...)                                                      \
+    CASE(Merge, Structure, Arity, AuxiliaryArity)                                                         \
+        const auto& src = *static_cast<RelType*>(getRelationHandle(shadow.getSourceId()).get());          \
+        auto& trg = *static_cast<RelType*>(getRelationHandle(shadow.getTargetId()).get());                \
+        return evalMerge(src, trg);                                                                       \
+    ESAC(Merge)
+
+        FOR_EACH(MERGE)
+#undef MERGE
+
+#define MERGE_LATTICE(Structure, Arity, AuxiliaryArity, ...)                                              \
+    CASE(MergeLattice, Structure, Arity, AuxiliaryArity)                                                  \
+        const auto& src = *static_cast<RelType*>(getRelationHandle(shadow.getSourceId()).get());          \
+        auto& trg = *static_cast<RelType*>(getRelationHandle(shadow.getTargetId()).get());                \
+        RelType* delta = nullptr;                                                                         \
+        if (shadow.getDeltaId()) {                                                                        \
+            delta = static_cast<RelType*>(getRelationHandle(*shadow.getDeltaId()).get());                 \
+        }                                                                                                 \
+        return evalMergeLattice(src, trg, delta, shadow, ctxt);                                           \
+    ESAC(MergeLattice)
+
+        FOR_EACH_LATTICE(MERGE_LATTICE)
+#undef MERGE_LATTICE
+
         CASE(MergeExtend)
             auto& src = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getSourceId()).get());
             auto& trg = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getTargetId()).get());
@@ -1483,9 +1629,8 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Swap)
 
         CASE(Assign)
-            const std::string& name = cur.getVariable().getName();
             const RamDomain val = execute(shadow.getRhs(), ctxt);
-            ctxt.setVariable(name, val);
+            ctxt.setVariable(shadow.getSlot(), val);
             return true;
         ESAC(Assign)
     }
@@ -1588,11 +1733,18 @@ RamDomain Engine::evalProvenanceExistenceCheck(const ProvenanceExistenceCheck& s
 
 template <typename Rel>
 RamDomain Engine::evalScan(const Rel& rel, const ram::Scan& cur, const Scan& shadow, Context& ctxt) {
-    for (const auto& tuple : rel.scan()) {
-        ctxt[cur.getTupleId()] = tuple.data();
-        if (!execute(shadow.getNestedOperation(), ctxt)) {
-            break;
+    auto scan = [&](const auto& range) {
+        for (const auto& tuple : range) {
+            ctxt[cur.getTupleId()] = tuple.data();
+            if (!execute(shadow.getNestedOperation(), ctxt)) {
+                break;
+            }
         }
+    };
+    if (ctxt.isSharedLoop(cur)) {
+        scan(ctxt.getShare(rel.scan()));
+    } else {
+        scan(rel.scan());
     }
     return true;
 }
@@ -1603,6 +1755,8 @@ RamDomain Engine::evalParallelScan(
     auto viewContext = shadow.getViewContext();
 
     auto pStream = rel.partitionScan(numOfThreads * 20);
+    const auto* sharedLoop = ram::getSharedLoop(cur);
+    WorkStealingScan<typename decltype(pStream)::value_type> scan(pStream, sharedLoop ? MAX_THREADS : 0);
 
     PARALLEL_START
         Context newCtxt(ctxt);
@@ -1610,15 +1764,13 @@ RamDomain Engine::evalParallelScan(
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-#if defined _OPENMP && _OPENMP < 200805
-        auto count = std::distance(pStream.begin(), pStream.end());
-        auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
-            auto it = b + i;
-#else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-#endif
-            for (const auto& tuple : *it) {
+        auto worker = scan.worker();
+        if (scan.isReplicated()) {
+            newCtxt.setSharedLoop(sharedLoop, worker.getTeamIndex(), worker.getTeamSize());
+        }
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                const auto& tuple = worker.get();
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (!execute(shadow.getNestedOperation(), newCtxt)) {
                     break;
@@ -1626,14 +1778,25 @@ RamDomain Engine::evalParallelScan(
             }
         }
     PARALLEL_END
+    reportImbalance(cur.getProfileText(), scan, ctxt);
     return true;
 }
 
+template <typename Scan>
+void Engine::reportImbalance(const std::string& profileText, const Scan& scan, const Context& ctxt) {
+    if (!profileEnabled || profileText.empty()) {
+        return;
+    }
+    // the scan is attributed to the rule of its atom frequency
+    std::string txt = "@parallel-imbalance" + profileText.substr(profileText.find(';'));
+    ProfileEventSingleton::instance().makeParallelImbalanceEvent(txt, scan.getNumWorkers(),
+            scan.getMaxBusyTime(), scan.getTotalBusyTime(), scan.getNumSplits(), ctxt.getIterationNumber());
+}
+
 template <typename Rel>
 RamDomain Engine::evalEstimateJoinSize(
         const Rel& rel, const ram::EstimateJoinSize& cur, const EstimateJoinSize& shadow, Context& ctxt) {
     (void)ctxt;
-    constexpr std::size_t Arity = Rel::Arity;
     bool onlyConstants = true;
 
     for (auto col : cur.getKeyColumns()) {
@@ -1678,39 +1841,21 @@ RamDomain Engine::evalEstimateJoinSize(
         keyConstants[inverseOrder[k]] = value;
     }
 
-    // ensure range is non-empty
+    // the key columns are the leading columns of the index
     auto* index = rel.getIndex(indexPos);
-    // initial values
-    double total = 0;
-    double duplicates = 0;
-
-    if (!index->scan().empty()) {
-        // assign first tuple as prev as a dummy
-        bool first = true;
-        Tuple<RamDomain, Arity> prev = *index->scan().begin();
-
-        for (const auto& tuple : index->scan()) {
-            // only if every constant matches do we consider the tuple
-            bool matchesConstants = std::all_of(keyConstants.begin(), keyConstants.end(),
-                    [tuple](const auto& p) { return tuple[p.first] == p.second; });
-            if (!matchesConstants) {
-                continue;
-            }
-            if (first) {
-                first = false;
-            } else {
-                // only if on every column do we have a match do we consider it a duplicate
-                bool matchesPrev = std::all_of(keyColumns.begin(), keyColumns.end(),
-                        [&prev, &tuple](std::size_t column) { return tuple[column] == prev[column]; });
-                if (matchesPrev) {
-                    ++duplicates;
+    double joinSize = evaluator::estimateJoinSize(
+            index->partitionScan(numOfThreads * 20), onlyConstants,
+            [&keyConstants](const auto& tuple) {
+                return std::all_of(keyConstants.begin(), keyConstants.end(),
+                        [&tuple](const auto& p) { return tuple[p.first] == p.second; });
+            },
+            [&keyColumns](const auto& tuple) {
+                uint64_t hash = 0;
+                for (std::size_t column : keyColumns) {
+                    hash = HyperLogLog<>::hash(hash, tuple[column]);
                 }
-            }
-            prev = tuple;
-            ++total;
-        }
-    }
-    double joinSize = (onlyConstants ? total : total / std::max(1.0, (total - duplicates)));
+                return hash;
+            });
 
     std::stringstream columnsStream;
     columnsStream << cur.getKeyColumns();
@@ -1734,7 +1879,7 @@ RamDomain Engine::evalEstimateJoinSize(
     if (cur.isRecursiveRelation()) {
         std::string txt =
                 "@recursive-estimate-join-size;" + cur.getRelation() + ";" + columns + ";" + constants;
-        ProfileEventSingleton::instance().makeRecursiveCountEvent(txt, joinSize, getIterationNumber());
+        ProfileEventSingleton::instance().makeRecursiveCountEvent(txt, joinSize, ctxt.getIterationNumber());
     } else {
         std::string txt =
                 "@non-recursive-estimate-join-size;" + cur.getRelation() + ";" + columns + ";" + constants;
@@ -1755,11 +1900,18 @@ RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shad
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(ctxt.getView(viewId));
     // conduct range query
-    for (const auto& tuple : view->range(low, high)) {
-        ctxt[cur.getTupleId()] = tuple.data();
-        if (!execute(shadow.getNestedOperation(), ctxt)) {
-            break;
+    auto scan = [&](const auto& range) {
+        for (const auto& tuple : range) {
+            ctxt[cur.getTupleId()] = tuple.data();
+            if (!execute(shadow.getNestedOperation(), ctxt)) {
+                break;
+            }
         }
+    };
+    if (ctxt.isSharedLoop(cur)) {
+        scan(ctxt.getShare(view->range(low, high)));
+    } else {
+        scan(view->range(low, high));
     }
     return true;
 }
@@ -1778,21 +1930,21 @@ RamDomain Engine::evalParallelIndexScan(
 
     std::size_t indexPos = shadow.getViewId();
     auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads * 20);
+    const auto* sharedLoop = ram::getSharedLoop(cur);
+    WorkStealingScan<typename decltype(pStream)::value_type> scan(pStream, sharedLoop ? MAX_THREADS : 0);
     PARALLEL_START
         Context newCtxt(ctxt);
         auto viewInfo = viewContext->getViewInfoForNested();
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-#if defined _OPENMP && _OPENMP < 200805
-        auto count = std::distance(pStream.begin(), pStream.end());
-        auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
-            auto it = b + i;
-#else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-#endif
-            for (const auto& tuple : *it) {
+        auto worker = scan.worker();
+        if (scan.isReplicated()) {
+            newCtxt.setSharedLoop(sharedLoop, worker.getTeamIndex(), worker.getTeamSize());
+        }
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                const auto& tuple = worker.get();
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (!execute(shadow.getNestedOperation(), newCtxt)) {
                     break;
@@ -1800,6 +1952,40 @@ RamDomain Engine::evalParallelIndexScan(
             }
         }
     PARALLEL_END
+    reportImbalance(cur.getProfileText(), scan, ctxt);
+    return true;
+}
+
+RamDomain Engine::evalLeapfrogJoin(const ram::LeapfrogJoin& cur, const LeapfrogJoin& shadow, Context& ctxt) {
+    const auto& parts = shadow.getParts();
+    const std::size_t numParts = parts.size();
+
+    // create pattern tuples for the range queries of the joined relations
+    std::vector<std::vector<RamDomain>> lows(numParts);
+    std::vector<std::vector<RamDomain>> highs(numParts);
+    for (std::size_t i = 0; i < numParts; ++i) {
+        const auto& superInfo = parts[i].superInst;
+        auto& low = lows[i];
+        auto& high = highs[i];
+        low.resize(superInfo.first.size());
+        high.resize(superInfo.second.size());
+        CAL_SEARCH_BOUND(superInfo, low, high);
+    }
+
+    auto seek = [&](std::size_t i, RamDomain value, RamDomain& found) {
+        const auto& part = parts[i];
+        lows[i][part.pos] = value;
+        return (*part.relHandle)
+                ->seek(ctxt.getView(part.viewId), lows[i].data(), highs[i].data(), part.pos, found);
+    };
+
+    RamDomain tuple[1];
+    ctxt[cur.getTupleId()] = tuple;
+    for (evaluator::Leapfrog join(numParts, seek); join.next(tuple[0]);) {
+        if (!execute(shadow.getNestedOperation(), ctxt)) {
+            break;
+        }
+    }
     return true;
 }
 
@@ -1823,21 +2009,21 @@ RamDomain Engine::evalParallelIfExists(
     auto viewContext = shadow.getViewContext();
 
     auto pStream = rel.partitionScan(numOfThreads * 20);
+    const auto* sharedLoop = ram::getSharedLoop(cur);
+    WorkStealingScan<typename decltype(pStream)::value_type> scan(pStream, sharedLoop ? MAX_THREADS : 0);
     auto viewInfo = viewContext->getViewInfoForNested();
     PARALLEL_START
         Context newCtxt(ctxt);
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-#if defined _OPENMP && _OPENMP < 200805
-        auto count = std::distance(pStream.begin(), pStream.end());
-        auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
-            auto it = b + i;
-#else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-#endif
-            for (const auto& tuple : *it) {
+        auto worker = scan.worker();
+        if (scan.isReplicated()) {
+            newCtxt.setSharedLoop(sharedLoop, worker.getTeamIndex(), worker.getTeamSize());
+        }
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                const auto& tuple = worker.get();
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (execute(shadow.getCondition(), newCtxt)) {
                     execute(shadow.getNestedOperation(), newCtxt);
@@ -1846,6 +2032,7 @@ RamDomain Engine::evalParallelIfExists(
             }
         }
     PARALLEL_END
+    reportImbalance(cur.getProfileText(), scan, ctxt);
     return true;
 }
 
@@ -1887,21 +2074,21 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
 
     std::size_t indexPos = shadow.getViewId();
     auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads * 20);
+    const auto* sharedLoop = ram::getSharedLoop(cur);
+    WorkStealingScan<typename decltype(pStream)::value_type> scan(pStream, sharedLoop ? MAX_THREADS : 0);
 
     PARALLEL_START
         Context newCtxt(ctxt);
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-#if defined _OPENMP && _OPENMP < 200805
-        auto count = std::distance(pStream.begin(), pStream.end());
-        auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
-            auto it = b + i;
-#else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-#endif
-            for (const auto& tuple : *it) {
+        auto worker = scan.worker();
+        if (scan.isReplicated()) {
+            newCtxt.setSharedLoop(sharedLoop, worker.getTeamIndex(), worker.getTeamSize());
+        }
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                const auto& tuple = worker.get();
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (execute(shadow.getCondition(), newCtxt)) {
                     execute(shadow.getNestedOperation(), newCtxt);
@@ -1910,6 +2097,7 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
             }
         }
     PARALLEL_END
+    reportImbalance(cur.getProfileText(), scan, ctxt);
 
     return true;
 }
@@ -2158,6 +2346,84 @@ RamDomain Engine::evalErase(Rel& rel, const Erase& shadow, Context& ctxt) {
     return true;
 }
 
+template <typename Rel>
+RamDomain Engine::evalMerge(const Rel& src, Rel& trg) {
+    // partitions yield tuples in the order of the main index of the source
+    const auto order = src.getIndexOrder(0);
+    auto pStream = src.partitionScan(numOfThreads * 20);
+
+    PARALLEL_START
+#if defined _OPENMP && _OPENMP < 200805
+        auto count = std::distance(pStream.begin(), pStream.end());
+        auto b = pStream.begin();
+        pfor(int i = 0; i < count; i++) {
+            auto it = b + i;
+#else
+        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+#endif
+            // each partition is sorted, such that hinted insertions mostly hit the last touched leaf
+            auto hints = trg.createHints();
+            for (const auto& tuple : *it) {
+                trg.insert(order.decode(tuple), hints);
+            }
+        }
+    PARALLEL_END
+    return true;
+}
+
+template <std::size_t Arity>
+RamDomain Engine::evalMerge(const Relation<Arity, 0, Bitmap>& src, Relation<Arity, 0, Bitmap>& trg) {
+    // bitmaps are merged set-at-a-time
+    static_cast<BitmapRelation<Arity>&>(trg).insertAll(static_cast<const BitmapRelation<Arity>&>(src));
+    return true;
+}
+
+template <typename Rel>
+RamDomain Engine::evalMergeLattice(
+        const Rel& src, Rel& trg, Rel* delta, const MergeLattice& shadow, Context& ctxt) {
+    using Tuple = typename Rel::Tuple;
+    constexpr std::size_t Arity = Rel::Arity;
+    constexpr std::size_t firstAuxiliary = Arity - Rel::AuxiliaryArity;
+
+    // partitions yield tuples in the order of the main index of the source
+    const auto order = src.getIndexOrder(0);
+    auto pStream = src.partitionScan(numOfThreads * 20);
+
+    PARALLEL_START
+        // the joins are evaluated on the stored tuple t0 and the inserted tuple t1
+        Context joinCtxt(ctxt);
+        auto join = [&](Tuple& stored, const Tuple& inserted) {
+            joinCtxt[0] = stored.data();
+            joinCtxt[1] = inserted.data();
+            Tuple joined = stored;
+            for (std::size_t i = firstAuxiliary; i < Arity; i++) {
+                joined[i] = execute(shadow.getChild(i - firstAuxiliary), joinCtxt);
+            }
+            if (joined == stored) {
+                return false;
+            }
+            stored = joined;
+            return true;
+        };
+#if defined _OPENMP && _OPENMP < 200805
+        auto count = std::distance(pStream.begin(), pStream.end());
+        auto b = pStream.begin();
+        pfor(int i = 0; i < count; i++) {
+            auto it = b + i;
+#else
+        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+#endif
+            for (const auto& tuple : *it) {
+                Tuple joined = order.decode(tuple);
+                if (trg.join(joined, join) && delta != nullptr) {
+                    delta->join(joined, join);
+                }
+            }
+        }
+    PARALLEL_END
+    return true;
+}
+
 template <typename Rel>
 RamDomain Engine::evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Context& ctxt) {
     if (!execute(shadow.getCondition(), ctxt)) {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Global.h"
+#include "interpreter/CompiledTier.h"
 #include "interpreter/Context.h"
 #include "interpreter/Generator.h"
 #include "interpreter/Index.h"
@@ -26,6 +27,7 @@
 #include "ram/analysis/Index.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
+#include "souffle/StratumPlugin.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/datastructure/ConcurrentCache.h"
 #include "souffle/datastructure/RecordTableImpl.h"
@@ -36,6 +38,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
 #include <vector>
@@ -62,6 +65,9 @@ public:
     /** @brief Execute the main program */
     void executeMain();
 
+    /** @brief Let a compiled tier take over the evaluation of the strata once it is ready */
+    void setCompiledTier(Own<CompiledTier> tier);
+
     /** @brief Execute the subroutine program */
     void executeSubroutine(
             const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret);
@@ -92,18 +98,16 @@ private:
     void* getMethodHandle(const std::string& method);
     /** @brief Load DLL */
     const std::vector<void*>& loadDLL();
-    /** @brief Return current iteration number for loop operation */
-    std::size_t getIterationNumber() const;
-    /** @brief Increase iteration number by one */
-    void incIterationNumber();
-    /** @brief Reset iteration number */
-    void resetIterationNumber();
+    /** @brief Load the plugins evaluating strata in place of the interpreter */
+    void loadPlugins();
     /** @brief Increment the counter */
     RamDomain incCounter();
     /** @brief Return the relation map. */
     VecOwn<RelationHandle>& getRelationMap();
     /** @brief Create and add relation into the runtime environment.  */
     void createRelation(const ram::Relation& id, const std::size_t idx);
+    /** @brief Hand the relations to the compiled tier if it is ready, return its program */
+    SouffleProgram* switchTier();
 
     // -- Defines template for specialized interpreter operation -- */
     template <typename Rel>
@@ -130,6 +134,8 @@ private:
     RamDomain evalParallelIndexScan(const Rel& rel, const ram::ParallelIndexScan& cur,
             const ParallelIndexScan& shadow, Context& ctxt);
 
+    RamDomain evalLeapfrogJoin(const ram::LeapfrogJoin& cur, const LeapfrogJoin& shadow, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalIfExists(const Rel& rel, const ram::IfExists& cur, const IfExists& shadow, Context& ctxt);
 
@@ -171,6 +177,20 @@ private:
     template <typename Rel>
     RamDomain evalErase(Rel& rel, const Erase& shadow, Context& ctxt);
 
+    template <typename Rel>
+    RamDomain evalMerge(const Rel& src, Rel& trg);
+
+    template <std::size_t Arity>
+    RamDomain evalMerge(const Relation<Arity, 0, Bitmap>& src, Relation<Arity, 0, Bitmap>& trg);
+
+    template <typename Rel>
+    RamDomain evalMergeLattice(
+            const Rel& src, Rel& trg, Rel* delta, const MergeLattice& shadow, Context& ctxt);
+
+    /** Record the time the threads of a parallel scan spent scanning in the profile */
+    template <typename Scan>
+    void reportImbalance(const std::string& profileText, const Scan& scan, const Context& ctxt);
+
     /** Program */
     ram::TranslationUnit& tUnit;
     /** Global */
@@ -182,12 +202,20 @@ private:
     std::map<std::string /*name*/, Own<Node>> subroutine;
     /** main program */
     Own<Node> main;
+    /** Number of tuple and variable slots in the frame of a context */
+    std::size_t frameSize = 0;
+    std::size_t numVariables = 0;
+    /** Generation of the IR for subroutines, which may be executed concurrently */
+    std::once_flag subroutineIR;
     /** Number of threads enabled for this program */
     std::size_t numOfThreads;
+    /** Compiled tier and its program once it took over the evaluation */
+    Own<CompiledTier> compiledTier;
+    SouffleProgram* compiled = nullptr;
+    /** Number of strata interpreted before the compiled tier took over */
+    std::size_t interpretedStrata = 0;
     /** Profile counter */
     std::atomic<RamDomain> counter{0};
-    /** Loop iteration counter */
-    std::size_t iteration = 0;
     /** Profile for rule frequencies */
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
@@ -204,6 +232,10 @@ private:
     SymbolTableImpl symbolTable;
     /** A cache for regexes */
     ConcurrentCache<std::string, std::regex> regexCache;
+    /** Stratum plugins, declared last to release them before the relations they access */
+    VecOwn<StratumPlugin> plugins;
+    /** Plugin evaluating each subroutine */
+    std::map<std::string /*name*/, StratumPlugin*> pluginStrata;
 };
 
 }  // namespace souffle::interpreter
@@ -36,12 +36,19 @@ NodePtr NodeGenerator::generateTree(const ram::Node& root) {
         if (isA<ram::Query>(&node)) {
             newQueryBlock();
         }
+        if (const auto* tupleOp = as<ram::TupleOperation>(node)) {
+            frameSize = std::max(frameSize, tupleOp->getTupleId() + 1);
+        } else if (const auto* tupleElement = as<ram::TupleElement>(node)) {
+            frameSize = std::max(frameSize, tupleElement->getTupleId() + 1);
+        }
         if (const auto* estimateJoinSize = as<ram::EstimateJoinSize>(node)) {
             encodeIndexPos(*estimateJoinSize);
             encodeView(estimateJoinSize);
         } else if (const auto* indexSearch = as<ram::IndexOperation>(node)) {
             encodeIndexPos(*indexSearch);
             encodeView(indexSearch);
+        } else if (const auto* join = as<ram::LeapfrogJoin>(node)) {
+            encodeLeapfrogJoin(*join);
         } else if (const auto* exists = as<ram::ExistenceCheck>(node)) {
             encodeIndexPos(*exists);
             encodeView(exists);
@@ -64,7 +71,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::NumericConstant>, const ram::Nu
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Variable>, const ram::Variable& var) {
-    return mk<Variable>(I_Variable, &var);
+    return mk<Variable>(I_Variable, &var, encodeVariable(var.getName()));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::TupleElement>, const ram::TupleElement& access) {
@@ -368,6 +375,62 @@ NodePtr NodeGenerator::visit_(
             visit_(type_identity<ram::TupleOperation>(), unpack));
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::LeapfrogJoin>, const ram::LeapfrogJoin& join) {
+    orderingContext.addNewTuple(join.getTupleId(), 1);
+    const auto& encodedParts = encodeLeapfrogJoin(join);
+    std::vector<LeapfrogJoin::Part> parts;
+    for (std::size_t i = 0; i < join.getNumParts(); ++i) {
+        auto [indexId, viewId] = encodedParts[i];
+        auto interpreterRel = encodeRelation(join.getRelation(i));
+        auto order = (*getRelationHandle(interpreterRel))->getIndexOrder(indexId);
+        const auto& pattern = join.getPattern(i);
+        std::size_t arity = pattern.size();
+        SuperInstruction superOp(arity);
+        std::size_t pos = arity;
+        for (std::size_t j = 0; j < arity; ++j) {
+            auto& child = pattern[order[j]];
+
+            // Joined column
+            if (order[j] == join.getColumn(i)) {
+                pos = j;
+            }
+
+            // Unbounded
+            if (isUndefValue(child)) {
+                superOp.first[j] = MIN_RAM_SIGNED;
+                superOp.second[j] = MAX_RAM_SIGNED;
+                continue;
+            }
+
+            // Constant
+            if (isA<ram::NumericConstant>(child)) {
+                superOp.first[j] = as<ram::NumericConstant>(child)->getConstant();
+                superOp.second[j] = superOp.first[j];
+                continue;
+            }
+
+            // TupleElement
+            if (isA<ram::TupleElement>(child)) {
+                auto tuple = as<ram::TupleElement>(child);
+                std::size_t tupleId = tuple->getTupleId();
+                std::size_t elementId = tuple->getElement();
+                std::size_t newElementId = orderingContext.mapOrder(tupleId, elementId);
+                superOp.tupleFirst.push_back({j, tupleId, newElementId});
+                superOp.tupleSecond.push_back({j, tupleId, newElementId});
+                continue;
+            }
+
+            // Generic expression
+            superOp.exprFirst.push_back(std::pair<std::size_t, Own<Node>>(j, dispatch(*child)));
+            superOp.exprSecond.push_back(std::pair<std::size_t, Own<Node>>(j, dispatch(*child)));
+        }
+        assert(pos < arity && "joined column not in index");
+        parts.push_back({getRelationHandle(interpreterRel), viewId, pos, std::move(superOp)});
+    }
+    return mk<LeapfrogJoin>(I_LeapfrogJoin, &join, std::move(parts),
+            visit_(type_identity<ram::TupleOperation>(), join));
+}
+
 NodePtr NodeGenerator::mkInit(const ram::AbstractAggregate& aggregate) {
     const ram::Aggregator& aggregator = aggregate.getAggregator();
     if (const auto* uda = as<ram::UserDefinedAggregator>(aggregator)) {
@@ -503,6 +566,14 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Erase>, const ram::Erase& erase
     return mk<Erase>(type, &erase, rel, std::move(superOp));
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Fork>, const ram::Fork& fork) {
+    NodePtrVec children;
+    for (const auto* branch : fork.getBranches()) {
+        children.push_back(dispatch(*branch));
+    }
+    return mk<Fork>(I_Fork, &fork, std::move(children));
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::SubroutineReturn>, const ram::SubroutineReturn& ret) {
     NodePtrVec children;
     for (const auto& value : ret.getValues()) {
@@ -623,6 +694,13 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
             viewContext->addViewInfoForNested(encodeRelation(rel), indexTable[&node], encodeView(&node));
         };
     });
+    visit(*next, [&](const ram::LeapfrogJoin& join) {
+        const auto& parts = encodeLeapfrogJoin(join);
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            viewContext->addViewInfoForNested(
+                    encodeRelation(join.getRelation(i)), parts[i].first, parts[i].second);
+        }
+    });
 
     viewContext->isParallel =
             visitExists(*next, [&](const Node& n) { return as<ram::AbstractParallel, AllowCrossCast>(n); });
@@ -632,6 +710,32 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
     return res;
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Merge>, const ram::Merge& merge) {
+    std::size_t src = encodeRelation(merge.getFirstRelation());
+    std::size_t target = encodeRelation(merge.getSecondRelation());
+    NodeType type = constructNodeType(global, "Merge", lookup(merge.getTargetRelation()));
+    return mk<Merge>(type, &merge, src, target);
+}
+
+NodePtr NodeGenerator::visit_(type_identity<ram::MergeLattice>, const ram::MergeLattice& merge) {
+    std::size_t src = encodeRelation(merge.getSourceRelation());
+    std::size_t target = encodeRelation(merge.getTargetRelation());
+    std::optional<std::size_t> delta;
+    if (merge.hasDeltaRelation()) {
+        delta = encodeRelation(merge.getDeltaRelation());
+    }
+    // the joins access the stored tuple t0 and the inserted tuple t1 in their natural order
+    const auto& rel = lookup(merge.getTargetRelation());
+    orderingContext.addNewTuple(0, rel.getArity());
+    orderingContext.addNewTuple(1, rel.getArity());
+    NodePtrVec joins;
+    for (const auto& join : merge.getJoins()) {
+        joins.push_back(dispatch(*join));
+    }
+    NodeType type = constructNodeType(global, "MergeLattice", rel);
+    return mk<MergeLattice>(type, &merge, src, target, delta, std::move(joins));
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) {
     std::size_t src = encodeRelation(extend.getFirstRelation());
     std::size_t target = encodeRelation(extend.getSecondRelation());
@@ -645,7 +749,8 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Swap>, const ram::Swap& swap) {
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Assign>, const ram::Assign& assign) {
-    return mk<Assign>(I_Assign, &assign, dispatch(assign.getVariable()), dispatch(assign.getValue()));
+    return mk<Assign>(I_Assign, &assign, dispatch(assign.getVariable()), dispatch(assign.getValue()),
+            encodeVariable(assign.getVariable().getName()));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::UndefValue>, const ram::UndefValue&) {
@@ -692,6 +797,21 @@ std::size_t NodeGenerator::encodeView(const ram::Node* node) {
     return id;
 }
 
+const std::vector<std::pair<std::size_t, std::size_t>>& NodeGenerator::encodeLeapfrogJoin(
+        const ram::LeapfrogJoin& join) {
+    auto pos = leapfrogTable.find(&join);
+    if (pos != leapfrogTable.end()) {
+        return pos->second;
+    }
+    auto& parts = leapfrogTable[&join];
+    for (std::size_t i = 0; i < join.getNumParts(); ++i) {
+        auto signature = engine.isa.getSearchSignature(&join, i);
+        auto indexId = engine.isa.getIndexSelection(join.getRelation(i)).getLexOrderNum(signature);
+        parts.emplace_back(indexId, getNextViewId());
+    }
+    return parts;
+}
+
 const ram::Relation& NodeGenerator::lookup(const std::string& relName) {
     auto it = relationMap.find(relName);
     assert(it != relationMap.end() && "relation not found");
@@ -714,6 +834,16 @@ std::size_t NodeGenerator::encodeRelation(const std::string& relName) {
     return id;
 }
 
+std::size_t NodeGenerator::encodeVariable(const std::string& name) {
+    auto pos = varTable.find(name);
+    if (pos != varTable.end()) {
+        return pos->second;
+    }
+    std::size_t slot = varTable.size();
+    varTable[name] = slot;
+    return slot;
+}
+
 RelationHandle* NodeGenerator::getRelationHandle(const std::size_t idx) {
     return engine.relations[idx].get();
 }
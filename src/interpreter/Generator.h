@@ -40,6 +40,7 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/Fork.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -48,11 +49,14 @@
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -126,6 +130,16 @@ public:
      */
     NodePtr generateTree(const ram::Node& root);
 
+    /** @brief Get the number of tuple slots of a context frame for the generated trees */
+    std::size_t getFrameSize() const {
+        return frameSize;
+    }
+
+    /** @brief Get the number of variable slots of a context frame for the generated trees */
+    std::size_t getNumVariables() const {
+        return varTable.size();
+    }
+
     NodePtr visit_(type_identity<ram::NumericConstant>, const ram::NumericConstant& num) override;
 
     NodePtr visit_(type_identity<ram::Variable>, const ram::Variable& var) override;
@@ -189,6 +203,8 @@ public:
 
     NodePtr visit_(type_identity<ram::UnpackRecord>, const ram::UnpackRecord& unpack) override;
 
+    NodePtr visit_(type_identity<ram::LeapfrogJoin>, const ram::LeapfrogJoin& join) override;
+
     NodePtr visit_(type_identity<ram::Aggregate>, const ram::Aggregate& aggregate) override;
 
     NodePtr visit_(type_identity<ram::ParallelAggregate>, const ram::ParallelAggregate& pAggregate) override;
@@ -208,6 +224,7 @@ public:
 
     NodePtr visit_(type_identity<ram::Erase>, const ram::Erase& erase) override;
 
+    NodePtr visit_(type_identity<ram::Fork>, const ram::Fork& fork) override;
     NodePtr visit_(type_identity<ram::SubroutineReturn>, const ram::SubroutineReturn& ret) override;
 
     NodePtr visit_(type_identity<ram::Sequence>, const ram::Sequence& seq) override;
@@ -237,6 +254,10 @@ public:
 
     NodePtr visit_(type_identity<ram::Query>, const ram::Query& query) override;
 
+    NodePtr visit_(type_identity<ram::Merge>, const ram::Merge& merge) override;
+
+    NodePtr visit_(type_identity<ram::MergeLattice>, const ram::MergeLattice& merge) override;
+
     NodePtr visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) override;
 
     NodePtr visit_(type_identity<ram::Swap>, const ram::Swap& swap) override;
@@ -305,6 +326,9 @@ private:
     /** @brief Encode and return the View id of an operation. */
     std::size_t encodeView(const ram::Node* node);
 
+    /** @brief Encode the index ids and View ids of the relations of a leapfrog join. */
+    const std::vector<std::pair<std::size_t, std::size_t>>& encodeLeapfrogJoin(const ram::LeapfrogJoin& join);
+
     /** @brief get arity of relation */
     const ram::Relation& lookup(const std::string& relName);
 
@@ -314,6 +338,9 @@ private:
     /** @brief Encode and create the relation, return the relation id */
     std::size_t encodeRelation(const std::string& relName);
 
+    /** @brief Encode a variable, return its slot in the frame of a context */
+    std::size_t encodeVariable(const std::string& name);
+
     /* @brief Get a relation instance from engine */
     RelationHandle* getRelationHandle(const std::size_t idx);
 
@@ -362,8 +389,14 @@ private:
     std::size_t relId = 0;
     /** Environment encoding, store a mapping from ram::Node to its View id. */
     std::unordered_map<const ram::Node*, std::size_t> viewTable;
+    /** Environment encoding, store a mapping from ram::LeapfrogJoin to the index and View ids of its parts */
+    std::unordered_map<const ram::Node*, std::vector<std::pair<std::size_t, std::size_t>>> leapfrogTable;
     /** Environment encoding, store a mapping from ram::Relation to its id */
     std::unordered_map<std::string, std::size_t> relTable;
+    /** Environment encoding, store a mapping from ram::Variable to its slot */
+    std::unordered_map<std::string, std::size_t> varTable;
+    /** Number of tuple slots, i.e. one more than the largest tuple id */
+    std::size_t frameSize = 0;
     /** name / relation mapping */
     std::unordered_map<std::string, const ram::Relation*> relationMap;
     /** ordering context */
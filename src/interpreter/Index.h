@@ -30,6 +30,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -139,6 +140,40 @@ struct ViewWrapper {
     virtual ~ViewWrapper() = default;
 };
 
+/**
+ * Obtains the elements of a data structure within the bounds [low, high].
+ */
+template <typename Data, typename Tuple, typename Hints>
+souffle::range<typename Data::iterator> boundedRange(
+        const Data& data, const Tuple& low, const Tuple& high, Hints& hints) {
+    return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
+}
+
+/**
+ * Tries only support searches binding a prefix of their levels, which are the
+ * leading columns on which the bounds agree.
+ */
+template <unsigned Levels = 0, typename Trie, typename Tuple, typename Hints>
+souffle::range<typename Trie::iterator> trieBoundaries(
+        const Trie& data, std::size_t prefix, const Tuple& entry, Hints& hints) {
+    if constexpr (Levels < std::tuple_size_v<Tuple>) {
+        if (prefix > Levels) {
+            return trieBoundaries<Levels + 1>(data, prefix, entry, hints);
+        }
+    }
+    return data.template getBoundaries<Levels>(entry, hints);
+}
+
+template <unsigned Dim, typename Levels, typename Tuple, typename Hints>
+souffle::range<typename Trie<Dim, Levels>::iterator> boundedRange(
+        const Trie<Dim, Levels>& data, const Tuple& low, const Tuple& high, Hints& hints) {
+    std::size_t prefix = 0;
+    while (prefix < Dim && low[prefix] == high[prefix]) {
+        prefix++;
+    }
+    return trieBoundaries(data, prefix, low, hints);
+}
+
 /**
  * An index is an abstraction of a data structure
  */
@@ -190,7 +225,7 @@ public:
             if (cmp(low, high) > 0) {
                 return {data.end(), data.end()};
             }
-            return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
+            return boundedRange(data, low, high, hints);
         }
     };
 
@@ -238,6 +273,33 @@ public:
         return data.insert(order.encode(tuple));
     }
 
+    /**
+     * Inserts a tuple into this index, exploiting the access pattern of the
+     * previous insertions with the same hints (not thread safe!).
+     */
+    bool insert(const Tuple& tuple, Hints& hints) {
+        return data.insert(order.encode(tuple), hints);
+    }
+
+    /**
+     * Inserts a tuple into this index, joining it in place with the tuple that
+     * has the same leading attributes. The join is applied to decoded tuples,
+     * updating the stored tuple and returning whether it changed.
+     */
+    template <typename Join>
+    bool insert(const Tuple& tuple, Join& join) {
+        auto update = [&](Tuple& stored, const Tuple& inserted) {
+            Tuple joined = order.decode(stored);
+            if (!join(joined, order.decode(inserted))) {
+                return false;
+            }
+            stored = order.encode(joined);
+            return true;
+        };
+        Hints hints;
+        return data.insert(order.encode(tuple), hints, update);
+    }
+
     /**
      * Inserts all elements of the given index.
      */
@@ -275,7 +337,8 @@ public:
         if (cmp(low, high) > 0) {
             return {data.end(), data.end()};
         }
-        return {data.lower_bound(low), data.upper_bound(high)};
+        Hints hints;
+        return boundedRange(data, low, high, hints);
     }
 
     /**
@@ -419,6 +482,13 @@ public:
         return data = true;
     }
 
+    // The nullary index does not require any hints.
+    struct Hints {};
+
+    bool insert(const Tuple& t, Hints& /* hints */) {
+        return insert(t);
+    }
+
     void insert(const Index& src) {
         data = src.data;
     }
@@ -480,6 +550,36 @@ public:
     }
 };
 
+/**
+ * A Bitmap index, merging with indexes of the same order set-at-a-time.
+ */
+template <std::size_t _Arity>
+class BitmapIndex : public interpreter::Index<_Arity, 0, Bitmap> {
+public:
+    using Index<_Arity, 0, Bitmap>::Index;
+    using Index<_Arity, 0, Bitmap>::data;
+
+    /**
+     * Inserts all tuples of the given index, which has the same order.
+     */
+    void insertAll(const BitmapIndex& src) {
+        data.insertAll(src.data);
+    }
+};
+
+/**
+ * The type of the indexes of a relation with the given structure.
+ */
+template <std::size_t Arity, std::size_t AuxiliaryArity, template <std::size_t, std::size_t> typename Structure>
+struct IndexType {
+    using type = Index<Arity, AuxiliaryArity, Structure>;
+};
+
+template <std::size_t Arity>
+struct IndexType<Arity, 0, Bitmap> {
+    using type = BitmapIndex<Arity>;
+};
+
 /**
  * A BtreeDelete index
  */
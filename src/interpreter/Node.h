@@ -37,6 +37,7 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <unordered_map>
@@ -88,6 +89,7 @@ struct RelationWrapper;
     FOR_EACH(Expand, IndexIfExists)\
     FOR_EACH(Expand, ParallelIndexIfExists)\
     Forward(UnpackRecord)\
+    Forward(LeapfrogJoin)\
     FOR_EACH(Expand, Aggregate)\
     FOR_EACH(Expand, ParallelAggregate)\
     FOR_EACH(Expand, IndexAggregate)\
@@ -97,6 +99,7 @@ struct RelationWrapper;
     FOR_EACH(Expand, GuardedInsert)\
     FOR_EACH(Expand, Insert)\
     FOR_EACH_BTREE_DELETE(Expand, Erase)\
+    Forward(Fork)\
     Forward(SubroutineReturn)\
     Forward(Sequence)\
     Forward(Parallel)\
@@ -111,7 +114,9 @@ struct RelationWrapper;
     Forward(LogSize)\
     Forward(IO)\
     Forward(Query)\
+    FOR_EACH(Expand, Merge)\
     Forward(MergeExtend)\
+    FOR_EACH_LATTICE(Expand, MergeLattice)\
     Forward(Swap)\
     Forward(Call)
 
@@ -157,6 +162,8 @@ inline NodeType constructNodeType(Global&, std::string tokBase, const ram::Relat
         return map.at("I_" + tokBase + "_Eqrel_" + arity + "_" + auxiliaryArity);
     } else if(rel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         return map.at("I_" + tokBase + "_BtreeDelete_" + arity + "_" + auxiliaryArity);
+    } else if(rel.getRepresentation() == RelationRepresentation::BITMAP) {
+        return map.at("I_" + tokBase + "_Bitmap_" + arity + "_" + auxiliaryArity);
     } else  {
         return map.at("I_" + tokBase + "_Btree_" + arity + "_" + auxiliaryArity);
     }
@@ -351,7 +358,7 @@ protected:
 /**
  * @class BinRelOperation
  * @brief  operation that involves with two relations should inherit from this class.
- *        E.g. Swap, MergeExtend
+ *        E.g. Swap, Merge, MergeExtend
  */
 class BinRelOperation {
 public:
@@ -432,7 +439,16 @@ class NumericConstant : public Node {
  * @class Variable
  */
 class Variable : public Node {
-    using Node::Node;
+public:
+    Variable(NodeType ty, const ram::Node* sdw, std::size_t slot) : Node(ty, sdw), slot(slot) {}
+
+    /** @brief Get the slot of the variable in the frame of a context */
+    std::size_t getSlot() const {
+        return slot;
+    }
+
+private:
+    std::size_t slot;
 };
 
 /**
@@ -751,6 +767,32 @@ protected:
     Own<Node> expr;
 };
 
+/**
+ * @class LeapfrogJoin
+ */
+class LeapfrogJoin : public Node, public NestedOperation {
+public:
+    using RelationHandle = Own<RelationWrapper>;
+
+    /** @brief A joined relation, seeked in the view on an index ordering the joined column at pos */
+    struct Part {
+        RelationHandle* relHandle;
+        std::size_t viewId;
+        std::size_t pos;
+        SuperInstruction superInst;
+    };
+
+    LeapfrogJoin(enum NodeType ty, const ram::Node* sdw, std::vector<Part> parts, Own<Node> nested)
+            : Node(ty, sdw), NestedOperation(std::move(nested)), parts(std::move(parts)) {}
+
+    inline const std::vector<Part>& getParts() const {
+        return parts;
+    }
+
+protected:
+    const std::vector<Part> parts;
+};
+
 /**
  * @class Aggregate
  */
@@ -852,6 +894,13 @@ public:
             : Insert(ty, sdw, relHandle, std::move(superInst)), ConditionalOperation(std::move(condition)) {}
 };
 
+/**
+ * @class Fork
+ */
+class Fork : public CompoundNode {
+    using CompoundNode::CompoundNode;
+};
+
 /**
  * @class SubroutineReturn
  */
@@ -870,7 +919,17 @@ class Sequence : public CompoundNode {
  * @class Assign
  */
 class Assign : public BinaryNode {
-    using BinaryNode::BinaryNode;
+public:
+    Assign(NodeType ty, const ram::Node* sdw, Own<Node> lhs, Own<Node> rhs, std::size_t slot)
+            : BinaryNode(ty, sdw, std::move(lhs), std::move(rhs)), slot(slot) {}
+
+    /** @brief Get the slot of the assigned variable in the frame of a context */
+    std::size_t getSlot() const {
+        return slot;
+    }
+
+private:
+    std::size_t slot;
 };
 
 /**
@@ -976,6 +1035,15 @@ class Query : public UnaryNode, public AbstractParallel {
     using UnaryNode::UnaryNode;
 };
 
+/**
+ * @class Merge
+ */
+class Merge : public Node, public BinRelOperation {
+public:
+    Merge(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target)
+            : Node(ty, sdw), BinRelOperation(src, target) {}
+};
+
 /**
  * @class MergeExtend
  */
@@ -985,6 +1053,24 @@ public:
             : Node(ty, sdw), BinRelOperation(src, target) {}
 };
 
+/**
+ * @class MergeLattice
+ */
+class MergeLattice : public CompoundNode, public BinRelOperation {
+public:
+    MergeLattice(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target,
+            std::optional<std::size_t> delta, VecOwn<Node> joins)
+            : CompoundNode(ty, sdw, std::move(joins)), BinRelOperation(src, target), delta(delta) {}
+
+    /** @brief get the delta relation, if the joined tuples whose value rose are collected */
+    inline std::optional<std::size_t> getDeltaId() const {
+        return delta;
+    }
+
+private:
+    const std::optional<std::size_t> delta;
+};
+
 /**
  * @class Swap
  */
@@ -24,6 +24,7 @@
 #include "ram/Program.h"
 #include "ram/Relation.h"
 #include "ram/TranslationUnit.h"
+#include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
@@ -49,8 +50,12 @@ class RelInterface : public souffle::Relation {
 public:
     RelInterface(RelationWrapper& r, SymbolTable& s, std::string n, std::vector<std::string> t,
             std::vector<std::string> an, std::size_t i)
+            : RelInterface(r, s, std::move(n), std::move(t), std::move(an), i, r.getAuxiliaryArity()) {}
+
+    RelInterface(RelationWrapper& r, SymbolTable& s, std::string n, std::vector<std::string> t,
+            std::vector<std::string> an, std::size_t i, arity_type aux)
             : relation(r), symTable(s), name(std::move(n)), types(std::move(t)), attrNames(std::move(an)),
-              id(i) {}
+              id(i), auxiliaryArity(aux) {}
     ~RelInterface() override = default;
 
     /** Insert tuple */
@@ -85,7 +90,7 @@ public:
 
     /** Get arity */
     arity_type getAuxiliaryArity() const override {
-        return relation.getAuxiliaryArity();
+        return auxiliaryArity;
     }
 
     /** Get symbol table */
@@ -197,6 +202,9 @@ private:
 
     /** Unique id for wrapper */
     std::size_t id;
+
+    /** Number of trailing attributes hidden from the interface */
+    arity_type auxiliaryArity;
 };
 
 /**
@@ -228,7 +236,8 @@ public:
             std::vector<std::string> types = rel.getAttributeTypes();
             std::vector<std::string> attrNames = rel.getAttributeNames();
 
-            auto* interface = new RelInterface(interpreterRel, symTable, rel.getName(), types, attrNames, id);
+            auto* interface = new RelInterface(interpreterRel, symTable, rel.getName(), types, attrNames, id,
+                    ram::getInterfaceAuxiliaryArity(rel));
             interfaces.push_back(interface);
             bool input = false;
             bool output = false;
@@ -20,7 +20,9 @@
 #include "ram/analysis/Index.h"
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
+#include "souffle/datastructure/HostRelation.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
@@ -37,82 +39,18 @@ namespace souffle::interpreter {
  * Wrapper for InterpreterRelation.
  *
  * This class unifies the InterpreterRelation template classes.
- * It also defines virtual interfaces for ProgInterface and some virtual helper functions for interpreter
- * execution.
+ * It implements the interface for ProgInterface and stratum plugins, and defines some virtual helper
+ * functions for interpreter execution.
  */
-struct RelationWrapper {
+struct RelationWrapper : public HostRelation {
     using arity_type = souffle::Relation::arity_type;
 
 public:
     RelationWrapper(arity_type arity, arity_type auxiliaryArity, std::string relName)
             : relName(std::move(relName)), arity(arity), auxiliaryArity(auxiliaryArity) {}
 
-    virtual ~RelationWrapper() = default;
-
-    // -- Define methods and interfaces for ProgInterface. --
+    // -- The interface for ProgInterface and stratum plugins is inherited from HostRelation. --
 public:
-    /**
-     * A virtualized iterator class that can be used by the Proginterface.
-     * Define behaviors to uniformly access the underlying tuple regardless its structure and arity.
-     */
-    class iterator_base {
-    public:
-        virtual ~iterator_base() = default;
-
-        virtual iterator_base& operator++() = 0;
-
-        virtual const RamDomain* operator*() = 0;
-
-        /*
-         * A clone method is required by ProgInterface.
-         */
-        virtual iterator_base* clone() const = 0;
-
-        virtual bool equal(const iterator_base& other) const = 0;
-    };
-
-    /**
-     * The iterator interface.
-     *
-     * Other class should use this iterator class to traverse the relation.
-     */
-    class Iterator {
-        Own<iterator_base> iter;
-
-    public:
-        Iterator(const Iterator& other) : iter(other.iter->clone()) {}
-        Iterator(iterator_base* iter) : iter(iter) {}
-
-        Iterator& operator++() {
-            ++(*iter);
-            return *this;
-        }
-
-        const RamDomain* operator*() {
-            return **iter;
-        }
-
-        bool operator==(const Iterator& other) const {
-            return iter->equal(*other.iter);
-        }
-
-        bool operator!=(const Iterator& other) const {
-            return !(*this == other);
-        }
-    };
-
-    virtual Iterator begin() const = 0;
-
-    virtual Iterator end() const = 0;
-
-    virtual void insert(const RamDomain*) = 0;
-
-    virtual bool contains(const RamDomain*) const = 0;
-
-    virtual std::size_t size() const = 0;
-
-    virtual void purge() = 0;
-
     const std::string& getName() const {
         return relName;
     }
@@ -143,6 +81,15 @@ public:
      */
     virtual IndexViewPtr createView(const std::size_t&) const = 0;
 
+    /**
+     * Seeks the first tuple within the bounds [low, high] of a view, and obtains its value at the given
+     * position of the index order. Returns false if there is no such tuple.
+     *
+     * This function is virtual as leapfrog joins intersect relations of different arities.
+     */
+    virtual bool seek(ViewWrapper* view, const RamDomain* low, const RamDomain* high, std::size_t pos,
+            RamDomain& value) const = 0;
+
 protected:
     std::string relName;
 
@@ -161,10 +108,11 @@ public:
     static constexpr std::size_t AuxiliaryArity = _AuxiliaryArity;
     using Attribute = std::size_t;
     using AttributeSet = std::set<Attribute>;
-    using Index = interpreter::Index<Arity, AuxiliaryArity, Structure>;
+    using Index = typename IndexType<Arity, AuxiliaryArity, Structure>::type;
     using Tuple = souffle::Tuple<RamDomain, Arity>;
     using View = typename Index::View;
     using iterator = typename Index::iterator;
+    using Hints = std::vector<typename Index::Hints>;
 
     /**
      * Construct a typed tuple from a raw data.
@@ -228,6 +176,16 @@ public:
         return mk<View>(indexes[indexPos]->createView());
     }
 
+    bool seek(ViewWrapper* view, const RamDomain* low, const RamDomain* high, std::size_t pos,
+            RamDomain& value) const override {
+        auto range = castView(view)->range(constructTuple(low), constructTuple(high));
+        if (range.empty()) {
+            return false;
+        }
+        value = (*range.begin())[pos];
+        return true;
+    }
+
     std::size_t size() const override {
         return __size();
     }
@@ -279,6 +237,24 @@ public:
         return Iterator(new iterator_base(main->end(), main->getOrder()));
     }
 
+    std::pair<Iterator, Iterator> lowerUpperRange(
+            std::size_t indexPos, const RamDomain* low, const RamDomain* high) const override {
+        const Order order = indexes[indexPos]->getOrder();
+        auto tuples = range(indexPos, order.encode(constructTuple(low)), order.encode(constructTuple(high)));
+        return {Iterator(new iterator_base(tuples.begin(), order)),
+                Iterator(new iterator_base(tuples.end(), order))};
+    }
+
+    std::vector<std::pair<Iterator, Iterator>> partition(std::size_t partitionCount) const override {
+        const Order order = main->getOrder();
+        std::vector<std::pair<Iterator, Iterator>> res;
+        for (const auto& tuples : partitionScan(partitionCount)) {
+            res.emplace_back(Iterator(new iterator_base(tuples.begin(), order)),
+                    Iterator(new iterator_base(tuples.end(), order)));
+        }
+        return res;
+    }
+
     // -----
     // Following section defines and implement interfaces for interpreter execution.
     //
@@ -299,6 +275,52 @@ public:
         return true;
     }
 
+    /**
+     * Creates the hints of a sequence of insertions into this relation, one
+     * per index (not thread safe!).
+     */
+    Hints createHints() const {
+        return Hints(indexes.size());
+    }
+
+    /**
+     * Add the given tuple to this relation, exploiting the access pattern of
+     * the previous insertions with the same hints.
+     */
+    bool insert(const Tuple& tuple, Hints& hints) {
+        if (!(main->insert(tuple, hints[0]))) {
+            return false;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insert(tuple, hints[i]);
+        }
+        return true;
+    }
+
+    /**
+     * Join the given tuple into this lattice relation, with the join of a
+     * stored tuple and an inserted tuple. The tuple becomes the joined tuple,
+     * and the result is whether the relation changed.
+     */
+    template <typename Join>
+    bool join(Tuple& tuple, Join& join) {
+        auto update = [&](Tuple& stored, const Tuple& inserted) {
+            if (!join(stored, inserted)) {
+                return false;
+            }
+            tuple = stored;
+            return true;
+        };
+        if (!(main->insert(tuple, update))) {
+            return false;
+        }
+        // the other indexes are joined as well, such that concurrent joins of the same tuple commute
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insert(tuple, join);
+        }
+        return true;
+    }
+
     /**
      * Add all entries of the given relation to this relation.
      */
@@ -371,7 +393,7 @@ public:
     /**
      * Check if the relation is empty
      */
-    bool empty() const {
+    bool empty() const override {
         return main->empty();
     }
 
@@ -446,6 +468,33 @@ public:
     }
 };
 
+template <std::size_t _Arity>
+class BitmapRelation : public Relation<_Arity, 0, Bitmap> {
+public:
+    using Relation<_Arity, 0, Bitmap>::Relation;
+    using Relation<_Arity, 0, Bitmap>::main;
+    using Relation<_Arity, 0, Bitmap>::indexes;
+
+    /**
+     * Insert all tuples of the given relation, merging indexes of the same
+     * order set-at-a-time.
+     */
+    void insertAll(const BitmapRelation& src) {
+        for (auto& trg : indexes) {
+            auto pos = std::find_if(src.indexes.begin(), src.indexes.end(),
+                    [&](const auto& srcIndex) { return srcIndex->getOrder() == trg->getOrder(); });
+            if (pos != src.indexes.end()) {
+                trg->insertAll(**pos);
+            } else {
+                const auto order = src.main->getOrder();
+                for (const auto& tuple : *src.main) {
+                    trg->insert(order.decode(tuple));
+                }
+            }
+        }
+    }
+};
+
 // The type of relation factory functions.
 using RelationFactory = Own<RelationWrapper> (*)(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
@@ -469,4 +518,8 @@ Own<RelationWrapper> createBrieRelation(
 // A factory for Eqrel index.
 Own<RelationWrapper> createEqrelRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for Bitmap index.
+Own<RelationWrapper> createBitmapRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 }  // namespace souffle::interpreter
@@ -19,6 +19,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/datastructure/BTree.h"
 #include "souffle/datastructure/BTreeDelete.h"
+#include "souffle/datastructure/Bitmap.h"
 #include "souffle/datastructure/Brie.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
 #include "souffle/utility/ContainerUtil.h"
@@ -51,6 +52,26 @@ namespace souffle::interpreter {
     func(Provenance, 21, 2, __VA_ARGS__)  \
     func(Provenance, 22, 2, __VA_ARGS__)
 
+// B-trees of lattice relations, mapping their leading attributes to their auxiliary attributes
+#define FOR_EACH_LATTICE(func, ...)\
+    func(Btree, 1, 1, __VA_ARGS__)  \
+    func(Btree, 2, 1, __VA_ARGS__)  \
+    func(Btree, 2, 2, __VA_ARGS__)  \
+    func(Btree, 3, 1, __VA_ARGS__)  \
+    func(Btree, 3, 2, __VA_ARGS__)  \
+    func(Btree, 4, 1, __VA_ARGS__)  \
+    func(Btree, 4, 2, __VA_ARGS__)  \
+    func(Btree, 5, 1, __VA_ARGS__)  \
+    func(Btree, 5, 2, __VA_ARGS__)  \
+    func(Btree, 6, 1, __VA_ARGS__)  \
+    func(Btree, 6, 2, __VA_ARGS__)  \
+    func(Btree, 7, 1, __VA_ARGS__)  \
+    func(Btree, 7, 2, __VA_ARGS__)  \
+    func(Btree, 8, 1, __VA_ARGS__)  \
+    func(Btree, 8, 2, __VA_ARGS__)  \
+    func(Btree, 9, 1, __VA_ARGS__)  \
+    func(Btree, 9, 2, __VA_ARGS__)
+
 #define FOR_EACH_BTREE(func, ...)\
     func(Btree, 0, 0, __VA_ARGS__) \
     func(Btree, 1, 0, __VA_ARGS__) \
@@ -73,23 +94,7 @@ namespace souffle::interpreter {
     func(Btree, 18, 0, __VA_ARGS__) \
     func(Btree, 19, 0, __VA_ARGS__) \
     func(Btree, 20, 0, __VA_ARGS__) \
-    func(Btree, 1, 1, __VA_ARGS__)  \
-    func(Btree, 2, 1, __VA_ARGS__)  \
-    func(Btree, 2, 2, __VA_ARGS__)  \
-    func(Btree, 3, 1, __VA_ARGS__)  \
-    func(Btree, 3, 2, __VA_ARGS__)  \
-    func(Btree, 4, 1, __VA_ARGS__)  \
-    func(Btree, 4, 2, __VA_ARGS__)  \
-    func(Btree, 5, 1, __VA_ARGS__)  \
-    func(Btree, 5, 2, __VA_ARGS__)  \
-    func(Btree, 6, 1, __VA_ARGS__)  \
-    func(Btree, 6, 2, __VA_ARGS__)  \
-    func(Btree, 7, 1, __VA_ARGS__)  \
-    func(Btree, 7, 2, __VA_ARGS__)  \
-    func(Btree, 8, 1, __VA_ARGS__)  \
-    func(Btree, 8, 2, __VA_ARGS__)  \
-    func(Btree, 9, 1, __VA_ARGS__)  \
-    func(Btree, 9, 2, __VA_ARGS__)
+    FOR_EACH_LATTICE(func, __VA_ARGS__)
 
 #define FOR_EACH_BTREE_DELETE(func, ...)\
     func(BtreeDelete, 1, 0, __VA_ARGS__) \
@@ -140,12 +145,17 @@ namespace souffle::interpreter {
 #define FOR_EACH_EQREL(func, ...)\
     func(Eqrel, 2, 0, __VA_ARGS__)
 
+#define FOR_EACH_BITMAP(func, ...)\
+    func(Bitmap, 1, 0, __VA_ARGS__) \
+    func(Bitmap, 2, 0, __VA_ARGS__)
+
 #define FOR_EACH(func, ...)                 \
     FOR_EACH_BTREE(func, __VA_ARGS__)       \
     FOR_EACH_BTREE_DELETE(func, __VA_ARGS__)\
     FOR_EACH_BRIE(func, __VA_ARGS__)        \
     FOR_EACH_PROVENANCE(func, __VA_ARGS__)  \
-    FOR_EACH_EQREL(func, __VA_ARGS__)
+    FOR_EACH_EQREL(func, __VA_ARGS__)       \
+    FOR_EACH_BITMAP(func, __VA_ARGS__)
 
 // clang-format on
 
@@ -161,6 +171,10 @@ struct comparator;
 
 template <unsigned First, unsigned... Rest>
 struct comparator<First, Rest...> {
+    // the order implemented by this comparator, for vectorised searches
+    static constexpr std::array<detail::lex_column, sizeof...(Rest) + 1> lex_order = {
+            {{First, detail::lex_kind::Signed}, {Rest, detail::lex_kind::Signed}...}};
+
     template <typename T>
     int operator()(const T& a, const T& b) const {
         return (a[First] < b[First]) ? -1 : ((a[First] > b[First]) ? 1 : comparator<Rest...>()(a, b));
@@ -303,4 +317,9 @@ using Provenance = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t
 template <std::size_t Arity, std::size_t AuxiliaryArity>
 using Eqrel = EquivalenceRelation<t_tuple<Arity>>;
 
+// Alias for Bitmap
+// Note: require Arity = 1 or 2.
+template <std::size_t Arity, std::size_t AuxiliaryArity>
+using Bitmap = souffle::Bitmap<Arity>;
+
 };  // namespace souffle::interpreter
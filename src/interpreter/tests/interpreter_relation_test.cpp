@@ -287,4 +287,84 @@ TEST(Reordering, Iteration) {
     }
 }
 
+TEST(Hints, Insertion) {
+    // create a binary relation with a second index of reversed order
+    SignatureOrderMap mapping;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {second};
+    OrderCollection orders = {{0, 1}, {1, 0}};
+    mapping.insert({second, orders[1]});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("test", indexSelection);
+    auto hints = rel.createHints();
+    for (RamDomain i = 0; i < 1000; i++) {
+        EXPECT_TRUE(rel.insert({i / 10, i % 10}, hints));
+    }
+    EXPECT_FALSE(rel.insert({5, 5}, hints));
+    EXPECT_EQ(1000, rel.size());
+
+    // both indexes hold every tuple
+    std::size_t count = 0;
+    for (const auto& t : rel.getIndex(1)->range({7, MIN_RAM_SIGNED}, {7, MAX_RAM_SIGNED})) {
+        EXPECT_EQ(7, t[0]);
+        count++;
+    }
+    EXPECT_EQ(100, count);
+}
+
+TEST(Bitmap, Range) {
+    // create a binary bitmap relation, searchable on either column
+    SignatureOrderMap mapping;
+    SearchSignature first(2);
+    first[0] = AttributeConstraint::Equal;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {first, second};
+    OrderCollection orders = {{0, 1}, {1, 0}};
+    mapping.insert({first, orders[0]});
+    mapping.insert({second, orders[1]});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    BitmapRelation<2> rel("test", indexSelection);
+    for (RamDomain i = -5; i < 5; i++) {
+        rel.insert({i, i * i});
+        rel.insert({i, -i});
+    }
+    EXPECT_EQ(18, rel.size());
+
+    // prefix searches on the first column
+    for (RamDomain i = -5; i < 5; i++) {
+        std::size_t count = 0;
+        for (const auto& t : rel.getIndex(0)->range({i, MIN_RAM_SIGNED}, {i, MAX_RAM_SIGNED})) {
+            EXPECT_EQ(i, t[0]);
+            EXPECT_TRUE(t[1] == i * i || t[1] == -i);
+            count++;
+        }
+        EXPECT_EQ(i == 0 || i == -1 ? 1 : 2, count);
+    }
+
+    // prefix searches on the second column, tuples are encoded in the order of the index
+    std::size_t count = 0;
+    for (const auto& t : rel.getIndex(1)->range({4, MIN_RAM_SIGNED}, {4, MAX_RAM_SIGNED})) {
+        EXPECT_EQ(4, t[0]);
+        EXPECT_TRUE(t[1] == 2 || t[1] == -2 || t[1] == -4);
+        count++;
+    }
+    EXPECT_EQ(3, count);
+
+    // existence checks
+    EXPECT_TRUE(rel.getIndex(0)->contains({-3, 9}, {-3, 9}));
+    EXPECT_FALSE(rel.getIndex(0)->contains({-3, -9}, {-3, -9}));
+
+    // set-at-a-time union of relations with the same indexes
+    BitmapRelation<2> other("other", indexSelection);
+    other.insert({7, 7});
+    other.insert({-3, 9});
+    rel.insertAll(other);
+    EXPECT_EQ(19, rel.size());
+    EXPECT_TRUE(rel.getIndex(1)->contains({7, 7}, {7, 7}));
+}
+
 }  // namespace souffle::interpreter::test
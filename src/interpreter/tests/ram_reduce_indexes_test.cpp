@@ -0,0 +1,158 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_reduce_indexes_test.cpp
+ *
+ * Tests the index budget of the ReduceIndexesTransformer, evaluating the
+ * reduced program by the Interpreter.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "ram/Expression.h"
+#include "ram/IO.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/analysis/Index.h"
+#include "ram/transform/ReduceIndexes.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/json11.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::test {
+
+using interpreter::Engine;
+using json11::Json;
+
+/** Writes a profile of a run in which edge holds the given number of tuples */
+std::string writeProfile(long long numTuples) {
+    Json profile = Json::object{{"root",
+            Json::object{{"program",
+                    Json::object{{"relation",
+                            Json::object{{"edge", Json::object{{"num-tuples", numTuples}}}}}}}}}};
+    auto path = std::filesystem::temp_directory_path() / "ram_reduce_indexes_test.json";
+    std::ofstream(path) << profile.dump();
+    return path.string();
+}
+
+/** Scans edge and searches it again on the given column of the first tuple */
+Own<Statement> makeJoin(const std::string& out, std::size_t from, std::size_t to) {
+    RamPattern pattern;
+    for (std::size_t i = 0; i < 2; ++i) {
+        pattern.first.push_back(i == to ? Own<Expression>(mk<TupleElement>(0, from)) : mk<UndefValue>());
+        pattern.second.push_back(i == to ? Own<Expression>(mk<TupleElement>(0, from)) : mk<UndefValue>());
+    }
+    VecOwn<Expression> values;
+    values.push_back(mk<TupleElement>(0, 1 - from));
+    values.push_back(mk<TupleElement>(1, 1 - to));
+    return mk<Query>(mk<Scan>("edge", 0,
+            mk<IndexScan>("edge", 1, std::move(pattern), mk<Insert>(out, std::move(values)))));
+}
+
+Own<Program> makeProgram() {
+    VecOwn<Relation> rels;
+    VecOwn<Statement> stmts;
+    for (const std::string name : {"edge", "forward", "backward"}) {
+        rels.push_back(
+                mk<Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                        std::vector<std::string>{"i", "i"}, RelationRepresentation::BTREE));
+    }
+
+    for (RamDomain i = 0; i < 10; ++i) {
+        VecOwn<Expression> values;
+        values.push_back(mk<SignedConstant>(i));
+        values.push_back(mk<SignedConstant>((i * 3) % 10));
+        stmts.push_back(mk<Query>(mk<Insert>("edge", std::move(values))));
+    }
+
+    // the searches on the first and on the second column of edge need an index each
+    stmts.push_back(makeJoin("forward", 1, 0));
+    stmts.push_back(makeJoin("backward", 0, 1));
+
+    Json types = Json::object{{"relation", Json::object{{"arity", 2LL}, {"types", Json::array{"i", "i"}}}}};
+    for (const std::string name : {"forward", "backward"}) {
+        std::map<std::string, std::string> dirs = {{"operation", "output"}, {"IO", "stdout"},
+                {"attributeNames", "x\ty"}, {"name", name}, {"auxArity", "0"}, {"types", types.dump()}};
+        stmts.push_back(mk<IO>(name, dirs));
+    }
+
+    std::map<std::string, Own<Statement>> subs;
+    return mk<Program>(std::move(rels), mk<Sequence>(std::move(stmts)), std::move(subs));
+}
+
+/** Evaluates the program after reducing its indexes to the budget, returns the output and index count */
+std::pair<std::string, std::size_t> evaluateWithBudget(const std::string& budget) {
+    Global glb;
+    glb.config().set("jobs", "1");
+    glb.config().set("index-budget", budget);
+    glb.config().set("auto-schedule", writeProfile(1000000));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, makeProgram(), errReport, debugReport);
+
+    transform::ReduceIndexesTransformer().apply(translationUnit);
+    auto& idxAnalysis = translationUnit.getAnalysis<analysis::IndexAnalysis>();
+    std::size_t numIndexes = idxAnalysis.getIndexSelection("edge").getAllOrders().size();
+
+    Own<Engine> interpreter = mk<Engine>(translationUnit, 1);
+
+    std::streambuf* oldCoutStreambuf = std::cout.rdbuf();
+    std::ostringstream sout;
+    std::cout.rdbuf(sout.rdbuf());
+
+    interpreter->executeMain();
+
+    std::cout.rdbuf(oldCoutStreambuf);
+
+    return {sout.str(), numIndexes};
+}
+
+TEST(ReduceIndexes, WithinBudget) {
+    // the indexes of edge take about 8MB
+    auto full = evaluateWithBudget("100");
+    EXPECT_EQ(full.second, 2);
+    EXPECT_FALSE(full.first.empty());
+}
+
+TEST(ReduceIndexes, ExceedsBudget) {
+    auto full = evaluateWithBudget("100");
+    auto reduced = evaluateWithBudget("0");
+    EXPECT_EQ(full.second, 2);
+    EXPECT_EQ(reduced.second, 1);
+    EXPECT_EQ(full.first, reduced.first);
+}
+
+}  // namespace souffle::ram::test
@@ -111,6 +111,10 @@ public:
 
     bool trace_scanning = false;
 
+    // Whether the tags of a relation declaration are scanned, where `bitmap`
+    // is a qualifier rather than an identifier.
+    bool scanningRelationTags = false;
+
     // Canonical path and line number of location that have already been
     // visited by `.once`.
     std::set<std::pair<std::filesystem::path, int>> VisitedOnceLocations;
@@ -144,6 +144,7 @@
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token BTREE_DELETE_QUALIFIER    "BTREE_DELETE datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token BITMAP_QUALIFIER          "BITMAP datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token NO_INLINE_QUALIFIER       "relation qualifier no_inline"
@@ -588,6 +589,7 @@ lattice_operator
 relation_decl
   : DECL relation_names attributes_list relation_tags dependency_list
     {
+      driver.scanningRelationTags = false;
       auto tags = $relation_tags;
       auto attributes_list = $attributes_list;
       $$ = $relation_names;
@@ -609,6 +611,7 @@ relation_decl
     }
   | DECL IDENT[delta] EQUALS DEBUG_DELTA LPAREN IDENT[name] RPAREN relation_tags
     {
+      driver.scanningRelationTags = false;
       auto tags = $relation_tags;
       $$.push_back(mk<ast::Relation>(driver.mkQN($delta), @2));
       for (auto&& rel : $$) {
@@ -686,7 +689,9 @@ attribute
  */
 relation_tags
   : %empty
-    { }
+    {
+      driver.scanningRelationTags = true;
+    }
   | relation_tags OVERRIDABLE_QUALIFIER
     {
       $$ = driver.addTag(RelationTag::OVERRIDABLE, @2, $1);
@@ -723,6 +728,10 @@ relation_tags
     {
       $$ = driver.addReprTag(RelationTag::EQREL, @2, $1);
     }
+  | relation_tags BITMAP_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::BITMAP, @2, $1);
+    }
   /* Deprecated Qualifiers */
   | relation_tags OUTPUT_QUALIFIER
     {
@@ -199,6 +199,14 @@ WS [ \t\r\v\f]
 "magic"                               { return yy::parser::make_MAGIC_QUALIFIER(yylloc); }
 "no_magic"                            { return yy::parser::make_NO_MAGIC_QUALIFIER(yylloc); }
 "brie"                                { return yy::parser::make_BRIE_QUALIFIER(yylloc); }
+"bitmap"/({WS}*"("|".")              { return yy::parser::make_IDENT(yytext, yylloc); }
+"bitmap"                              {
+                                        // only a qualifier among the tags of a relation declaration
+                                        if (driver.scanningRelationTags) {
+                                          return yy::parser::make_BITMAP_QUALIFIER(yylloc);
+                                        }
+                                        return yy::parser::make_IDENT(yytext, yylloc);
+                                      }
 "btree_delete"                        { return yy::parser::make_BTREE_DELETE_QUALIFIER(yylloc); }
 "btree"                               { return yy::parser::make_BTREE_QUALIFIER(yylloc); }
 "min"                                 { return yy::parser::make_MIN(yylloc); }
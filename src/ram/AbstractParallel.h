@@ -14,6 +14,27 @@
 
 #pragma once
 
+#include "ram/AbstractAggregate.h"
+#include "ram/Aggregate.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Break.h"
+#include "ram/Filter.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexScan.h"
+#include "ram/NestedIntrinsicOperator.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/RelationOperation.h"
+#include "ram/Scan.h"
+#include "ram/TupleOperation.h"
+#include "ram/UnpackRecord.h"
+#include "ram/UserDefinedAggregator.h"
+#include "ram/UserDefinedOperator.h"
+#include "souffle/utility/MiscUtil.h"
+
 namespace souffle::ram {
 
 /**
@@ -22,4 +43,64 @@ namespace souffle::ram {
  */
 class AbstractParallel {};
 
+/**
+ * @brief Check whether a node, apart from the given nested operation, has side-effects
+ *
+ * Auto-increments and stateful functors or aggregators change their state on
+ * each evaluation, hence they must not be repeated by each thread of a team.
+ */
+inline bool hasSideEffects(const Node& node, const Node* nested = nullptr) {
+    if (isA<AutoIncrement>(node)) {
+        return true;
+    }
+    if (const auto* op = as<UserDefinedOperator>(node); op != nullptr && op->isStateful()) {
+        return true;
+    }
+    if (const auto* aggregate = dynamic_cast<const AbstractAggregate*>(&node)) {
+        const auto* uda = as<UserDefinedAggregator>(aggregate->getAggregator());
+        if (uda != nullptr && uda->isStateful()) {
+            return true;
+        }
+    }
+    for (const Node& child : node.getChildNodes()) {
+        if (&child != nested && hasSideEffects(child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Get the loop shared among the threads if a parallel loop is replicated
+ *
+ * A parallel loop over fewer tuples than threads leaves most threads idle.
+ * Instead, each thread may run the whole parallel loop and scan its share of
+ * the first nested loop. The operations in between must be deterministic, such
+ * that all threads agree on the tuples of the shared loop, and must not have
+ * side-effects, which would be repeated by each thread.
+ *
+ * @param loop Outer-most parallel loop
+ * @return First nested scan or index scan, or nullptr if there is none or the
+ * operations up to it have side-effects
+ */
+inline const RelationOperation* getSharedLoop(const TupleOperation& loop) {
+    const Operation* op = &loop.getOperation();
+    while (true) {
+        const auto* nested = as<NestedOperation>(op);
+        // the operations up to the shared loop, including its search, are repeated by each thread
+        if (nested == nullptr || hasSideEffects(*op, &nested->getOperation())) {
+            return nullptr;
+        }
+        if (isA<Scan>(op) || isA<IndexScan>(op)) {
+            return as<RelationOperation>(op);
+        }
+        if (!isA<Filter>(op) && !isA<Break>(op) && !isA<UnpackRecord>(op) && !isA<IfExists>(op) &&
+                !isA<IndexIfExists>(op) && !isA<Aggregate>(op) && !isA<IndexAggregate>(op) &&
+                !isA<NestedIntrinsicOperator>(op)) {
+            return nullptr;
+        }
+        op = &nested->getOperation();
+    }
+}
+
 }  // namespace souffle::ram
@@ -0,0 +1,106 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Fork.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <iosfwd>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class Fork
+ * @brief Sequence of operations over the same enclosing tuples
+ *
+ * Executes each branch in turn for the tuples bound by the enclosing
+ * operations, such that a loop-nest shared by several rules is evaluated
+ * only once.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * QUERY
+ *  FOR t0 IN A
+ *   FORK
+ *    BRANCH
+ *     FOR t1 IN B ON INDEX t1.0 = t0.1
+ *      ...
+ *    BRANCH
+ *     FOR t2 IN C ON INDEX t2.0 = t0.1
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class Fork : public Operation {
+public:
+    Fork(VecOwn<Operation> branches) : Operation(NK_Fork), branches(std::move(branches)) {
+        assert(allValidPtrs(this->branches));
+        assert(this->branches.size() >= 2 && "fork requires at least two branches");
+    }
+
+    /** @brief Get branches */
+    std::vector<Operation*> getBranches() const {
+        return toPtrVector(branches);
+    }
+
+    /** @brief Append a branch */
+    void addBranch(Own<Operation> branch) {
+        assert(branch != nullptr);
+        branches.push_back(std::move(branch));
+    }
+
+    Fork* cloning() const override {
+        return new Fork(clone(branches));
+    }
+
+    void apply(const NodeMapper& map) override {
+        for (auto& branch : branches) {
+            branch = map(std::move(branch));
+        }
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_Fork;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos) << "FORK" << std::endl;
+        for (const auto& branch : branches) {
+            os << times(" ", tabpos + 1) << "BRANCH" << std::endl;
+            Operation::print(branch.get(), os, tabpos + 2);
+        }
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<Fork>(node);
+        return equal_targets(branches, other.branches);
+    }
+
+    NodeVec getChildren() const override {
+        return toPtrVector<Node const>(branches);
+    }
+
+    /** Branches */
+    VecOwn<Operation> branches;
+};
+
+}  // namespace souffle::ram
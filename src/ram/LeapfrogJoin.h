@@ -0,0 +1,163 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LeapfrogJoin.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Expression.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/TupleOperation.h"
+#include "ram/utility/Utils.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class LeapfrogJoin
+ * @brief Intersection of the values of a column over several relations
+ *
+ * Binds a unary tuple to each value occurring in the joined column of every
+ * relation, among the tuples matching the pattern of the relation. The
+ * pattern binds a prefix of the columns of an index, such that the joined
+ * column is ordered next and the values of all relations are intersected by
+ * leapfrogging, i.e. seeking each relation to the largest value found so far.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * FOR t2.0 IN LEAPFROG edge(t0.1,_) ON 1, edge(t0.0,_) ON 1
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class LeapfrogJoin : public TupleOperation {
+public:
+    LeapfrogJoin(std::size_t ident, std::vector<std::string> relations, std::vector<std::size_t> columns,
+            std::vector<VecOwn<Expression>> patterns, Own<Operation> nested, std::string profileText = "")
+            : TupleOperation(NK_LeapfrogJoin, ident, std::move(nested), std::move(profileText)),
+              relations(std::move(relations)), columns(std::move(columns)), patterns(std::move(patterns)) {
+        assert(this->relations.size() == this->columns.size() && "column mismatch");
+        assert(this->relations.size() == this->patterns.size() && "pattern mismatch");
+        assert(this->relations.size() >= 2 && "at least two relations must be joined");
+        for (const auto& pattern : this->patterns) {
+            assert(allValidPtrs(pattern));
+        }
+    }
+
+    /** @brief Get number of joined relations */
+    std::size_t getNumParts() const {
+        return relations.size();
+    }
+
+    /** @brief Get name of the i-th joined relation */
+    const std::string& getRelation(std::size_t i) const {
+        return relations.at(i);
+    }
+
+    /** @brief Get the joined column of the i-th relation */
+    std::size_t getColumn(std::size_t i) const {
+        return columns.at(i);
+    }
+
+    /** @brief Get pattern of the i-th relation, the joined column is undefined */
+    std::vector<Expression*> getPattern(std::size_t i) const {
+        return toPtrVector(patterns.at(i));
+    }
+
+    void apply(const NodeMapper& map) override {
+        TupleOperation::apply(map);
+        for (auto& pattern : patterns) {
+            for (auto& value : pattern) {
+                value = map(std::move(value));
+            }
+        }
+    }
+
+    LeapfrogJoin* cloning() const override {
+        std::vector<VecOwn<Expression>> resPatterns;
+        for (const auto& pattern : patterns) {
+            resPatterns.push_back(clone(pattern));
+        }
+        return new LeapfrogJoin(getTupleId(), relations, columns, std::move(resPatterns),
+                clone(getOperation()), getProfileText());
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_LeapfrogJoin;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos) << "FOR t" << getTupleId() << ".0 IN LEAPFROG ";
+        for (std::size_t i = 0; i < relations.size(); ++i) {
+            if (i > 0) {
+                os << ", ";
+            }
+            os << relations[i] << "(";
+            os << join(patterns[i], ",", [](std::ostream& out, const Own<Expression>& value) {
+                if (isUndefValue(value.get())) {
+                    out << "_";
+                } else {
+                    out << *value;
+                }
+            });
+            os << ") ON " << columns[i];
+        }
+        os << "\n";
+        NestedOperation::print(os, tabpos + 1);
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<LeapfrogJoin>(node);
+        if (!TupleOperation::equal(other) || relations != other.relations || columns != other.columns ||
+                patterns.size() != other.patterns.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < patterns.size(); ++i) {
+            if (!equal_targets(patterns[i], other.patterns[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    NodeVec getChildren() const override {
+        auto res = TupleOperation::getChildren();
+        for (const auto& pattern : patterns) {
+            for (const auto& value : pattern) {
+                res.push_back(value.get());
+            }
+        }
+        return res;
+    }
+
+    /** Joined relations */
+    const std::vector<std::string> relations;
+
+    /** Joined column per relation */
+    const std::vector<std::size_t> columns;
+
+    /** Values of the bound columns per relation */
+    std::vector<VecOwn<Expression>> patterns;
+};
+
+}  // namespace souffle::ram
@@ -0,0 +1,135 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MergeLattice.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Expression.h"
+#include "ram/Node.h"
+#include "ram/Statement.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class MergeLattice
+ * @brief Join all tuples of a relation into a lattice relation
+ *
+ * The lattice relation maps the leading attributes of its tuples to the values
+ * of its auxiliary attributes. Each tuple of the source relation is joined in
+ * place with the tuple of the target relation that has the same leading
+ * attributes, or inserted if there is none. In recursive strata, the joined
+ * tuple is also joined into the delta relation if it was inserted or its value
+ * rose.
+ *
+ * The joins of the auxiliary attributes are expressions over the stored tuple
+ * t0 and the inserted tuple t1. The source relation is partitioned and the
+ * partitions are joined into the target relation concurrently.
+ *
+ * The following example joins @new_A into A, with the joined tuples in @delta_A:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * MERGE-LATTICE A WITH @new_A INTO @delta_A USING (@lub(t0.1, t1.1))
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class MergeLattice : public Statement {
+public:
+    MergeLattice(std::string tRef, std::string sRef, VecOwn<Expression> joins)
+            : MergeLattice(std::move(tRef), std::move(sRef), "", std::move(joins)) {}
+
+    MergeLattice(std::string tRef, std::string sRef, std::string dRef, VecOwn<Expression> joins)
+            : Statement(NK_MergeLattice), target(std::move(tRef)), source(std::move(sRef)),
+              delta(std::move(dRef)), joins(std::move(joins)) {
+        assert(allValidPtrs(this->joins));
+    }
+
+    /** @brief Get target relation */
+    const std::string& getTargetRelation() const {
+        return target;
+    }
+
+    /** @brief Get source relation */
+    const std::string& getSourceRelation() const {
+        return source;
+    }
+
+    /** @brief Whether the joined tuples whose value rose are collected in a delta relation */
+    bool hasDeltaRelation() const {
+        return !delta.empty();
+    }
+
+    /** @brief Get delta relation */
+    const std::string& getDeltaRelation() const {
+        assert(hasDeltaRelation() && "merge has no delta relation");
+        return delta;
+    }
+
+    /** @brief Get the joins of the auxiliary attributes */
+    std::vector<Expression*> getJoins() const {
+        return toPtrVector(joins);
+    }
+
+    MergeLattice* cloning() const override {
+        return new MergeLattice(target, source, delta, clone(joins));
+    }
+
+    void apply(const NodeMapper& map) override {
+        for (auto& join : joins) {
+            join = map(std::move(join));
+        }
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_MergeLattice;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "MERGE-LATTICE " << target << " WITH " << source;
+        if (hasDeltaRelation()) {
+            os << " INTO " << delta;
+        }
+        os << " USING (" << join(joins, ", ", print_deref<Own<Expression>>()) << ")" << std::endl;
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<MergeLattice>(node);
+        return target == other.target && source == other.source && delta == other.delta &&
+               equal_targets(joins, other.joins);
+    }
+
+    NodeVec getChildren() const override {
+        return toPtrVector<Node const>(joins);
+    }
+
+    /** Lattice relation */
+    const std::string target;
+
+    /** Joined relation */
+    const std::string source;
+
+    /** Relation of the tuples whose value rose, or empty if there is none */
+    const std::string delta;
+
+    /** Joins of the auxiliary attributes */
+    VecOwn<Expression> joins;
+};
+
+}  // namespace souffle::ram
@@ -117,6 +117,7 @@ public:
 
         NK_Operation,
             NK_Erase,
+            NK_Fork,
             NK_Insert,
                 NK_GuardedInsert,
             NK_LastInsert,
@@ -157,6 +158,7 @@ public:
 
                     NK_LastRelationOperation,
 
+                    NK_LeapfrogJoin,
                     NK_UnpackRecord,
                     NK_NestedIntrinsicOperator,
                 NK_LastTupleOperation,
@@ -173,6 +175,7 @@ public:
             NK_Assign,
 
             NK_BinRelationStatement,
+                NK_Merge,
                 NK_MergeExtend,
                 NK_Swap,
             NK_LastBinRelationStatement,
@@ -187,6 +190,7 @@ public:
 
             NK_LogTimer,
             NK_Loop,
+            NK_MergeLattice,
             NK_Query,
             NK_RelationStatement,
                 NK_Clear,
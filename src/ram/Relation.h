@@ -38,12 +38,15 @@ class Relation : public Node {
 public:
     Relation(std::string name, std::size_t arity, std::size_t auxiliaryArity,
             std::vector<std::string> attributeNames, std::vector<std::string> attributeTypes,
-            RelationRepresentation representation)
+            RelationRepresentation representation, std::vector<std::size_t> attributeDomainSizes = {})
             : Node(NK_Relation), representation(representation), name(std::move(name)), arity(arity),
               auxiliaryArity(auxiliaryArity), attributeNames(std::move(attributeNames)),
-              attributeTypes(std::move(attributeTypes)) {
+              attributeTypes(std::move(attributeTypes)),
+              attributeDomainSizes(attributeDomainSizes.empty() ? std::vector<std::size_t>(arity)
+                                                                 : std::move(attributeDomainSizes)) {
         assert(this->attributeNames.size() == arity && "arity mismatch for attributes");
         assert(this->attributeTypes.size() == arity && "arity mismatch for types");
+        assert(this->attributeDomainSizes.size() == arity && "arity mismatch for domain sizes");
         for (std::size_t i = 0; i < arity; i++) {
             assert(!this->attributeNames[i].empty() && "no attribute name specified");
             assert(!this->attributeTypes[i].empty() && "no attribute type specified");
@@ -65,6 +68,11 @@ public:
         return attributeNames;
     }
 
+    /** @brief Get number of distinct values of each attribute, or 0 if unbounded */
+    const std::vector<std::size_t>& getAttributeDomainSizes() const {
+        return attributeDomainSizes;
+    }
+
     /** @brief Is nullary relation */
     bool isNullary() const {
         return arity == 0;
@@ -96,7 +104,8 @@ public:
     }
 
     Relation* cloning() const override {
-        return new Relation(name, arity, auxiliaryArity, attributeNames, attributeTypes, representation);
+        return new Relation(name, arity, auxiliaryArity, attributeNames, attributeTypes, representation,
+                attributeDomainSizes);
     }
 
     static bool classof(const Node* n) {
@@ -126,7 +135,8 @@ protected:
         const auto& other = asAssert<Relation>(node);
         return representation == other.representation && name == other.name && arity == other.arity &&
                auxiliaryArity == other.auxiliaryArity && attributeNames == other.attributeNames &&
-               attributeTypes == other.attributeTypes;
+               attributeTypes == other.attributeTypes &&
+               attributeDomainSizes == other.attributeDomainSizes;
     }
 
 protected:
@@ -147,6 +157,9 @@ protected:
 
     /** Type of attributes */
     const std::vector<std::string> attributeTypes;
+
+    /** Number of distinct values of attributes (0 if unbounded) */
+    const std::vector<std::size_t> attributeDomainSizes;
 };
 
 /**
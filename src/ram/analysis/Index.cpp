@@ -398,6 +398,10 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
             relationToSearches[estimateJoinSize->getRelation()].insert(getSearchSignature(estimateJoinSize));
         } else if (const auto* indexSearch = as<IndexOperation>(node)) {
             relationToSearches[indexSearch->getRelation()].insert(getSearchSignature(indexSearch));
+        } else if (const auto* join = as<LeapfrogJoin>(node)) {
+            for (std::size_t i = 0; i < join->getNumParts(); ++i) {
+                relationToSearches[join->getRelation(i)].insert(getSearchSignature(join, i));
+            }
         } else if (const auto* exists = as<ExistenceCheck>(node)) {
             relationToSearches[exists->getRelation()].insert(getSearchSignature(exists));
         } else if (const auto* provExists = as<ProvenanceExistenceCheck>(node)) {
@@ -525,6 +529,14 @@ SearchSignature IndexAnalysis::getSearchSignature(const IndexOperation* search)
     return keys;
 }
 
+SearchSignature IndexAnalysis::getSearchSignature(const LeapfrogJoin* join, std::size_t part) const {
+    const Relation* rel = &relAnalysis->lookup(join->getRelation(part));
+    auto keys = searchSignature(rel->getArity(), join->getPattern(part));
+    // the joined column is ordered right after the bound columns
+    keys[join->getColumn(part)] = AttributeConstraint::Inequal;
+    return keys;
+}
+
 SearchSignature IndexAnalysis::getSearchSignature(const ProvenanceExistenceCheck* provExistCheck) const {
     const auto values = provExistCheck->getValues();
     const Relation* rel = &relAnalysis->lookup(provExistCheck->getRelation());
@@ -20,6 +20,7 @@
 #include "ram/EstimateJoinSize.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/IndexOperation.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Relation.h"
 #include "ram/TranslationUnit.h"
@@ -515,6 +516,13 @@ public:
      */
     SearchSignature getSearchSignature(const IndexOperation* search) const;
 
+    /**
+     * @Brief Get index signature for a relation of a leapfrog join
+     * @param  Leapfrog join and the position of the relation
+     * @result Index signature of the relation
+     */
+    SearchSignature getSearchSignature(const LeapfrogJoin* join, std::size_t part) const;
+
     /**
      * @Brief Get the index signature for an existence check
      * @param Existence check
@@ -26,12 +26,14 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/Fork.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
 #include "ram/IndexIfExists.h"
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/Negation.h"
 #include "ram/Node.h"
 #include "ram/NumericConstant.h"
@@ -157,6 +159,17 @@ std::optional<std::size_t> LevelAnalysis::getLevel(const Node* node) const {
             return max(level, dispatch(indexAggregate.getCondition()));
         }
 
+        // leapfrog join
+        maybe_level visit_(type_identity<LeapfrogJoin>, const LeapfrogJoin& join) override {
+            maybe_level level = std::nullopt;
+            for (std::size_t i = 0; i < join.getNumParts(); ++i) {
+                for (const auto* value : join.getPattern(i)) {
+                    level = max(level, dispatch(*value));
+                }
+            }
+            return level;
+        }
+
         // unpack record
         maybe_level visit_(type_identity<UnpackRecord>, const UnpackRecord& unpack) override {
             return dispatch(unpack.getExpression());
@@ -191,6 +204,15 @@ std::optional<std::size_t> LevelAnalysis::getLevel(const Node* node) const {
             return level;
         }
 
+        // fork
+        maybe_level visit_(type_identity<Fork>, const Fork& fork) override {
+            maybe_level level = std::nullopt;
+            for (auto* branch : fork.getBranches()) {
+                level = max(level, dispatch(*branch));
+            }
+            return level;
+        }
+
         // return
         maybe_level visit_(type_identity<SubroutineReturn>, const SubroutineReturn& ret) override {
             maybe_level level = std::nullopt;
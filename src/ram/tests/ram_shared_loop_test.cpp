@@ -0,0 +1,81 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_shared_loop_test.cpp
+ *
+ * Tests the loop shared among the threads replicating a parallel loop.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "ram/AbstractParallel.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Constraint.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/Operation.h"
+#include "ram/ParallelScan.h"
+#include "ram/Scan.h"
+#include "ram/SignedConstant.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/TupleElement.h"
+#include "ram/UserDefinedOperator.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/TypeAttribute.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::test {
+
+/** FOR t0 IN A, IF <value> >= 0, FOR t1 IN B, RETURN t1.0 */
+Own<ParallelScan> makeLoop(Own<Expression> value) {
+    VecOwn<Expression> ret;
+    ret.push_back(mk<TupleElement>(1, 0));
+    auto inner = mk<Scan>("B", 1, mk<SubroutineReturn>(std::move(ret)));
+    auto cond = mk<Constraint>(BinaryConstraintOp::GE, std::move(value), mk<SignedConstant>(0));
+    return mk<ParallelScan>("A", 0, mk<Filter>(std::move(cond), std::move(inner)));
+}
+
+Own<Expression> makeFunctor(bool stateful) {
+    VecOwn<Expression> args;
+    args.push_back(mk<TupleElement>(0, 0));
+    return mk<UserDefinedOperator>(
+            "f", std::vector<TypeAttribute>{TypeAttribute::Signed}, TypeAttribute::Signed, stateful,
+            std::move(args));
+}
+
+TEST(SharedLoop, Filter) {
+    auto loop = makeLoop(mk<TupleElement>(0, 0));
+    const RelationOperation* shared = getSharedLoop(*loop);
+    EXPECT_NE(shared, nullptr);
+    if (shared != nullptr) {
+        EXPECT_EQ(shared->getRelation(), "B");
+    }
+}
+
+TEST(SharedLoop, StatelessFunctor) {
+    auto loop = makeLoop(makeFunctor(false));
+    EXPECT_NE(getSharedLoop(*loop), nullptr);
+}
+
+TEST(SharedLoop, StatefulFunctor) {
+    auto loop = makeLoop(makeFunctor(true));
+    EXPECT_EQ(getSharedLoop(*loop), nullptr);
+}
+
+TEST(SharedLoop, AutoIncrement) {
+    auto loop = makeLoop(mk<AutoIncrement>());
+    EXPECT_EQ(getSharedLoop(*loop), nullptr);
+}
+
+}  // namespace souffle::ram::test
@@ -35,7 +35,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/Operation.h"
 #include "ram/Parallel.h"
@@ -92,6 +94,24 @@ TEST(Clear, CloneAndEquals) {
     delete c;
 }
 
+TEST(Merge, CloneAndEquals) {
+    // MERGE B WITH A
+    Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Merge a("B", "A");
+    Merge b("B", "A");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    Merge c("A", "B");
+    EXPECT_NE(a, c);
+
+    Merge* d = a.cloning();
+    EXPECT_EQ(a, *d);
+    EXPECT_NE(&a, d);
+    delete d;
+}
+
 TEST(MergeExtend, CloneAndEquals) {
     // MERGE B WITH A
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
@@ -107,6 +127,30 @@ TEST(MergeExtend, CloneAndEquals) {
     delete c;
 }
 
+TEST(MergeLattice, CloneAndEquals) {
+    // MERGE-LATTICE A WITH @new_A INTO @delta_A USING (max(t0.1, t1.1))
+    auto joins = [](std::size_t tupleId) {
+        VecOwn<Expression> args;
+        args.emplace_back(new TupleElement(0, 1));
+        args.emplace_back(new TupleElement(tupleId, 1));
+        VecOwn<Expression> joins;
+        joins.emplace_back(new IntrinsicOperator(FunctorOp::MAX, std::move(args)));
+        return joins;
+    };
+    MergeLattice a("A", "@new_A", "@delta_A", joins(1));
+    MergeLattice b("A", "@new_A", "@delta_A", joins(1));
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    MergeLattice c("A", "@new_A", "@delta_A", joins(0));
+    EXPECT_NE(a, c);
+
+    MergeLattice* d = a.cloning();
+    EXPECT_EQ(a, *d);
+    EXPECT_NE(&a, d);
+    delete d;
+}
+
 TEST(Swap, CloneAndEquals) {
     // SWAP(A,B)
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
@@ -0,0 +1,423 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReduceIndexes.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/ReduceIndexes.h"
+#include "RelationTag.h"
+#include "ram/Aggregate.h"
+#include "ram/Condition.h"
+#include "ram/Constraint.h"
+#include "ram/EstimateJoinSize.h"
+#include "ram/ExistenceCheck.h"
+#include "ram/Filter.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexScan.h"
+#include "ram/LeapfrogJoin.h"
+#include "ram/Node.h"
+#include "ram/ProvenanceExistenceCheck.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/Scan.h"
+#include "ram/Swap.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/profile/ProgramRun.h"
+#include "souffle/profile/Reader.h"
+#include "souffle/profile/Relation.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+using namespace analysis;
+
+namespace {
+
+using SearchWeightMap = std::unordered_map<SearchSignature, double, SearchSignature::Hasher>;
+using SearchOrderMap = std::unordered_map<SearchSignature, std::size_t, SearchSignature::Hasher>;
+using SearchHashSet = std::unordered_set<SearchSignature, SearchSignature::Hasher>;
+
+/** Name of the profiled relation a RAM relation stems from */
+std::string getProfiledName(const std::string& name) {
+    return stripPrefix("@new_", stripPrefix("@delta_", name));
+}
+
+/** Profiled number of tuples of the relation, zero if it has not been profiled */
+double getProfiledSize(const profile::ProgramRun& run, const std::string& name) {
+    if (const auto* rel = run.getRelation(getProfiledName(name))) {
+        return static_cast<double>(rel->size());
+    }
+    return 0;
+}
+
+/** Estimated number of tuples stored at once, a delta holds those of a single iteration */
+double getStoredSize(const profile::ProgramRun& run, const std::string& name) {
+    const auto* rel = run.getRelation(getProfiledName(name));
+    if (rel == nullptr) {
+        return 0;
+    }
+    double size = static_cast<double>(rel->size());
+    if (getProfiledName(name) != name) {
+        size /= static_cast<double>(std::max<std::size_t>(rel->getIterations().size(), 1));
+    }
+    return size;
+}
+
+/** Length of the prefix of the order consisting of equalities of the search */
+std::size_t getEqualPrefix(const SearchSignature& search, const LexOrder& order) {
+    std::size_t length = 0;
+    while (length < order.size() && search[order[length]] == AttributeConstraint::Equal) {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * Estimated number of tuples scanned by a search served by a prefix of the
+ * order, assuming that each constrained attribute is equally selective
+ */
+double getScanCost(const SearchSignature& search, const LexOrder& order, double size) {
+    std::size_t bound = 0;
+    for (std::size_t i = 0; i < search.arity(); ++i) {
+        bound += (search[i] != AttributeConstraint::None);
+    }
+    // a search without constraints scans the whole relation whichever index serves it
+    if (bound == 0) {
+        return std::max(size, 1.0);
+    }
+    const std::size_t unserved = bound - getEqualPrefix(search, order);
+    return std::pow(std::max(size, 1.0), static_cast<double>(unserved) / static_cast<double>(bound));
+}
+
+/**
+ * The indexes shared by relations swapped with each other, and the index
+ * currently serving each of their searches
+ */
+struct IndexGroup {
+    std::vector<std::string> relations;
+    OrderCollection orders;
+    std::vector<bool> kept;
+    std::vector<bool> pinned;
+    SearchOrderMap selected;
+    SearchOrderMap server;
+    SearchWeightMap weight;
+    double size = 0;
+    double memory = 0;
+    bool reducible = true;
+
+    std::size_t getNumKept() const {
+        return std::count(kept.begin(), kept.end(), true);
+    }
+
+    /** Estimated number of tuples scanned by the search served by the index */
+    double getCost(const SearchSignature& search, std::size_t order) const {
+        if (order == selected.at(search)) {
+            return 1;
+        }
+        return getScanCost(search, orders[order], size);
+    }
+
+    /** Cheapest remaining index to serve the search other than the excluded one */
+    std::size_t getServer(const SearchSignature& search, std::size_t excluded) const {
+        std::size_t best = orders.size();
+        for (std::size_t order = 0; order < orders.size(); ++order) {
+            if (kept[order] && order != excluded &&
+                    (best == orders.size() || getCost(search, order) < getCost(search, best))) {
+                best = order;
+            }
+        }
+        return best;
+    }
+
+    /** Additional tuples scanned by the searches served by the index once it is dropped */
+    double getPenalty(std::size_t order) const {
+        double penalty = 0;
+        for (const auto& [search, cur] : server) {
+            if (cur == order) {
+                auto it = weight.find(search);
+                double uses = (it != weight.end()) ? it->second : 0;
+                penalty += uses * (getCost(search, getServer(search, order)) - getCost(search, order));
+            }
+        }
+        return penalty;
+    }
+
+    void drop(std::size_t order) {
+        for (auto& [search, cur] : server) {
+            if (cur == order) {
+                cur = getServer(search, order);
+            }
+        }
+        kept[order] = false;
+    }
+};
+
+}  // namespace
+
+Own<Operation> ReduceIndexesTransformer::rewriteSearch(
+        const IndexOperation& search, const LexOrder& order) const {
+    const Relation& rel = relAnalysis->lookup(search.getRelation());
+    const auto& types = rel.getAttributeTypes();
+    const SearchSignature signature = idxAnalysis->getSearchSignature(&search);
+    const std::size_t identifier = search.getTupleId();
+    const auto [lower, upper] = search.getRangePattern();
+
+    // the prefix of equalities is searched by the index
+    const std::size_t prefix = getEqualPrefix(signature, order);
+    std::vector<bool> served(rel.getArity(), false);
+    for (std::size_t i = 0; i < prefix; ++i) {
+        served[order[i]] = true;
+    }
+
+    // the remaining constraints are filtered
+    RamPattern pattern;
+    VecOwn<Condition> conditions;
+    for (std::size_t i = 0; i < rel.getArity(); ++i) {
+        if (served[i]) {
+            pattern.first.push_back(clone(lower[i]));
+            pattern.second.push_back(clone(upper[i]));
+            continue;
+        }
+        pattern.first.push_back(mk<UndefValue>());
+        pattern.second.push_back(mk<UndefValue>());
+        if (signature[i] == AttributeConstraint::Equal) {
+            conditions.push_back(mk<Constraint>(
+                    BinaryConstraintOp::EQ, mk<TupleElement>(identifier, i), clone(lower[i])));
+            continue;
+        }
+        if (!isUndefValue(lower[i])) {
+            conditions.push_back(mk<Constraint>(getGreaterEqualConstraint(types[i]),
+                    mk<TupleElement>(identifier, i), clone(lower[i])));
+        }
+        if (!isUndefValue(upper[i])) {
+            conditions.push_back(mk<Constraint>(getLessEqualConstraint(types[i]),
+                    mk<TupleElement>(identifier, i), clone(upper[i])));
+        }
+    }
+
+    if (const auto* scan = as<IndexScan>(search)) {
+        auto nested = mk<Filter>(toCondition(conditions), clone(scan->getOperation()));
+        if (prefix == 0) {
+            return mk<Scan>(rel.getName(), identifier, std::move(nested), scan->getProfileText());
+        }
+        return mk<IndexScan>(rel.getName(), identifier, std::move(pattern), std::move(nested),
+                scan->getProfileText());
+    }
+
+    if (const auto* ifExists = as<IndexIfExists>(search)) {
+        if (!isTrue(&ifExists->getCondition())) {
+            conditions.push_back(clone(ifExists->getCondition()));
+        }
+        if (prefix == 0) {
+            return mk<IfExists>(rel.getName(), identifier, toCondition(conditions),
+                    clone(ifExists->getOperation()), ifExists->getProfileText());
+        }
+        return mk<IndexIfExists>(rel.getName(), identifier, toCondition(conditions), std::move(pattern),
+                clone(ifExists->getOperation()), ifExists->getProfileText());
+    }
+
+    if (const auto* aggregate = as<IndexAggregate>(search)) {
+        if (!isTrue(&aggregate->getCondition())) {
+            conditions.push_back(clone(aggregate->getCondition()));
+        }
+        if (prefix == 0) {
+            return mk<Aggregate>(clone(aggregate->getOperation()), clone(aggregate->getAggregator()),
+                    rel.getName(), clone(aggregate->getExpression()), toCondition(conditions), identifier);
+        }
+        return mk<IndexAggregate>(clone(aggregate->getOperation()), clone(aggregate->getAggregator()),
+                rel.getName(), clone(aggregate->getExpression()), toCondition(conditions),
+                std::move(pattern), identifier);
+    }
+
+    fatal("unsupported index operation");
+}
+
+bool ReduceIndexesTransformer::reduceIndexes(Global& glb, Program& program) {
+    // relation sizes are required to estimate the memory of the indexes
+    if (!glb.config().has("index-budget") || !glb.config().has("auto-schedule")) {
+        return false;
+    }
+    const double budget = std::stod(glb.config().get("index-budget")) * 1024 * 1024;
+
+    auto run = std::make_shared<profile::ProgramRun>(profile::ProgramRun());
+    profile::Reader reader(glb.config().get("auto-schedule"), run);
+    reader.processFile();
+
+    // swapped relations share their searches and thus their indexes
+    std::map<std::string, std::string> parent;
+    auto find = [&](std::string rel) {
+        while (contains(parent, rel)) {
+            rel = parent[rel];
+        }
+        return rel;
+    };
+    visit(program, [&](const Swap& swap) {
+        auto first = find(swap.getFirstRelation());
+        auto second = find(swap.getSecondRelation());
+        if (first != second) {
+            parent[std::max(first, second)] = std::min(first, second);
+        }
+    });
+
+    // searches that must be served by an index
+    std::map<std::string, SearchHashSet> pinned;
+    visit(program, [&](const Node& node) {
+        if (const auto* exists = as<ExistenceCheck>(node)) {
+            pinned[exists->getRelation()].insert(idxAnalysis->getSearchSignature(exists));
+        } else if (const auto* provExists = as<ProvenanceExistenceCheck>(node)) {
+            pinned[provExists->getRelation()].insert(idxAnalysis->getSearchSignature(provExists));
+        } else if (const auto* estimate = as<EstimateJoinSize>(node)) {
+            pinned[estimate->getRelation()].insert(idxAnalysis->getSearchSignature(estimate));
+        } else if (const auto* join = as<LeapfrogJoin>(node)) {
+            for (std::size_t i = 0; i < join->getNumParts(); ++i) {
+                pinned[join->getRelation(i)].insert(idxAnalysis->getSearchSignature(join, i));
+            }
+        }
+    });
+
+    // a search nested in a loop is executed once per tuple of the outermost relation
+    std::map<std::string, SearchWeightMap> uses;
+    visit(program, [&](const Query& query) {
+        const RelationOperation* outer = nullptr;
+        visit(query, [&](const RelationOperation& op) {
+            if (outer == nullptr) {
+                outer = &op;
+            }
+            if (const auto* search = as<IndexOperation>(op)) {
+                double frequency = (outer == &op) ? 1 : getProfiledSize(*run, outer->getRelation());
+                uses[search->getRelation()][idxAnalysis->getSearchSignature(search)] +=
+                        std::max(frequency, 1.0);
+            }
+        });
+    });
+
+    std::map<std::string, IndexGroup> groups;
+    for (const Relation* rel : program.getRelations()) {
+        auto& group = groups[find(rel->getName())];
+        auto rep = rel->getRepresentation();
+        bool btree = (rep == RelationRepresentation::BTREE || rep == RelationRepresentation::DEFAULT);
+        double size = getProfiledSize(*run, rel->getName());
+        group.relations.push_back(rel->getName());
+        group.reducible = group.reducible && btree && rel->getAuxiliaryArity() == 0 && size > 0;
+        group.size = std::max(group.size, size);
+        group.memory += getStoredSize(*run, rel->getName()) * rel->getArity() * sizeof(RamDomain);
+    }
+
+    for (auto& [name, group] : groups) {
+        if (!group.reducible) {
+            continue;
+        }
+        const IndexCluster cluster = idxAnalysis->getIndexSelection(name);
+        group.orders = cluster.getAllOrders();
+        group.kept.assign(group.orders.size(), true);
+        group.pinned.assign(group.orders.size(), false);
+        for (const auto& search : cluster.getSearches()) {
+            std::size_t order = cluster.getLexOrderNum(search);
+            group.selected[search] = order;
+            group.server[search] = order;
+            bool total = (search == SearchSignature::getFullSearchSignature(search.arity()));
+            for (const auto& rel : group.relations) {
+                total = total || contains(pinned[rel], search);
+                group.weight[search] += uses[rel][search];
+            }
+            group.pinned[order] = group.pinned[order] || total;
+        }
+    }
+
+    // the memory of the indexes beyond the first index of each relation
+    double extra = 0;
+    for (const auto& [name, group] : groups) {
+        if (group.reducible) {
+            extra += static_cast<double>(group.getNumKept() - 1) * group.memory;
+        }
+    }
+
+    // drop the index of least penalty per memory saved until the budget is met
+    bool changed = false;
+    while (extra > budget) {
+        IndexGroup* best = nullptr;
+        std::size_t bestOrder = 0;
+        double bestRatio = 0;
+        for (auto& [name, group] : groups) {
+            if (!group.reducible || group.memory <= 0 || group.getNumKept() < 2) {
+                continue;
+            }
+            for (std::size_t order = 0; order < group.orders.size(); ++order) {
+                if (!group.kept[order] || group.pinned[order]) {
+                    continue;
+                }
+                double ratio = group.getPenalty(order) / group.memory;
+                if (best == nullptr || ratio < bestRatio) {
+                    best = &group;
+                    bestOrder = order;
+                    bestRatio = ratio;
+                }
+            }
+        }
+        if (best == nullptr) {
+            break;
+        }
+        best->drop(bestOrder);
+        extra -= best->memory;
+        changed = true;
+    }
+    if (!changed) {
+        return false;
+    }
+
+    // serve the searches of the dropped indexes by the remaining indexes
+    std::map<std::string, std::unordered_map<SearchSignature, LexOrder, SearchSignature::Hasher>> reduced;
+    for (const auto& [name, group] : groups) {
+        for (const auto& [search, order] : group.server) {
+            if (order != group.selected.at(search)) {
+                for (const auto& rel : group.relations) {
+                    reduced[rel][search] = group.orders[order];
+                }
+            }
+        }
+    }
+
+    forEachQueryMap(program, [&](auto&& go, Own<Node> node) -> Own<Node> {
+        if (const auto* search = as<IndexOperation>(node)) {
+            auto it = reduced.find(search->getRelation());
+            if (it != reduced.end()) {
+                auto jt = it->second.find(idxAnalysis->getSearchSignature(search));
+                if (jt != it->second.end()) {
+                    node = rewriteSearch(*search, jt->second);
+                }
+            }
+        }
+        node->apply(go);
+        return node;
+    });
+
+    return true;
+}
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,102 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReduceIndexes.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "Global.h"
+#include "ram/IndexOperation.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Index.h"
+#include "ram/analysis/Relation.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class ReduceIndexesTransformer
+ * @brief Drop indexes of large relations to meet an index memory budget
+ *
+ * The minimal index selection creates an index per chain of searches of a
+ * relation, irrespective of how often a search is used and of how large the
+ * relation is. Each index beyond the first holds another copy of the relation,
+ * such that the indexes of large relations may dominate the memory usage.
+ *
+ * Given a memory budget for these extra indexes (option index-budget) and the
+ * relation sizes of a profile (option auto-schedule), the transformer drops
+ * the indexes of the least penalty per memory saved until the budget is met.
+ * The penalty of an index is the estimated number of tuples that its searches
+ * additionally scan when served by a remaining index, weighted by the number
+ * of times each search is executed.
+ *
+ * The searches of a dropped index are served by the longest prefix of
+ * equalities of a remaining index and the remaining constraints are filtered:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    FOR t1 IN A ON INDEX t1.0 = t0.1 AND t1.1 = t0.0
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten for a remaining index 0 < 2 < 1 to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    FOR t1 IN A ON INDEX t1.0 = t0.1
+ *     IF t1.1 = t0.0
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Indexes serving existence checks, leapfrog joins and join-size estimates
+ * are kept, as are the indexes of relations missing from the profile.
+ */
+class ReduceIndexesTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ReduceIndexesTransformer";
+    }
+
+    /**
+     * @brief Serve the searches of a dropped index by a prefix of another index
+     * @param search Index operation whose search is no longer served by an index
+     * @param order Remaining index serving the search
+     * @result Operation searching the longest prefix of equalities of the index
+     *         and filtering the remaining constraints
+     */
+    Own<Operation> rewriteSearch(const IndexOperation& search, const analysis::LexOrder& order) const;
+
+    /**
+     * @brief Drop indexes to meet the index memory budget
+     * @param glb Global configuration providing the budget and the profile
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool reduceIndexes(Global& glb, Program& program);
+
+protected:
+    analysis::IndexAnalysis* idxAnalysis{nullptr};
+    analysis::RelationAnalysis* relAnalysis{nullptr};
+
+    bool transform(TranslationUnit& translationUnit) override {
+        idxAnalysis = &translationUnit.getAnalysis<analysis::IndexAnalysis>();
+        relAnalysis = &translationUnit.getAnalysis<analysis::RelationAnalysis>();
+        return reduceIndexes(translationUnit.global(), translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,322 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ShareSubplans.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/ShareSubplans.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Condition.h"
+#include "ram/Break.h"
+#include "ram/DebugInfo.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/Filter.h"
+#include "ram/Fork.h"
+#include "ram/Insert.h"
+#include "ram/LeapfrogJoin.h"
+#include "ram/Negation.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
+#include "ram/Sequence.h"
+#include "ram/Statement.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/TupleElement.h"
+#include "ram/TupleOperation.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+namespace {
+
+/** Relations read and written by a query */
+struct QueryEffects {
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+
+    /** Whether the query may be interleaved with other queries */
+    bool isFusable = true;
+};
+
+QueryEffects getEffects(const Query& query) {
+    QueryEffects effects;
+    visit(query, [&](const Node& node) {
+        if (const auto* insert = as<Insert>(node)) {
+            effects.writes.insert(insert->getRelation());
+        } else if (const auto* op = as<RelationOperation>(node)) {
+            effects.reads.insert(op->getRelation());
+        } else if (const auto* join = as<LeapfrogJoin>(node)) {
+            for (std::size_t i = 0; i < join->getNumParts(); ++i) {
+                effects.reads.insert(join->getRelation(i));
+            }
+        } else if (const auto* check = as<AbstractExistenceCheck>(node)) {
+            effects.reads.insert(check->getRelation());
+        } else if (const auto* check = as<EmptinessCheck>(node)) {
+            effects.reads.insert(check->getRelation());
+        } else if (const auto* size = as<RelationSize>(node)) {
+            effects.reads.insert(size->getRelation());
+        } else if (isA<Erase>(node) || isA<Break>(node) || isA<SubroutineReturn>(node) ||
+                   isA<AutoIncrement>(node)) {
+            // breaks terminate the shared loops, and the other operations depend on the evaluation order
+            effects.isFusable = false;
+        }
+    });
+    return effects;
+}
+
+bool isDisjoint(const std::set<std::string>& lhs, const std::set<std::string>& rhs) {
+    return std::none_of(lhs.begin(), lhs.end(), [&](const std::string& rel) { return rhs.count(rel) > 0; });
+}
+
+/** Tests whether two nested operations are equal apart from their nested operations */
+bool equalHeads(const NestedOperation& lhs, const NestedOperation& rhs) {
+    if (lhs.getKind() != rhs.getKind()) {
+        return false;
+    }
+    auto getHead = [](const NestedOperation& op) {
+        Own<NestedOperation> head(op.cloning());
+        const Operation* nested = &head->getOperation();
+        head->apply(nodeMapper<Node>([&](Own<Node> node) -> Own<Node> {
+            if (node.get() == nested) {
+                return mk<SubroutineReturn>(VecOwn<Expression>());
+            }
+            return node;
+        }));
+        return head;
+    };
+    return *getHead(lhs) == *getHead(rhs);
+}
+
+/** Tests whether a condition only depends on relation sizes and holds throughout a query */
+bool isGuard(const Condition& cond) {
+    if (const auto* neg = as<Negation>(cond)) {
+        return isA<EmptinessCheck>(neg->getOperand());
+    }
+    return isA<EmptinessCheck>(cond);
+}
+
+/** Number of loops shared by an operation and one to be merged into it */
+std::size_t getSharedLoops(const Operation& op, const Operation& other) {
+    if (const auto* fork = as<Fork>(op)) {
+        std::size_t res = 0;
+        for (const auto* branch : fork->getBranches()) {
+            res = std::max(res, getSharedLoops(*branch, other));
+        }
+        return res;
+    }
+    const auto* nested = as<NestedOperation>(op);
+    const auto* otherNested = as<NestedOperation>(other);
+    if (nested == nullptr || otherNested == nullptr || !equalHeads(*nested, *otherNested)) {
+        return 0;
+    }
+    std::size_t loops = isA<TupleOperation>(nested) ? 1 : 0;
+    return loops + getSharedLoops(nested->getOperation(), otherNested->getOperation());
+}
+
+/** Renumbers the tuples introduced by an operation, starting from the given identifier */
+void renumberTuples(Operation& op, std::size_t& nextId) {
+    std::map<std::size_t, std::size_t> reorder;
+    visit(op, [&](TupleOperation& search) {
+        reorder[search.getTupleId()] = nextId;
+        search.setTupleId(nextId++);
+    });
+
+    op.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+        if (auto* element = as<TupleElement>(node)) {
+            auto it = reorder.find(element->getTupleId());
+            if (it != reorder.end()) {
+                node = mk<TupleElement>(it->second, element->getElement());
+            }
+        }
+        node->apply(go);
+        return node;
+    }));
+}
+
+/** Replaces a child operation of a node in place */
+template <typename F /* Own<Operation> -> Own<Operation> */>
+void replaceChild(Node& node, const Operation* child, F&& f) {
+    node.apply(nodeMapper<Node>([&](Own<Node> cur) -> Own<Node> {
+        if (cur.get() == child) {
+            return f(Own<Operation>(as<Operation>(cur.release())));
+        }
+        return cur;
+    }));
+}
+
+/** Merges an operation into another along their common loop-nest prefix */
+Own<Operation> mergeOperations(Own<Operation> op, Own<Operation> other, std::size_t& nextId) {
+    if (auto* fork = as<Fork>(op)) {
+        // merge into the branch sharing most loops, otherwise add a branch
+        const Operation* best = nullptr;
+        std::size_t bestLoops = 0;
+        for (const auto* branch : fork->getBranches()) {
+            std::size_t loops = getSharedLoops(*branch, *other);
+            if (loops > bestLoops) {
+                best = branch;
+                bestLoops = loops;
+            }
+        }
+        if (best == nullptr) {
+            renumberTuples(*other, nextId);
+            fork->addBranch(std::move(other));
+            return op;
+        }
+        replaceChild(*fork, best, [&](Own<Operation> branch) {
+            return mergeOperations(std::move(branch), std::move(other), nextId);
+        });
+        return op;
+    }
+
+    auto* nested = as<NestedOperation>(op);
+    auto* otherNested = as<NestedOperation>(other);
+    if (nested != nullptr && otherNested != nullptr && equalHeads(*nested, *otherNested)) {
+        // descend into the shared operation
+        replaceChild(*nested, &nested->getOperation(), [&](Own<Operation> child) {
+            return mergeOperations(std::move(child), clone(otherNested->getOperation()), nextId);
+        });
+        return op;
+    }
+
+    // the operations diverge, so the remainder of the other operation gets fresh tuples
+    renumberTuples(*other, nextId);
+    VecOwn<Operation> branches;
+    branches.push_back(std::move(op));
+    branches.push_back(std::move(other));
+    return mk<Fork>(std::move(branches));
+}
+
+/** Splits the guards of the outermost filter from an operation */
+std::pair<VecOwn<Condition>, Own<Operation>> splitGuards(const Operation& op) {
+    VecOwn<Condition> guards;
+    const auto* filter = as<Filter>(op);
+    if (filter == nullptr) {
+        return {std::move(guards), clone(op)};
+    }
+
+    VecOwn<Condition> rest;
+    for (auto& cond : toConjunctionList(&filter->getCondition())) {
+        (isGuard(*cond) ? guards : rest).push_back(std::move(cond));
+    }
+    Own<Operation> body = clone(filter->getOperation());
+    if (!rest.empty()) {
+        body = mk<Filter>(toCondition(rest), std::move(body), filter->getProfileText());
+    }
+    return {std::move(guards), std::move(body)};
+}
+
+/** Query of a statement, which may carry debug information */
+const Query* getQuery(const Statement& stmt) {
+    if (const auto* info = as<DebugInfo>(stmt)) {
+        return as<Query>(info->getStatement());
+    }
+    return as<Query>(stmt);
+}
+
+/** Fuses two queries if they share loops and do not interfere, returns nullptr otherwise */
+Own<Statement> fuseQueries(const Statement& stmt, const Statement& other) {
+    const auto* query = getQuery(stmt);
+    const auto* otherQuery = getQuery(other);
+    if (query == nullptr || otherQuery == nullptr || stmt.getKind() != other.getKind()) {
+        return nullptr;
+    }
+
+    auto effects = getEffects(*query);
+    auto otherEffects = getEffects(*otherQuery);
+    if (!effects.isFusable || !otherEffects.isFusable || !isDisjoint(effects.writes, otherEffects.reads) ||
+            !isDisjoint(otherEffects.writes, effects.reads)) {
+        return nullptr;
+    }
+
+    // the guards only depend on relation sizes and are checked once before the loops, so
+    // queries are only fused if they agree on their guards
+    auto [guards, body] = splitGuards(query->getOperation());
+    auto [otherGuards, otherBody] = splitGuards(otherQuery->getOperation());
+    auto contains = [](const VecOwn<Condition>& conds, const Condition& cond) {
+        return std::any_of(
+                conds.begin(), conds.end(), [&](const Own<Condition>& cur) { return *cur == cond; });
+    };
+    auto subsumes = [&](const VecOwn<Condition>& lhs, const VecOwn<Condition>& rhs) {
+        return std::all_of(
+                rhs.begin(), rhs.end(), [&](const Own<Condition>& cond) { return contains(lhs, *cond); });
+    };
+    if (!subsumes(guards, otherGuards) || !subsumes(otherGuards, guards) ||
+            getSharedLoops(*body, *otherBody) == 0) {
+        return nullptr;
+    }
+
+    std::size_t nextId = 0;
+    visit(*query, [&](const TupleOperation& search) { nextId = std::max(nextId, search.getTupleId() + 1); });
+    auto merged = mergeOperations(std::move(body), std::move(otherBody), nextId);
+    if (!guards.empty()) {
+        merged = mk<Filter>(toCondition(guards), std::move(merged));
+    }
+    auto fused = mk<Query>(std::move(merged));
+
+    if (const auto* info = as<DebugInfo>(stmt)) {
+        const auto& otherMessage = as<DebugInfo>(other)->getMessage();
+        return mk<DebugInfo>(std::move(fused), info->getMessage() + "\n" + otherMessage);
+    }
+    return fused;
+}
+
+}  // namespace
+
+bool ShareSubplansTransformer::shareSubplans(Program& program) {
+    bool changed = false;
+    program.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+        node->apply(go);
+
+        const auto* sequence = as<Sequence>(node);
+        if (sequence == nullptr) {
+            return node;
+        }
+
+        // fuse each query into the preceding one while they share loops
+        VecOwn<Statement> statements;
+        bool fused = false;
+        for (const auto* stmt : sequence->getStatements()) {
+            if (!statements.empty()) {
+                if (auto res = fuseQueries(*statements.back(), *stmt)) {
+                    statements.back() = std::move(res);
+                    fused = true;
+                    continue;
+                }
+            }
+            statements.push_back(clone(stmt));
+        }
+
+        if (fused) {
+            changed = true;
+            node = mk<Sequence>(std::move(statements));
+        }
+        return node;
+    }));
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,80 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ShareSubplans.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class ShareSubplansTransformer
+ * @brief Fuses consecutive queries sharing a loop-nest prefix
+ *
+ * For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    FOR t1 IN B ON INDEX t1.0 = t0.1
+ *     INSERT (t0.0, t1.1) INTO R
+ *  QUERY
+ *   FOR t0 IN A
+ *    FOR t1 IN B ON INDEX t1.0 = t0.1
+ *     FOR t2 IN C ON INDEX t2.0 = t1.1
+ *      INSERT (t0.0, t2.1) INTO S
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    FOR t1 IN B ON INDEX t1.0 = t0.1
+ *     FORK
+ *      BRANCH
+ *       INSERT (t0.0, t1.1) INTO R
+ *      BRANCH
+ *       FOR t2 IN C ON INDEX t2.0 = t1.1
+ *        INSERT (t0.0, t2.1) INTO S
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Queries are only fused if neither reads a relation written by the other,
+ * so that interleaving their insertions does not change the result, and if
+ * they check the same relations for emptiness, so that these checks stay
+ * outside of the shared loops.
+ */
+class ShareSubplansTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ShareSubplansTransformer";
+    }
+
+    /**
+     * @brief Fuse queries sharing a loop-nest prefix
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool shareSubplans(Program& program);
+
+protected:
+    bool transform(TranslationUnit& translationUnit) override {
+        return shareSubplans(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
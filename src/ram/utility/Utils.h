@@ -19,12 +19,18 @@
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
 #include "ram/Expression.h"
+#include "ram/Program.h"
+#include "ram/Relation.h"
 #include "ram/True.h"
 #include "ram/UndefValue.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <queue>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -115,4 +121,26 @@ inline std::vector<const ram::Condition*> findConjunctiveTerms(const ram::Condit
     return conditionList;
 }
 
+/**
+ * @brief Number of trailing attributes of a relation hidden from the interface of a program
+ *
+ * Besides the auxiliary attributes, a relation tracking its delta in place
+ * hides the iteration tag of its tuples.
+ */
+inline std::size_t getInterfaceAuxiliaryArity(const Relation& rel) {
+    const auto& names = rel.getAttributeNames();
+    const bool tagged = !names.empty() && names.back() == "@iteration";
+    return rel.getAuxiliaryArity() + (tagged ? 1 : 0);
+}
+
+/**
+ * @brief Fingerprint of a RAM program
+ *
+ * Code synthesised from a program is only used for the program it was
+ * synthesised from, which is identified by the fingerprint.
+ */
+inline std::size_t fingerprint(const Program& program) {
+    return std::hash<std::string>{}(toString(program));
+}
+
 }  // namespace souffle::ram
@@ -34,6 +34,7 @@
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
 #include "ram/Erase.h"
+#include "ram/Fork.h"
 #include "ram/EstimateJoinSize.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
@@ -50,12 +51,15 @@
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/ListStatement.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -151,8 +155,10 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(GuardedInsert);
         SOUFFLE_VISITOR_FORWARD(Insert);
         SOUFFLE_VISITOR_FORWARD(Erase);
+        SOUFFLE_VISITOR_FORWARD(Fork);
         SOUFFLE_VISITOR_FORWARD(SubroutineReturn);
         SOUFFLE_VISITOR_FORWARD(UnpackRecord);
+        SOUFFLE_VISITOR_FORWARD(LeapfrogJoin);
         SOUFFLE_VISITOR_FORWARD(NestedIntrinsicOperator);
         SOUFFLE_VISITOR_FORWARD(ParallelScan);
         SOUFFLE_VISITOR_FORWARD(Scan);
@@ -176,7 +182,9 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(EstimateJoinSize);
 
         SOUFFLE_VISITOR_FORWARD(Swap);
+        SOUFFLE_VISITOR_FORWARD(Merge);
         SOUFFLE_VISITOR_FORWARD(MergeExtend);
+        SOUFFLE_VISITOR_FORWARD(MergeLattice);
 
         // Control-flow
         SOUFFLE_VISITOR_FORWARD(Program);
@@ -205,8 +213,10 @@ protected:
     SOUFFLE_VISITOR_LINK(Assign, Statement);
 
     SOUFFLE_VISITOR_LINK(Swap, BinRelationStatement);
+    SOUFFLE_VISITOR_LINK(Merge, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(MergeExtend, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(BinRelationStatement, Statement);
+    SOUFFLE_VISITOR_LINK(MergeLattice, Statement);
 
     SOUFFLE_VISITOR_LINK(Sequence, ListStatement);
     SOUFFLE_VISITOR_LINK(Loop, Statement);
@@ -224,8 +234,10 @@ protected:
     SOUFFLE_VISITOR_LINK(GuardedInsert, Insert);
     SOUFFLE_VISITOR_LINK(Insert, Operation);
     SOUFFLE_VISITOR_LINK(Erase, Operation);
+    SOUFFLE_VISITOR_LINK(Fork, Operation);
     SOUFFLE_VISITOR_LINK(SubroutineReturn, Operation);
     SOUFFLE_VISITOR_LINK(UnpackRecord, TupleOperation);
+    SOUFFLE_VISITOR_LINK(LeapfrogJoin, TupleOperation);
     SOUFFLE_VISITOR_LINK(NestedIntrinsicOperator, TupleOperation)
     SOUFFLE_VISITOR_LINK(Scan, RelationOperation);
     SOUFFLE_VISITOR_LINK(ParallelScan, Scan);
@@ -29,8 +29,11 @@ if not JSON_DATA_TEXT:
     }"""
 
 import argparse
+import concurrent.futures
+import hashlib
 import json
 import os
+import re
 import pathlib
 import shutil
 import subprocess
@@ -74,6 +77,9 @@ parser.add_argument('-L', action='append', default=[], metavar='LIBDIR', dest='l
 parser.add_argument('-g', action='store_true', dest='debug', help="Debug build type")
 parser.add_argument('-s', metavar='LANG', dest='swiglang', choices=["java", "python"], help="use SWIG interface to generate into LANG language")
 parser.add_argument('-v', action='store_true', dest='verbose', help="Verbose output")
+parser.add_argument('--shared', action='store_true', dest='shared', help="Build a shared library embedding the program instead of an executable")
+parser.add_argument('-j', metavar='JOBS', dest='jobs', type=int, default=os.cpu_count(), help="Number of source files compiled in parallel")
+parser.add_argument('-c', metavar='CACHEDIR', dest='cache_dir', type=lambda p: pathlib.Path(p).absolute(), help="Directory caching the object files of multiple source files, defaults to .souffle-cache next to the sources")
 parser.add_argument('source', nargs='+', metavar='SOURCE', type=lambda p: pathlib.Path(p).absolute(), help="C++ source files")
 parser.add_argument('-o', metavar='BINARY', dest='output', type=lambda p: pathlib.Path(p).absolute(), help="Binary file name")
 
@@ -180,8 +186,136 @@ if args.swiglang:
 
         # move generated files to same directory as cpp file
         os.sys.exit(0)
+elif len(args.source) > 1 and conf['compiler_id'] != "MSVC":
+    # compile each source file to an object file in parallel, reusing the object
+    # files of a source file whose content and compilation flags did not change
+    exepath = args.output if args.shared else pathlib.Path("{}{}".format(args.output, exeext))
+    cache_dir = args.cache_dir or (args.source[0].parent / ".souffle-cache")
+    cache_dir.mkdir(parents=True, exist_ok=True)
+
+    cmd = []
+    cmd.append('"{}"'.format(conf['compiler']))
+    cmd.append(conf['definitions'])
+    cmd.append(conf['compile_options'])
+    cmd.append(conf['includes'])
+    cmd.append(conf['std_flag'])
+    cmd.append(conf['cxx_flags'])
+    if args.debug:
+        cmd.append(conf['debug_cxx_flags'])
+    else:
+        cmd.append(conf['release_cxx_flags'])
+    if souffle_include_dir:
+        cmd.append("-I{}".format(souffle_include_dir.parent))
+    if args.shared:
+        cmd.append("-fPIC -D__EMBEDDED_SOUFFLE__")
+    compile_cmd = " ".join(cmd)
+
+    # the Souffle headers only change with the installation, whose files are identified by their times
+    installation = []
+    if souffle_include_dir:
+        for header in sorted(souffle_include_dir.rglob("*.h")):
+            installation.append("{}:{}".format(header, header.stat().st_mtime_ns))
+
+    include_pattern = re.compile(r'^\s*#\s*include\s*"([^"]+)"', re.MULTILINE)
+
+    # hash a source file along with the generated headers it includes
+    def object_hash(source):
+        digest = hashlib.sha256()
+        digest.update(JSON_DATA_TEXT.encode())
+        digest.update(compile_cmd.encode())
+        digest.update("\n".join(installation).encode())
+        pending = [source]
+        seen = set()
+        while pending:
+            path = pending.pop()
+            if path in seen or not path.is_file():
+                continue
+            seen.add(path)
+            content = path.read_bytes()
+            digest.update(str(path.name).encode())
+            digest.update(content)
+            for include in include_pattern.findall(content.decode(errors="replace")):
+                pending.append(path.parent / include)
+        return digest.hexdigest()
+
+    # precompile the runtime header included first by each generated source file
+    object_cmd = compile_cmd
+    runtime_header = args.source[0].parent / "souffle-runtime.hpp"
+    if runtime_header.is_file() and conf['compiler_id'] in ("GNU", "Clang", "AppleClang"):
+        pch = pathlib.Path("{}.{}".format(runtime_header, "gch" if conf['compiler_id'] == "GNU" else "pch"))
+        pch_key = pathlib.Path("{}.key".format(pch))
+        key = object_hash(runtime_header)
+        try:
+            if not (pch.exists() and pch_key.exists() and pch_key.read_text() == key):
+                launch_command("{} -x c++-header \"{}\" -o \"{}\"".format(compile_cmd, runtime_header, pch),
+                               "Precompilation of {}".format(runtime_header.name), verbose=args.verbose)
+                pch_key.write_text(key)
+            object_cmd = "{} -include \"{}\"".format(compile_cmd, runtime_header)
+        except RuntimeError as e:
+            # compile without the precompiled header, which must not be picked up when stale
+            for stale in (pch, pch_key):
+                if stale.exists():
+                    stale.unlink()
+            if args.verbose:
+                sys.stderr.write("{}\n".format(e))
+
+    def compile_object(source):
+        obj = cache_dir / "{}.o".format(object_hash(source))
+        if obj.exists():
+            return obj, False
+        tmp = cache_dir / "{}.{}.tmp.o".format(obj.stem, os.getpid())
+        launch_command("{} -c \"{}\" -o \"{}\"".format(object_cmd, source, tmp),
+                       "Compilation of {}".format(source.name), verbose=args.verbose)
+        os.replace(tmp, obj)
+        return obj, True
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs or 1, 1)) as executor:
+        results = list(executor.map(compile_object, args.source))
+    objects = [obj for obj, _ in results]
+    if args.verbose:
+        compiled = sum(1 for _, fresh in results if fresh)
+        sys.stderr.write("Compiled {} of {} source files, reused {} object files\n".format(
+            compiled, len(results), len(results) - compiled))
+
+    # drop the object files an earlier build of this program no longer uses, keeping those
+    # listed by the manifests of other programs sharing the cache directory
+    manifest = cache_dir / "{}.manifest".format(hashlib.sha256(str(exepath).encode()).hexdigest())
+    previous = set(manifest.read_text().split()) if manifest.exists() else set()
+    manifest.write_text("".join("{}\n".format(obj.name) for obj in objects))
+    stale = previous - set(obj.name for obj in objects)
+    for other in cache_dir.glob("*.manifest"):
+        if other != manifest:
+            stale -= set(other.read_text().split())
+    for name in stale:
+        obj = cache_dir / name
+        if obj.exists():
+            obj.unlink()
+
+    cmd = []
+    cmd.append('"{}"'.format(conf['compiler']))
+    cmd.append(conf['cxx_flags'])
+    if args.debug:
+        cmd.append(conf['debug_cxx_flags'])
+    else:
+        cmd.append(conf['release_cxx_flags'])
+    if args.shared:
+        cmd.append("-shared")
+    cmd.append(OUTNAME_FMT.format(exepath))
+    for obj in objects:
+        cmd.append('"{}"'.format(obj))
+    cmd.append(conf['link_options'])
+    cmd.extend(list(map(lambda rpath: RPATH_FMT.format(rpath), RPATHS)))
+    cmd.extend(list(map(lambda libdir: LIBDIR_FMT.format(libdir), args.lib_dirs)))
+    cmd.extend(list(map(lambda libname: LIBNAME_FMT.format(libname), args.lib_names)))
+    cmd = " ".join(cmd)
+
+    if exepath.exists():
+        exepath.unlink()
+
+    launch_command(cmd, "Link of object files", verbose=args.verbose)
+    os.sys.exit(0)
 else:
-    exepath = pathlib.Path("{}{}".format(args.output, exeext))
+    exepath = args.output if args.shared else pathlib.Path("{}{}".format(args.output, exeext))
 
     cmd = []
     cmd.append('"{}"'.format(conf['compiler']))
@@ -196,6 +330,9 @@ else:
     else:
         cmd.append(conf['release_cxx_flags'])
 
+    if args.shared:
+        cmd.append("-fPIC -shared -D__EMBEDDED_SOUFFLE__")
+
     cmd.append(OUTNAME_FMT.format(exepath))
     for f in args.source:
         cmd.append(str(f))
@@ -259,18 +259,24 @@ std::string GenDb::emitMultipleFilesInDir(fs::path dir, std::vector<fs::path>& t
     fs::path rootDir = dir;
     fs::create_directories(rootDir);
 
-    auto globalHeader = [&](std::ofstream& hpp) {
+    // The runtime header is shared by all files and included first by each source file, such that
+    // souffle-compile.py may precompile it once.
+    {
+        std::ofstream runtime{rootDir / "souffle-runtime.hpp"};
+        runtime << "#pragma once\n";
         for (auto& def : globalDefines) {
-            hpp << "#define " << def << "\n";
+            runtime << "#define " << def << "\n";
         }
+        runtime << "#include \"souffle/CompiledSouffle.h\"\n";
         for (auto& inc : globalIncludes) {
-            hpp << "#include " << inc << "\n";
+            runtime << "#include " << inc << "\n";
         }
-    };
+    }
 
     auto genHeader = [&](std::ofstream& hpp, std::ofstream& cpp, GenFile& gen) {
         hpp << "#pragma once\n";
-        globalHeader(hpp);
+        hpp << "#include \"souffle-runtime.hpp\"\n";
+        cpp << "#include \"souffle-runtime.hpp\"\n";
         for (const std::string& inc : gen.getSortedDeclIncludes()) {
             hpp << "#include " << inc << "\n";
         }
@@ -62,6 +62,8 @@ Own<Relation> Relation::getSynthesiserRelation(
         rel = new BrieRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::EQREL) {
         rel = new EqrelRelation(ramRel, indexSelection);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::BITMAP) {
+        rel = new BrieRelation(ramRel, indexSelection, true);
     } else if (ramRel.getRepresentation() == RelationRepresentation::INFO) {
         rel = new InfoRelation(ramRel, indexSelection);
     } else {
@@ -330,6 +332,20 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
             };
             geneq(0);
             decl << ";\n }\n";
+            // describe integer orders so that b-tree nodes may be searched with vector instructions
+            bool integral = true;
+            for (std::size_t c = 0; c < bound; c++) {
+                integral = integral && types[ind[c]][0] != 'f';
+            }
+            if (integral) {
+                decl << "static constexpr std::array<souffle::detail::lex_column," << bound
+                     << "> lex_order = {{";
+                for (std::size_t c = 0; c < bound; c++) {
+                    decl << (c > 0 ? "," : "") << "{" << ind[c] << ",souffle::detail::lex_kind::"
+                         << (types[ind[c]][0] == 'u' ? "Unsigned" : "Signed") << "}";
+                }
+                decl << "}};\n";
+            }
             decl << "};\n";
         };
 
@@ -447,6 +463,27 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     def << "return insert(data);\n";
     def << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
 
+    // join method of lattice relations, updating the tuple to the joined tuple
+    if (hasAuxiliary && !hasProvenance) {
+        decl << "template <typename Join>\n";
+        decl << "bool join(t_tuple& t, context& h, Join& join) {\n";
+        decl << "auto update = [&](t_tuple& old_t, const t_tuple& new_t) {\n";
+        decl << "if (!join(old_t, new_t)) return false;\n";
+        decl << "t = old_t;\n";
+        decl << "return true;\n";
+        decl << "};\n";
+        decl << "if (ind_" << masterIndex << ".insert(t, h.hints_" << masterIndex << "_lower, update)) {\n";
+        // the other indexes are joined as well, such that concurrent joins of the same tuple commute
+        for (std::size_t i = 0; i < numIndexes; i++) {
+            if (i != masterIndex) {
+                decl << "ind_" << i << ".insert(t, h.hints_" << i << "_lower, join);\n";
+            }
+        }
+        decl << "return true;\n";
+        decl << "} else return false;\n";
+        decl << "}\n";  // end of join(t_tuple&, context&, Join&)
+    }
+
     // contains methods
     decl << "bool contains(const t_tuple& t, context& h) const;\n";
     def << "bool Type::contains(const t_tuple& t, context& h) const {\n";
@@ -1013,6 +1050,32 @@ void BrieRelation::computeIndices() {
     computedIndices = inds;
 }
 
+/** Select the node sizes of the trie levels of an index */
+std::vector<unsigned> BrieRelation::getTrieLevels(const LexOrder& ind) const {
+    // the widest node that is still worth allocating per trie level
+    constexpr unsigned maxDenseBits = 8;
+    const auto& domainSizes = relation.getAttributeDomainSizes();
+
+    std::vector<unsigned> levels;
+    for (std::size_t i = 0; i < ind.size(); i++) {
+        bool leaf = (i + 1 == ind.size());
+        // the leaf level is a bitmap storing 64 values per cell
+        std::size_t cells = leaf ? (domainSizes[ind[i]] + 63) / 64 : domainSizes[ind[i]];
+        unsigned bits = 1;
+        while ((std::size_t(1) << bits) < cells) {
+            bits++;
+        }
+
+        // columns with a small domain are covered by a single dense node
+        if (domainSizes[ind[i]] > 0 && bits <= maxDenseBits) {
+            levels.push_back(bits);
+        } else {
+            levels.push_back(leaf ? 4 : 6);
+        }
+    }
+    return levels;
+}
+
 /** Generate type name of a brie relation */
 std::string BrieRelation::getTypeNamespace() {
     // collect all attributes used in the lex-order
@@ -1024,7 +1087,8 @@ std::string BrieRelation::getTypeNamespace() {
     }
 
     std::stringstream res;
-    res << "t_brie_" << getTypeAttributeString(relation.getAttributeTypes(), attributesUsed);
+    res << (isBitmap ? "t_bitmap_" : "t_brie_")
+        << getTypeAttributeString(relation.getAttributeTypes(), attributesUsed);
 
     for (auto& ind : getIndices()) {
         res << "__" << join(ind, "_");
@@ -1034,6 +1098,15 @@ std::string BrieRelation::getTypeNamespace() {
         res << "__" << search;
     }
 
+    // tries with dense levels are distinct types
+    for (auto& ind : getIndices()) {
+        const auto& domainSizes = relation.getAttributeDomainSizes();
+        if (!isBitmap && std::any_of(ind.begin(), ind.end(),
+                                 [&](std::size_t attr) { return domainSizes[attr] > 0; })) {
+            res << "__l" << join(getTrieLevels(ind), "_");
+        }
+    }
+
     return res.str();
 }
 
@@ -1053,7 +1126,7 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     std::ostream& decl = cl.decl();
     std::ostream& def = cl.def();
     cl.addInclude("\"souffle/SouffleInterface.h\"");
-    cl.addInclude("\"souffle/datastructure/Brie.h\"");
+    cl.addInclude(isBitmap ? "\"souffle/datastructure/Bitmap.h\"" : "\"souffle/datastructure/Brie.h\"");
 
     // struct definition
     decl << "struct Type {\n";
@@ -1064,7 +1137,12 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
         if (i < indexSelection.getAllOrders().size()) {
             indexToNumMap[indexSelection.getAllOrders()[i]] = i;
         }
-        decl << "using t_ind_" << i << " = Trie<" << inds[i].size() << ">;\n";
+        if (isBitmap) {
+            decl << "using t_ind_" << i << " = Bitmap<" << inds[i].size() << ">;\n";
+        } else {
+            decl << "using t_ind_" << i << " = Trie<" << inds[i].size() << ", TrieLevels<"
+                 << join(getTrieLevels(inds[i]), ",") << ">>;\n";
+        }
         decl << "t_ind_" << i << " ind_" << i << ";\n";
     }
     decl << "using t_tuple = t_ind_" << masterIndex << "::entry_type;\n";
@@ -1165,6 +1243,14 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     def << "return insert(data);\n";
     def << "}\n";
 
+    // set-at-a-time union with a relation of the same type
+    decl << "void insertAll(const Type& other);\n";
+    def << "void Type::insertAll(const Type& other) {\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
+    }
+    def << "}\n";
+
     // contains methods
     decl << "bool contains(const t_tuple& t, context& h) const;\n";
     def << "bool Type::contains(const t_tuple& t, context& h) const {\n";
@@ -1283,7 +1369,8 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     decl << "void printStatistics(std::ostream& o) const;\n";
     def << "void Type::printStatistics(std::ostream& o) const {\n";
     for (std::size_t i = 0; i < numIndexes; i++) {
-        def << "o << \" arity " << arity << " brie index " << i << " lex-order " << inds[i] << "\\n\";\n";
+        def << "o << \" arity " << arity << (isBitmap ? " bitmap" : " brie") << " index " << i
+            << " lex-order " << inds[i] << "\\n\";\n";
         def << "ind_" << i << ".printStats(o);\n";
     }
     def << "}\n";
@@ -1331,4 +1418,97 @@ void EqrelRelation::generateTypeStruct(GenDb& db) {
     return;
 }
 
+// -------- Plugin Relation --------
+
+/** Generate index set for a plugin relation, which are the indexes of the host */
+void PluginRelation::computeIndices() {
+    computedIndices = indexSelection.getAllOrders();
+}
+
+/** Generate type name of a plugin relation */
+std::string PluginRelation::getTypeNamespace() {
+    std::stringstream res;
+    res << "t_host_" << getArity();
+
+    for (auto& ind : getIndices()) {
+        res << "__" << join(ind, "_");
+    }
+
+    for (auto& search : indexSelection.getSearches()) {
+        res << "__" << search;
+    }
+
+    return res.str();
+}
+
+std::string PluginRelation::getTypeName() {
+    return getTypeNamespace() + "::Type";
+}
+
+/** Generate type struct of a plugin relation, adding the range queries of its
+ * searches to the host relation in HostRelation.h */
+void PluginRelation::generateTypeStruct(GenDb& db) {
+    std::size_t arity = getArity();
+
+    fs::path basename(uniqueCppIdent(getTypeNamespace(), 20));
+    GenDatastructure& cl = db.getDatastructure("Type", basename, std::make_optional(getTypeNamespace()));
+    std::ostream& decl = cl.decl();
+    std::ostream& def = cl.def();
+
+    cl.addInclude("\"souffle/SouffleInterface.h\"");
+    cl.addInclude("\"souffle/datastructure/HostRelation.h\"");
+
+    // struct definition
+    decl << "struct Type : public t_host<" << arity << "> {\n";
+    decl << "using t_host<" << arity << ">::t_host;\n";
+
+    // empty lowerUpperRange method
+    decl << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+         << "(const t_tuple& /* lower */, const t_tuple& /* upper */, context& /* h */) const;\n";
+    def << "range<iterator> Type::lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */, context& /* h */) const {\n";
+    def << "return make_range(begin(), end());\n";
+    def << "}\n";
+
+    decl << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+         << "(const t_tuple& /* lower */, const t_tuple& /* upper */) const;\n";
+    def << "range<iterator> Type::lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */) const {\n";
+    def << "return make_range(begin(), end());\n";
+    def << "}\n";
+
+    // lowerUpperRange methods for each pattern which is used to search this relation
+    for (auto search : indexSelection.getSearches()) {
+        decl << "range<iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper, context& h) const;\n";
+        def << "range<iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& upper, context& /* h */) const {\n";
+
+        // the host compares attributes as signed values, hence unconstrained
+        // attributes are bounded by the signed extrema regardless of their type
+        def << "t_tuple low(lower);\n";
+        def << "t_tuple high(upper);\n";
+        for (std::size_t column = 0; column < arity; column++) {
+            if (search[column] == analysis::AttributeConstraint::None) {
+                def << "low[" << column << "] = MIN_RAM_SIGNED;\n";
+                def << "high[" << column << "] = MAX_RAM_SIGNED;\n";
+            }
+        }
+        def << "return t_host<" << arity << ">::lowerUpperRange(" << indexSelection.getLexOrderNum(search)
+            << ", low, high);\n";
+        def << "}\n";
+
+        decl << "range<iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper) const;\n";
+        def << "range<iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& upper) const {\n";
+        def << "context h;\n";
+        def << "return lowerUpperRange_" << search << "(lower,upper,h);\n";
+        def << "}\n";
+    }
+
+    // end struct
+    decl << "};\n";
+}
+
 }  // namespace souffle::synthesiser
@@ -143,13 +143,21 @@ public:
 
 class BrieRelation : public Relation {
 public:
-    BrieRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
-            : Relation(ramRel, indexSelection) {}
+    BrieRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection,
+            bool isBitmap = false)
+            : Relation(ramRel, indexSelection), isBitmap(isBitmap) {}
 
     void computeIndices() override;
     std::string getTypeNamespace();
     std::string getTypeName() override;
     void generateTypeStruct(GenDb& db) override;
+
+private:
+    /** Node sizes (in bits) of the trie levels of the given index */
+    std::vector<unsigned> getTrieLevels(const ram::analysis::LexOrder& ind) const;
+
+    /** Whether the tries are bitmaps of a unary or binary relation */
+    const bool isBitmap;
 };
 
 class EqrelRelation : public Relation {
@@ -161,4 +169,19 @@ public:
     std::string getTypeName() override;
     void generateTypeStruct(GenDb& db) override;
 };
+
+/**
+ * Relation of a stratum plugin, accessing the indexes of a relation of the host
+ * through the interface in HostRelation.h
+ */
+class PluginRelation : public Relation {
+public:
+    PluginRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
+            : Relation(ramRel, indexSelection) {}
+
+    void computeIndices() override;
+    std::string getTypeNamespace();
+    std::string getTypeName() override;
+    void generateTypeStruct(GenDb& db) override;
+};
 }  // namespace souffle::synthesiser
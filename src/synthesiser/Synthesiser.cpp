@@ -39,6 +39,7 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/Fork.h"
 #include "ram/FloatConstant.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
@@ -48,11 +49,14 @@
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -88,12 +92,16 @@
 #include "ram/UnsignedConstant.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
+#include "ram/Variable.h"
 #include "ram/analysis/Index.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
 #include "souffle/TypeAttribute.h"
+#include "souffle/profile/ProgramRun.h"
+#include "souffle/profile/Reader.h"
+#include "souffle/profile/Relation.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
 #include "souffle/utility/MiscUtil.h"
@@ -126,6 +134,17 @@ using ram::analysis::IndexAnalysis;
 using namespace ram;
 using namespace stream_write_qualified_char_as_number;
 
+namespace {
+/** Source location "<path> [<start>-<end>]" of a rule, whose path is reduced to the file name */
+std::string sourceLocator(const std::string& location) {
+    auto pos = location.rfind(" [");
+    if (pos == std::string::npos) {
+        return location;
+    }
+    return baseName(location.substr(0, pos)) + location.substr(pos);
+}
+}  // namespace
+
 /** Lookup frequency counter */
 unsigned Synthesiser::lookupFreqIdx(const std::string& txt) {
     static unsigned ctr;
@@ -198,6 +217,10 @@ ram::RelationSet Synthesiser::getReferencedRelations(const Operation& op) {
     visit(op, [&](const Node& node) {
         if (auto scan = as<RelationOperation>(node)) {
             res.insert(lookup(scan->getRelation()));
+        } else if (auto join = as<LeapfrogJoin>(node)) {
+            for (std::size_t i = 0; i < join->getNumParts(); ++i) {
+                res.insert(lookup(join->getRelation(i)));
+            }
         } else if (auto agg = as<Aggregate>(node)) {
             res.insert(lookup(agg->getRelation()));
         } else if (auto exists = as<ExistenceCheck>(node)) {
@@ -255,6 +278,18 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         std::ostringstream preamble;
         bool preambleIssued = false;
 
+        // profile text of a parallel scan reporting the imbalance of its threads
+        std::string imbalanceProfileText;
+
+        // nested loop split among the threads if the parallel loop is replicated
+        const RelationOperation* sharedLoop = nullptr;
+
+        // source location of the rule emitted, matching the rules of the profile
+        std::string ruleLocation;
+
+        // set while a query is emitted into a function of its own
+        bool outlining = false;
+
     public:
         CodeEmitter(Synthesiser& syn) : synthesiser(syn), glb(synthesiser.glb) {
             rec = [&](auto& out, const auto* value) {
@@ -396,6 +431,25 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         }
 
         void visit_(type_identity<Query>, const Query& query, std::ostream& out) override {
+            // hot and cold queries are outlined to functions specialised for speed or size,
+            // unless they access the locals of the subroutine
+            const bool hot = contains(synthesiser.hotRules, ruleLocation);
+            const bool cold = contains(synthesiser.coldRules, ruleLocation);
+            if ((hot || cold) && !outlining && !glb.config().has("profile") &&
+                    !visitExists(query, [&](const Node& node) {
+                        return isA<Variable>(node) || isA<SubroutineArgument>(node) ||
+                               isA<SubroutineReturn>(node);
+                    })) {
+                const std::string name = "query_" + std::to_string(synthesiser.outlinedQueries++);
+                GenFunction& fn = synthesiser.currentClass->addFunction(name, Visibility::Private);
+                fn.setRetType(hot ? "SOUFFLE_HOT void" : "SOUFFLE_COLD void");
+                outlining = true;
+                visit_(type_identity<Query>(), query, fn.body());
+                outlining = false;
+                out << name << "();\n";
+                return;
+            }
+
             PRINT_BEGIN_COMMENT(out);
 
             // split terms of conditions of outer filter operation
@@ -440,6 +494,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             preamble.str("");
             preamble.clear();
             preambleIssued = false;
+            imbalanceProfileText.clear();
+            sharedLoop = nullptr;
 
             // create operation contexts for this operation
             for (const ram::Relation* rel : synthesiser.getReferencedRelations(query.getOperation())) {
@@ -476,6 +532,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 out << "PARALLEL_END\n";  // end parallel
             }
 
+            if (!imbalanceProfileText.empty()) {
+                out << "ProfileEventSingleton::instance().makeParallelImbalanceEvent(R\"_(";
+                out << imbalanceProfileText << ")_\", scan.getNumWorkers(), scan.getMaxBusyTime(), ";
+                out << "scan.getTotalBusyTime(), scan.getNumSplits(), iter);\n";
+            }
+
             out << "}\n";
             out << "();";  // call lambda
 
@@ -538,20 +600,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 return;
             }
 
-            // more than one => parallel sections
-
-            // start parallel section
-            out << "SECTIONS_START;\n";
-
-            // put each thread in another section
+            // more than one => concurrent tasks
+            out << "parallelInvoke({\n";
             for (const auto& cur : stmts) {
-                out << "SECTION_START;\n";
+                out << "[&]() {\n";
                 dispatch(*cur, out);
-                out << "SECTION_END\n";
+                out << "},\n";
             }
-
-            // done
-            out << "SECTIONS_END;\n";
+            out << "});\n";
             PRINT_END_COMMENT(out);
         }
 
@@ -588,6 +644,118 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Merge>, const Merge& merge, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            const auto* rel = synthesiser.lookup(merge.getTargetRelation());
+            const std::string& srcName =
+                    synthesiser.getRelationName(synthesiser.lookup(merge.getSourceRelation()));
+            const std::string& trgName = synthesiser.getRelationName(rel);
+            const std::string ctxName = synthesiser.getOpContextName(*rel);
+
+            assert(rel->getArity() > 0 && "AstToRamTranslator failed/no merges for nullaries");
+
+            // bitmaps of the same type are merged set-at-a-time
+            const auto* srcRel = synthesiser.lookup(merge.getSourceRelation());
+            if (rel->getRepresentation() == RelationRepresentation::BITMAP &&
+                    srcRel->getRepresentation() == RelationRepresentation::BITMAP) {
+                auto trgType = Relation::getSynthesiserRelation(*rel, isa->getIndexSelection(rel->getName()));
+                auto srcType =
+                        Relation::getSynthesiserRelation(*srcRel, isa->getIndexSelection(srcRel->getName()));
+                if (trgType->getTypeName() == srcType->getTypeName()) {
+                    out << trgName << "->insertAll(*" << srcName << ");\n";
+                    PRINT_END_COMMENT(out);
+                    return;
+                }
+            }
+
+            out << "{\n";
+            out << "auto part = " << srcName << "->partition();\n";
+            out << "PARALLEL_START\n";
+            out << "CREATE_OP_CONTEXT(" << ctxName << "," << trgName << "->createContext());\n";
+            out << R"cpp(
+                   #if defined _OPENMP && _OPENMP < 200805
+                           auto count = std::distance(part.begin(), part.end());
+                           auto base = part.begin();
+                           pfor(int index  = 0; index < count; index++) {
+                               auto it = base + index;
+                   #else
+                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                   #endif
+                   )cpp";
+            out << "try{\n";
+            out << "for(const auto& env0 : *it) {\n";
+            out << trgName << "->insert(env0,READ_OP_CONTEXT(" << ctxName << "));\n";
+            out << "}\n";
+            out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
+            out << "}\n";
+            out << "PARALLEL_END\n";
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
+        void visit_(type_identity<MergeLattice>, const MergeLattice& merge, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            const auto* rel = synthesiser.lookup(merge.getTargetRelation());
+            const auto arity = rel->getArity();
+            const auto firstAuxiliary = arity - rel->getAuxiliaryArity();
+            const std::string& srcName =
+                    synthesiser.getRelationName(synthesiser.lookup(merge.getSourceRelation()));
+            const std::string& trgName = synthesiser.getRelationName(rel);
+            const std::string ctxName = synthesiser.getOpContextName(*rel);
+
+            out << "{\n";
+            out << "auto part = " << srcName << "->partition();\n";
+            out << "PARALLEL_START\n";
+            out << "CREATE_OP_CONTEXT(" << ctxName << "," << trgName << "->createContext());\n";
+            if (merge.hasDeltaRelation()) {
+                const auto* deltaRel = synthesiser.lookup(merge.getDeltaRelation());
+                out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(*deltaRel) << ","
+                    << synthesiser.getRelationName(deltaRel) << "->createContext());\n";
+            }
+
+            // the joins are evaluated on the stored tuple env0 and the inserted tuple env1
+            out << "auto join = [&](Tuple<RamDomain," << arity << ">& env0, const Tuple<RamDomain," << arity
+                << ">& env1) {\n";
+            out << "Tuple<RamDomain," << arity << "> joined = env0;\n";
+            const auto joins = merge.getJoins();
+            for (std::size_t i = firstAuxiliary; i < arity; i++) {
+                out << "joined[" << i << "] = ";
+                rec(out, joins[i - firstAuxiliary]);
+                out << ";\n";
+            }
+            out << "if (joined == env0) return false;\n";
+            out << "env0 = joined;\n";
+            out << "return true;\n";
+            out << "};\n";
+
+            out << R"cpp(
+                   #if defined _OPENMP && _OPENMP < 200805
+                           auto count = std::distance(part.begin(), part.end());
+                           auto base = part.begin();
+                           pfor(int index  = 0; index < count; index++) {
+                               auto it = base + index;
+                   #else
+                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                   #endif
+                   )cpp";
+            out << "try{\n";
+            out << "for(const auto& env : *it) {\n";
+            out << "Tuple<RamDomain," << arity << "> tuple = env;\n";
+            out << "if (" << trgName << "->join(tuple,READ_OP_CONTEXT(" << ctxName << "),join)) {\n";
+            if (merge.hasDeltaRelation()) {
+                const auto* deltaRel = synthesiser.lookup(merge.getDeltaRelation());
+                out << synthesiser.getRelationName(deltaRel) << "->join(tuple,READ_OP_CONTEXT("
+                    << synthesiser.getOpContextName(*deltaRel) << "),join);\n";
+            }
+            out << "}\n";
+            out << "}\n";
+            out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
+            out << "}\n";
+            out << "PARALLEL_END\n";
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<MergeExtend>, const MergeExtend& extend, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             out << synthesiser.getRelationName(synthesiser.lookup(extend.getSourceRelation())) << "->"
@@ -658,8 +826,13 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << dbg.getMessage();
             out << ")_\");\n";
 
+            const std::string& message = dbg.getMessage();
+            auto pos = message.rfind("in file ");
+            ruleLocation = (pos == std::string::npos) ? "" : sourceLocator(message.substr(pos + 8));
+
             // insert statements of the rule
             dispatch(dbg.getStatement(), out);
+            ruleLocation.clear();
             PRINT_END_COMMENT(out);
         }
 
@@ -680,6 +853,16 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void emitWorkStealingScan(const TupleOperation& loop, std::ostream& out) {
+            // a parallel loop over fewer tuples than threads is replicated and its nested loop is split
+            sharedLoop = getSharedLoop(loop);
+            out << "souffle::WorkStealingScan<decltype(part)::value_type> scan(part";
+            if (sharedLoop != nullptr) {
+                out << ", MAX_THREADS";
+            }
+            out << ");\n";
+        }
+
         void visit_(type_identity<ParallelScan>, const ParallelScan& pscan, std::ostream& out) override {
             const auto* rel = synthesiser.lookup(pscan.getRelation());
             const auto& relName = synthesiser.getRelationName(rel);
@@ -694,20 +877,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_BEGIN_COMMENT(out);
 
             out << "auto part = " << relName << "->partition();\n";
+            emitWorkStealingScan(pscan, out);
             out << "PARALLEL_START\n";
             out << preamble.str();
-            out << R"cpp(
-                   #if defined _OPENMP && _OPENMP < 200805
-                           auto count = std::distance(part.begin(), part.end());
-                           auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
-                               auto it = base + index;
-                   #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
-                   #endif
-                   )cpp";
+            out << "auto worker = scan.worker();\n";
+            out << "while (worker.next()) {\n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
+            out << "for(; !worker.done(); worker.advance()) {\n";
+            out << "const auto& env0 = worker.get();\n";
 
             visit_(type_identity<TupleOperation>(), pscan, out);
 
@@ -715,6 +892,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
+            imbalanceProfileText = pscan.getProfileText();
             PRINT_END_COMMENT(out);
         }
 
@@ -727,8 +905,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
             assert(rel->getArity() > 0 && "AstToRamTranslator failed/no scans for nullaries");
 
-            out << "for(const auto& env" << id << " : "
-                << "*" << relName << ") {\n";
+            if (&scan == sharedLoop) {
+                out << "for(const auto& env" << id << " : worker.share(*" << relName << ")) {\n";
+            } else {
+                out << "for(const auto& env" << id << " : "
+                    << "*" << relName << ") {\n";
+            }
 
             visit_(type_identity<TupleOperation>(), scan, out);
 
@@ -778,20 +960,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_BEGIN_COMMENT(out);
 
             out << "auto part = " << relName << "->partition();\n";
+            emitWorkStealingScan(pifexists, out);
             out << "PARALLEL_START\n";
             out << preamble.str();
-            out << R"cpp(
-                   #if defined _OPENMP && _OPENMP < 200805
-                           auto count = std::distance(part.begin(), part.end());
-                           auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
-                               auto it = base + index;
-                   #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
-                   #endif
-                   )cpp";
+            out << "auto worker = scan.worker();\n";
+            out << "while (worker.next()) {\n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
+            out << "for(; !worker.done(); worker.advance()) {\n";
+            out << "const auto& env0 = worker.get();\n";
             out << "if( ";
 
             dispatch(pifexists.getCondition(), out);
@@ -806,6 +982,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
+            imbalanceProfileText = pifexists.getProfileText();
             PRINT_END_COMMENT(out);
         }
 
@@ -827,7 +1004,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "auto range = " << relName << "->"
                 << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
                 << rangeBounds.second.str() << "," << ctxName << ");\n";
-            out << "for(const auto& env" << identifier << " : range) {\n";
+            if (&iscan == sharedLoop) {
+                out << "for(const auto& env" << identifier << " : worker.share(range)) {\n";
+            } else {
+                out << "for(const auto& env" << identifier << " : range) {\n";
+            }
 
             visit_(type_identity<TupleOperation>(), iscan, out);
 
@@ -839,17 +1020,6 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 std::ostream& out) override {
             const auto* rel = synthesiser.lookup(estimateJoinSize.getRelation());
             auto relName = synthesiser.getRelationName(rel);
-            auto keys = isa->getSearchSignature(&estimateJoinSize);
-
-            std::size_t indexNumber = 0;
-            if (!keys.empty()) {
-                indexNumber = isa->getIndexSelection(estimateJoinSize.getRelation()).getLexOrderNum(keys);
-            }
-
-            auto relationType =
-                    Relation::getSynthesiserRelation(*rel, isa->getIndexSelection(rel->getName()));
-            const std::string& type = relationType->getTypeName();
-            auto indexName = relName + (type == "t_eqrel" ? "->ind" : "->ind_" + std::to_string(indexNumber));
 
             bool onlyConstants = true;
             for (auto col : estimateJoinSize.getKeyColumns()) {
@@ -905,44 +1075,29 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                                                                         columns + ";" + constants));
 
             PRINT_BEGIN_COMMENT(out);
-            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")";
             out << "{\n";
-            out << "double total = 0;\n";
-            out << "double duplicates = 0;\n";
-
-            out << "if (!" << indexName << ".empty()) {\n";
-            out << "bool first = true;\n";
-            out << "auto prev = *" << indexName << ".begin();\n";
-            out << "for(const auto& tup : " << indexName << ") {\n";
-            out << "    bool matchesConstants = true;\n";
-            for (auto& [k, constant] : keyConstants) {
-                if (rel->getArity() > 6) {
-                    out << "matchesConstants &= (tup[0][" << k << "] == " << constant << ");\n";
-                } else {
-                    out << "matchesConstants &= (tup[" << k << "] == " << constant << ");\n";
+            if (rel->getArity() == 0) {
+                out << "double joinSize = " << relName << "->size();\n";
+            } else {
+                // a single parallel pass over the relation sketching the distinct keys
+                out << "auto part = " << relName << "->partition();\n";
+                out << "double joinSize = souffle::evaluator::estimateJoinSize(part, "
+                    << (onlyConstants ? "true" : "false") << ",\n";
+                out << "[&](const auto& tup) {\n";
+                out << "return true";
+                for (auto& [k, constant] : keyConstants) {
+                    out << " && (tup[" << k << "] == " << constant << ")";
                 }
-            }
-            out << "if (!matchesConstants) {\n";
-            out << "    continue;\n";
-            out << "}\n";
-            out << "if (first) { first = false; }\n";
-            out << "else {\n";
-            out << "    bool matchesPrev = true;\n";
-            for (auto k : estimateJoinSize.getKeyColumns()) {
-                if (rel->getArity() > 6) {
-                    out << "matchesPrev &= (tup[0][" << k << "] == prev[0][" << k << "]);\n";
-                } else {
-                    out << "matchesPrev &= (tup[" << k << "] == prev[" << k << "]);\n";
+                out << ";\n";
+                out << "},\n";
+                out << "[&](const auto& tup) {\n";
+                out << "uint64_t hash = 0;\n";
+                for (auto k : estimateJoinSize.getKeyColumns()) {
+                    out << "hash = HyperLogLog<>::hash(hash, tup[" << k << "]);\n";
                 }
+                out << "return hash;\n";
+                out << "});\n";
             }
-            out << "if (matchesPrev) { ++duplicates; }\n";
-            out << "}\n";
-            out << "prev = tup; ++total;\n";
-            out << "\n";
-            out << "}\n";
-            out << "}\n";
-            out << "double joinSize = ("
-                << (onlyConstants ? "total" : "total / std::max(1.0, (total - duplicates))") << ");\n";
             if (estimateJoinSize.isRecursiveRelation()) {
                 out << "ProfileEventSingleton::instance().makeRecursiveCountEvent(\"" << profilerText
                     << "\", joinSize, iter);\n";
@@ -978,20 +1133,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
                 << rangeBounds.second.str() << ");\n";
             out << "auto part = range.partition();\n";
+            emitWorkStealingScan(piscan, out);
             out << "PARALLEL_START\n";
             out << preamble.str();
-            out << R"cpp(
-                   #if defined _OPENMP && _OPENMP < 200805
-                           auto count = std::distance(part.begin(), part.end());
-                           auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
-                               auto it = base + index;
-                   #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
-                   #endif
-                   )cpp";
+            out << "auto worker = scan.worker();\n";
+            out << "while (worker.next()) {\n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
+            out << "for(; !worker.done(); worker.advance()) {\n";
+            out << "const auto& env0 = worker.get();\n";
 
             visit_(type_identity<TupleOperation>(), piscan, out);
 
@@ -999,6 +1148,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
+            imbalanceProfileText = piscan.getProfileText();
             PRINT_END_COMMENT(out);
         }
 
@@ -1058,20 +1208,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
                 << rangeBounds.second.str() << ");\n";
             out << "auto part = range.partition();\n";
+            emitWorkStealingScan(piifexists, out);
             out << "PARALLEL_START\n";
             out << preamble.str();
-            out << R"cpp(
-                   #if defined _OPENMP && _OPENMP < 200805
-                           auto count = std::distance(part.begin(), part.end());
-                           auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
-                               auto it = base + index;
-                   #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
-                   #endif
-                   )cpp";
-            out << "try{";
-            out << "for(const auto& env0 : *it) {\n";
+            out << "auto worker = scan.worker();\n";
+            out << "while (worker.next()) {\n";
+            out << "try{\n";
+            out << "for(; !worker.done(); worker.advance()) {\n";
+            out << "const auto& env0 = worker.get();\n";
             out << "if( ";
 
             dispatch(piifexists.getCondition(), out);
@@ -1086,6 +1230,50 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
+            imbalanceProfileText = piifexists.getProfileText();
+            PRINT_END_COMMENT(out);
+        }
+
+        void visit_(type_identity<LeapfrogJoin>, const LeapfrogJoin& join, std::ostream& out) override {
+            synthesiser.currentClass->addInclude("\"souffle/utility/EvaluatorUtil.h\"", true);
+            PRINT_BEGIN_COMMENT(out);
+            auto identifier = join.getTupleId();
+
+            // seek the i-th relation to the least value of its joined column not below the given value
+            out << "auto seek" << identifier
+                << " = [&](std::size_t part, RamDomain value, RamDomain& found) {\n";
+            out << "switch (part) {\n";
+            for (std::size_t i = 0; i < join.getNumParts(); ++i) {
+                const auto* rel = synthesiser.lookup(join.getRelation(i));
+                auto relName = synthesiser.getRelationName(rel);
+                auto keys = isa->getSearchSignature(&join, i);
+                auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")";
+                auto pattern = join.getPattern(i);
+                auto rangeBounds = getPaddedRangeBounds(*rel, pattern, pattern);
+
+                out << "case " << i << ": {\n";
+                out << "auto lower = " << rangeBounds.first.str() << ";\n";
+                out << "auto upper = " << rangeBounds.second.str() << ";\n";
+                out << "lower[" << join.getColumn(i) << "] = value;\n";
+                out << "auto range = " << relName << "->lowerUpperRange_" << keys << "(lower,upper,"
+                    << ctxName << ");\n";
+                out << "if (range.empty()) return false;\n";
+                out << "found = (*range.begin())[" << join.getColumn(i) << "];\n";
+                out << "return true;\n";
+                out << "}\n";
+            }
+            out << "default: return false;\n";
+            out << "}\n";
+            out << "};\n";
+
+            out << "Tuple<RamDomain,1> env" << identifier << ";\n";
+            out << "for (souffle::evaluator::Leapfrog join" << identifier << "(" << join.getNumParts()
+                << ", seek" << identifier << "); join" << identifier << ".next(env" << identifier
+                << "[0]);) {\n";
+
+            visit_(type_identity<TupleOperation>(), join, out);
+
+            out << "}\n";
             PRINT_END_COMMENT(out);
         }
 
@@ -1716,14 +1904,34 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
         void visit_(type_identity<Filter>, const Filter& filter, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            // the innermost filters of a selective rule rarely hold
+            const bool unlikely = contains(synthesiser.selectiveRules, ruleLocation) &&
+                                  !visitExists(filter.getOperation(),
+                                          [&](const Node& node) { return isA<TupleOperation>(node); });
             out << "if( ";
+            if (unlikely) {
+                out << "SOUFFLE_UNLIKELY(";
+            }
             dispatch(filter.getCondition(), out);
+            if (unlikely) {
+                out << ")";
+            }
             out << ") {\n";
             visit_(type_identity<NestedOperation>(), filter, out);
             out << "}\n";
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Fork>, const Fork& fork, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            for (const auto* branch : fork.getBranches()) {
+                out << "{\n";
+                dispatch(*branch, out);
+                out << "}\n";
+            }
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<Break>, const Break& breakOp, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             out << "if( ";
@@ -2063,7 +2271,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(
                 type_identity<StringConstant>, const StringConstant& constant, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "RamSigned(" << synthesiser.convertSymbol2Idx(constant.getConstant()) << ")";
+            out << synthesiser.convertSymbolConstant(constant.getConstant());
             PRINT_END_COMMENT(out);
         }
 
@@ -2319,9 +2527,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     const StringConstant* lstr = as<StringConstant>(args[0]);
                     const StringConstant* rstr = as<StringConstant>(args[1]);
                     if (lstr && rstr) {
-                        out << "RamSigned("
-                            << synthesiser.convertSymbol2Idx(lstr->getConstant() + rstr->getConstant())
-                            << ")";
+                        out << synthesiser.convertSymbolConstant(lstr->getConstant() + rstr->getConstant());
                     } else {
                         out << "symTable.encode(";
                         if (lstr) {
@@ -2497,6 +2703,11 @@ std::set<std::string> Synthesiser::accessedRelations(Statement& stmt) {
     std::set<std::string> accessed;
     visit(stmt, [&](const Insert& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const RelationOperation& node) { accessed.insert(node.getRelation()); });
+    visit(stmt, [&](const LeapfrogJoin& node) {
+        for (std::size_t i = 0; i < node.getNumParts(); ++i) {
+            accessed.insert(node.getRelation(i));
+        }
+    });
     visit(stmt, [&](const RelationStatement& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const AbstractExistenceCheck& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const EmptinessCheck& node) { accessed.insert(node.getRelation()); });
@@ -2505,6 +2716,13 @@ std::set<std::string> Synthesiser::accessedRelations(Statement& stmt) {
         accessed.insert(node.getFirstRelation());
         accessed.insert(node.getSecondRelation());
     });
+    visit(stmt, [&](const MergeLattice& node) {
+        accessed.insert(node.getTargetRelation());
+        accessed.insert(node.getSourceRelation());
+        if (node.hasDeltaRelation()) {
+            accessed.insert(node.getDeltaRelation());
+        }
+    });
     return accessed;
 }
 
@@ -2525,21 +2743,66 @@ std::set<std::string> Synthesiser::accessedUserDefinedFunctors(Statement& stmt)
     return accessed;
 };
 
-void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withSharedLibrary) {
-    // ---------------------------------------------------------------
-    //                      Auto-Index Generation
-    // ---------------------------------------------------------------
-    const Program& prog = translationUnit.getProgram();
-    auto& idxAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
-    // ---------------------------------------------------------------
-    //                      Code Generation
-    // ---------------------------------------------------------------
+void Synthesiser::loadProfile() {
+    if (!glb.config().has("profile-use")) {
+        return;
+    }
+    auto run = std::make_shared<profile::ProgramRun>(profile::ProgramRun());
+    profile::Reader reader(glb.config().get("profile-use"), run);
+    reader.processFile();
+
+    // accumulate the versions and iterations of each rule
+    struct RuleProfile {
+        double runtime = 0;
+        double tuples = 0;
+        std::map<std::size_t, double> frequencies;
+    };
+    std::map<std::string, RuleProfile> rules;
+    auto addRule = [&](profile::Rule& rule) {
+        auto& entry = rules[sourceLocator(rule.getLocator())];
+        entry.runtime += rule.getRuntime().count();
+        entry.tuples += rule.size();
+        for (const auto& atom : rule.getAtoms()) {
+            entry.frequencies[atom.level] += atom.frequency;
+        }
+    };
+    for (const auto& relation : run->getRelationMap()) {
+        for (const auto& rule : relation.second->getRuleMap()) {
+            addRule(*rule.second);
+        }
+        for (const auto& iteration : relation.second->getIterations()) {
+            for (const auto& rule : iteration->getRules()) {
+                addRule(*rule.second);
+            }
+        }
+    }
 
-    withSharedLibrary = false;
+    double total = 0;
+    std::vector<std::pair<double, std::string>> byRuntime;
+    for (const auto& [locator, entry] : rules) {
+        total += entry.runtime;
+        byRuntime.emplace_back(entry.runtime, locator);
 
-    std::string classname = "Sf_" + id;
+        // the innermost atom is frequently reached but rarely produces a tuple
+        if (!entry.frequencies.empty() && entry.tuples * 100 < entry.frequencies.rbegin()->second) {
+            selectiveRules.insert(locator);
+        }
+    }
 
-    // generate C++ program
+    // the slowest rules taking up 90% of the runtime are hot, rules below 0.1% are cold
+    std::sort(byRuntime.rbegin(), byRuntime.rend());
+    double covered = 0;
+    for (const auto& [runtime, locator] : byRuntime) {
+        if (covered < 0.9 * total) {
+            hotRules.insert(locator);
+        } else if (runtime < 0.001 * total) {
+            coldRules.insert(locator);
+        }
+        covered += runtime;
+    }
+}
+
+void Synthesiser::generatePreamble(GenDb& db) {
     std::string package_gen_version = "SOUFFLE_GENERATOR_VERSION \"";
     package_gen_version += PACKAGE_VERSION;
     package_gen_version += "\"";
@@ -2571,8 +2834,10 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     } else {
         db.setNS("souffle");
     }
+}
 
-    // produce external definitions for user-defined functors
+std::set<std::string> Synthesiser::generateFunctorDeclarations(GenDb& db, bool& withSharedLibrary) {
+    const Program& prog = translationUnit.getProgram();
     std::map<std::string, std::tuple<TypeAttribute, std::vector<TypeAttribute>, bool>> functors;
     visit(prog, [&](const UserDefinedOperator& op) {
         if (functors.find(op.getName()) == functors.end()) {
@@ -2636,6 +2901,170 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         extern_decl(db.externC());
     }
 
+    std::set<std::string> names;
+    for (const auto& f : functors) {
+        names.insert(f.first);
+    }
+    return names;
+}
+
+std::string Synthesiser::functorType(const std::string& name) {
+    auto [argsTy, retTy] = functor_signatures[name];
+    std::stringstream os;
+    os << "std::function<" << retTy << "("
+       << join(argsTy, ", ", [&](auto& out, const std::string ty) { out << ty; }) << ")>";
+    return os.str();
+}
+
+std::string Synthesiser::generateSubroutine(GenDb& db, GenClass& gen, const std::string& stratum,
+        Statement& stmt, std::map<std::string, std::string>& relationTypes) {
+    auto accessedRels = accessedRelations(stmt);
+    auto accessedFunctors = accessedUserDefinedFunctors(stmt);
+
+    gen.addInclude("\"souffle/SouffleInterface.h\"");
+    gen.addInclude("\"souffle/SignalHandler.h\"");
+
+    GenFunction& constructor = gen.addConstructor(Visibility::Public);
+
+    enum Mode { Reference, Relation };
+    std::vector<std::tuple<Mode, std::string /*name*/, std::string /*type*/>> args;
+    args.push_back(std::make_tuple(Reference, "symTable", "SymbolTable"));
+    args.push_back(std::make_tuple(Reference, "recordTable", "RecordTable"));
+    args.push_back(std::make_tuple(Reference, "regexCache", "ConcurrentCache<std::string,std::regex>"));
+    args.push_back(std::make_tuple(Reference, "pruneImdtRels", "bool"));
+    args.push_back(std::make_tuple(Reference, "performIO", "bool"));
+    args.push_back(std::make_tuple(Reference, "signalHandler", "SignalHandler*"));
+    args.push_back(std::make_tuple(Reference, "ctr", "std::atomic<RamDomain>"));
+    args.push_back(std::make_tuple(Reference, "inputDirectory", "std::string"));
+    args.push_back(std::make_tuple(Reference, "outputDirectory", "std::string"));
+    if (plugin) {
+        args.push_back(std::make_tuple(Reference, "symbols", "const std::vector<RamDomain>"));
+    }
+    for (std::string rel : accessedRels) {
+        std::string name = getRelationName(lookup(rel));
+        std::string tyname = relationTypes[name];
+        args.push_back(std::make_tuple(Relation, name, tyname));
+        db.usesDatastructure(gen, tyname);
+    }
+    for (std::string fn : accessedFunctors) {
+        args.push_back(std::make_tuple(Reference, fn, functorType(fn)));
+    }
+
+    for (auto arg : args) {
+        Mode kind;
+        std::string name, ty;
+        std::tie(kind, name, ty) = arg;
+        constructor.setNextArg(ty + std::string("&"), name);
+
+        constructor.setNextInitializer(
+                name, (kind == Relation ? std::string("&") : std::string("")) + name);
+
+        gen.addField(ty + (kind == Relation ? "*" : "&"), name, Visibility::Private);
+    }
+    // strata evaluated concurrently count their iterations separately
+    gen.addField("std::atomic<std::size_t>", "iter", Visibility::Private, "{}");
+    std::stringstream initStr;
+    initStr << join(args, ",", [&](auto& out, const auto arg) {
+        Mode kind;
+        std::string name, ty;
+        std::tie(kind, name, ty) = arg;
+        out << (kind == Relation ? "*" : "") << name;
+    });
+
+    GenFunction& run = gen.addFunction("run", Visibility::Public);
+    run.setRetType("void");
+    run.setNextArg("[[maybe_unused]] const std::vector<RamDomain>&", "args");
+    run.setNextArg("[[maybe_unused]] std::vector<RamDomain>&", "ret");
+
+    bool needLock = false;
+    visit(stmt, [&](const SubroutineReturn&) { needLock = true; });
+    if (needLock) {
+        run.body() << "std::mutex lock;\n";
+    }
+    SubroutineUsingStdRegex = false;
+    SubroutineUsingSubstr = false;
+    // emit code for subroutine
+    currentClass = &gen;
+    emitCode(run.body(), stmt);
+    // issue end of subroutine
+    UsingStdRegex |= SubroutineUsingStdRegex;
+
+    if (SubroutineUsingStdRegex) {
+        // regex wrapper
+        GenFunction& wrapper = gen.addFunction("regex_wrapper", Visibility::Private);
+        wrapper.setRetType("inline bool");
+        wrapper.setNextArg("const std::string&", "pattern");
+        wrapper.setNextArg("const std::string&", "text");
+        wrapper.body()
+                << "   bool result = false; \n"
+                << "   try { result = std::regex_match(text, regexCache.getOrCreate(pattern)); } "
+                   "catch(...) { "
+                   "\n"
+                << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << pattern << "
+                   "\"\\\",\\\"\" "
+                   "<< text << \"\\\").\\n\";\n}\n"
+                << "   return result;\n";
+    }
+
+    if (!regexes.empty()) {
+        gen.addField("std::vector<std::regex>", "regexes", Visibility::Private);
+        std::stringstream rst;
+        // we need to collect the patterns first and place each
+        // one into the correct slot
+        std::vector<std::string> patterns;
+        patterns.resize(regexes.size());
+        for (const auto& pi : regexes) {
+            patterns.at(pi.second) = pi.first;
+        }
+        rst << "{\n";
+        for (const auto& p : patterns) {
+            const std::string escaped = escape(p);
+            rst << "\tstd::regex(\"" << escaped << "\"),\n";
+        }
+        rst << "}";
+
+        constructor.setNextInitializer("regexes", rst.str());
+        regexes.clear();
+    }
+
+    // substring wrapper
+    if (SubroutineUsingSubstr) {
+        GenFunction& wrapper = gen.addFunction("substr_wrapper", Visibility::Private);
+        wrapper.setRetType("inline std::string");
+        wrapper.setNextArg("const std::string&", "str");
+        wrapper.setNextArg("std::size_t", "idx");
+        wrapper.setNextArg("std::size_t", "len");
+        wrapper.body() << "std::string result; \n"
+                       << "try { result = str.substr(idx,len); } catch(std::out_of_range&) { \n"
+                       << "  std::cerr << \"warning: wrong index position provided by substr(\\\"\";\n"
+                       << "  std::cerr << str << \"\\\",\" << (int32_t)idx << \",\" << (int32_t)len << "
+                          "\") functor.\\n\";\n"
+                       << "} return result;\n";
+    }
+
+    return initStr.str();
+}
+
+void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withSharedLibrary) {
+    // ---------------------------------------------------------------
+    //                      Auto-Index Generation
+    // ---------------------------------------------------------------
+    const Program& prog = translationUnit.getProgram();
+    auto& idxAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
+    // ---------------------------------------------------------------
+    //                      Code Generation
+    // ---------------------------------------------------------------
+
+    withSharedLibrary = false;
+
+    std::string classname = "Sf_" + id;
+
+    loadProfile();
+    generatePreamble(db);
+
+    // produce external definitions for user-defined functors
+    std::set<std::string> functors = generateFunctorDeclarations(db, withSharedLibrary);
+
     // main class
     GenClass& mainClass = db.getClass(classname, fs::path(classname));
     mainClass.inherits("public SouffleProgram");
@@ -2643,13 +3072,6 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     mainClass.addInclude("<any>");
     mainClass.isMain = true;
 
-    auto function_ty = [&](std::string name) -> std::string {
-        auto [argsTy, retTy] = functor_signatures[name];
-        std::stringstream os;
-        os << "std::function<" << retTy << "("
-           << join(argsTy, ", ", [&](auto& out, const std::string ty) { out << ty; }) << ")>";
-        return os.str();
-    };
     auto functors_initialize = [&](std::ostream& os, std::string name) {
         auto [argsTy, retTy] = functor_signatures[name];
         os << name << " = functors::" << name << ";\n";
@@ -2697,127 +3119,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         GenClass& gen = db.getClass(convertStratumIdent("Stratum_" + sub.first),
                 fs::path(convertStratumIdent("Stratum_" + sub.first)));
         mainClass.addDependency(gen);
-
-        auto accessedRels = accessedRelations(*sub.second);
-        auto accessedFunctors = accessedUserDefinedFunctors(*sub.second);
-
-        gen.addInclude("\"souffle/SouffleInterface.h\"");
-        gen.addInclude("\"souffle/SignalHandler.h\"");
-
-        GenFunction& constructor = gen.addConstructor(Visibility::Public);
-
-        enum Mode { Reference, Relation };
-        std::vector<std::tuple<Mode, std::string /*name*/, std::string /*type*/>> args;
-        args.push_back(std::make_tuple(Reference, "symTable", "SymbolTable"));
-        args.push_back(std::make_tuple(Reference, "recordTable", "RecordTable"));
-        args.push_back(std::make_tuple(Reference, "regexCache", "ConcurrentCache<std::string,std::regex>"));
-        args.push_back(std::make_tuple(Reference, "pruneImdtRels", "bool"));
-        args.push_back(std::make_tuple(Reference, "performIO", "bool"));
-        args.push_back(std::make_tuple(Reference, "signalHandler", "SignalHandler*"));
-        args.push_back(std::make_tuple(Reference, "iter", "std::atomic<std::size_t>"));
-        args.push_back(std::make_tuple(Reference, "ctr", "std::atomic<RamDomain>"));
-        args.push_back(std::make_tuple(Reference, "inputDirectory", "std::string"));
-        args.push_back(std::make_tuple(Reference, "outputDirectory", "std::string"));
-        for (std::string rel : accessedRels) {
-            std::string name = getRelationName(lookup(rel));
-            std::string tyname = relationTypes[name];
-            args.push_back(std::make_tuple(Relation, name, tyname));
-            db.usesDatastructure(gen, tyname);
-        }
-        for (std::string fn : accessedFunctors) {
-            args.push_back(std::make_tuple(Reference, fn, function_ty(fn)));
-        }
-
-        for (auto arg : args) {
-            Mode kind;
-            std::string name, ty;
-            std::tie(kind, name, ty) = arg;
-            constructor.setNextArg(ty + std::string("&"), name);
-
-            constructor.setNextInitializer(
-                    name, (kind == Relation ? std::string("&") : std::string("")) + name);
-
-            gen.addField(ty + (kind == Relation ? "*" : "&"), name, Visibility::Private);
-        }
-        std::stringstream initStr;
-        initStr << join(args, ",", [&](auto& out, const auto arg) {
-            Mode kind;
-            std::string name, ty;
-            std::tie(kind, name, ty) = arg;
-            out << (kind == Relation ? "*" : "") << name;
-        });
-        subroutineInits.push_back(std::make_pair(sub.first, initStr.str()));
-
-        GenFunction& run = gen.addFunction("run", Visibility::Public);
-        run.setRetType("void");
-        run.setNextArg("[[maybe_unused]] const std::vector<RamDomain>&", "args");
-        run.setNextArg("[[maybe_unused]] std::vector<RamDomain>&", "ret");
-
-        bool needLock = false;
-        visit(*sub.second, [&](const SubroutineReturn&) { needLock = true; });
-        if (needLock) {
-            run.body() << "std::mutex lock;\n";
-        }
-        SubroutineUsingStdRegex = false;
-        SubroutineUsingSubstr = false;
-        // emit code for subroutine
-        currentClass = &gen;
-        emitCode(run.body(), *sub.second);
-        // issue end of subroutine
-        UsingStdRegex |= SubroutineUsingStdRegex;
-
-        if (SubroutineUsingStdRegex) {
-            // regex wrapper
-            GenFunction& wrapper = gen.addFunction("regex_wrapper", Visibility::Private);
-            wrapper.setRetType("inline bool");
-            wrapper.setNextArg("const std::string&", "pattern");
-            wrapper.setNextArg("const std::string&", "text");
-            wrapper.body()
-                    << "   bool result = false; \n"
-                    << "   try { result = std::regex_match(text, regexCache.getOrCreate(pattern)); } "
-                       "catch(...) { "
-                       "\n"
-                    << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << pattern << "
-                       "\"\\\",\\\"\" "
-                       "<< text << \"\\\").\\n\";\n}\n"
-                    << "   return result;\n";
-        }
-
-        if (!regexes.empty()) {
-            gen.addField("std::vector<std::regex>", "regexes", Visibility::Private);
-            std::stringstream rst;
-            // we need to collect the patterns first and place each
-            // one into the correct slot
-            std::vector<std::string> patterns;
-            patterns.resize(regexes.size());
-            for (const auto& pi : regexes) {
-                patterns.at(pi.second) = pi.first;
-            }
-            rst << "{\n";
-            for (const auto& p : patterns) {
-                const std::string escaped = escape(p);
-                rst << "\tstd::regex(\"" << escaped << "\"),\n";
-            }
-            rst << "}";
-
-            constructor.setNextInitializer("regexes", rst.str());
-            regexes.clear();
-        }
-
-        // substring wrapper
-        if (SubroutineUsingSubstr) {
-            GenFunction& wrapper = gen.addFunction("substr_wrapper", Visibility::Private);
-            wrapper.setRetType("inline std::string");
-            wrapper.setNextArg("const std::string&", "str");
-            wrapper.setNextArg("std::size_t", "idx");
-            wrapper.setNextArg("std::size_t", "len");
-            wrapper.body() << "std::string result; \n"
-                           << "try { result = str.substr(idx,len); } catch(std::out_of_range&) { \n"
-                           << "  std::cerr << \"warning: wrong index position provided by substr(\\\"\";\n"
-                           << "  std::cerr << str << \"\\\",\" << (int32_t)idx << \",\" << (int32_t)len << "
-                              "\") functor.\\n\";\n"
-                           << "} return result;\n";
-        }
+        subroutineInits.push_back(std::make_pair(
+                sub.first, generateSubroutine(db, gen, sub.first, *sub.second, relationTypes)));
     }
 
     GenFunction& constructor = mainClass.addConstructor(Visibility::Public);
@@ -2872,9 +3175,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         constructor.setNextInitializer("reads", "");
     }
 
-    for (const auto& f : functors) {
-        const std::string& name = f.first;
-        mainClass.addField(function_ty(name), name, Visibility::Private);
+    for (const auto& name : functors) {
+        mainClass.addField(functorType(name), name, Visibility::Private);
     }
 
     int relCtr = 0;
@@ -2906,7 +3208,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
             init << relCtr++ << ", *" << cppName << ", *this, \"" << datalogName << "\", "
                  << strLitAry(rel->getAttributeTypes()) << ", " << strLitAry(rel->getAttributeNames()) << ", "
-                 << rel->getAuxiliaryArity();
+                 << ram::getInterfaceAuxiliaryArity(*rel);
             constructor.body() << "addRelation(\"" << datalogName << "\", wrapper_" << cppName << ", "
                                << foundIn(loadRelations) << ", " << foundIn(storeRelations) << ");\n";
 
@@ -2926,8 +3228,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         constructor.body() << "ProfileEventSingleton::instance().setOutputFile(profiling_fname);\n";
     }
 
-    for (const auto& f : functors) {
-        const std::string& name = f.first;
+    for (const auto& name : functors) {
         functors_initialize(constructor.body(), name);
     }
 
@@ -2967,6 +3268,9 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
     signalHandler->set();
 )_";
+    if (glb.config().has("numa")) {
+        runFunction.body() << "bindThreads();\n";
+    }
     if (glb.config().has("verbose")) {
         runFunction.body() << "signalHandler->enableLogging();\n";
     }
@@ -3172,6 +3476,20 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
                                      << "}\n";
         }
         executeSubroutine.body() << "fatal((\"unknown subroutine \" + name).c_str());\n";
+
+        // prepare the state of runFunction for evaluating the strata through executeSubroutine
+        GenFunction& prepareStrata = mainClass.addFunction("prepareStrata", Visibility::Public);
+        prepareStrata.setRetType("void");
+        prepareStrata.setOverride();
+        prepareStrata.setNextArg("bool", "performIOArg");
+        prepareStrata.setNextArg("bool", "pruneImdtRelsArg");
+        prepareStrata.body() << R"_(
+    this->performIO     = performIOArg;
+    this->pruneImdtRels = pruneImdtRelsArg;
+#if defined(_OPENMP)
+    if (0 < getNumThreads()) { omp_set_num_threads(static_cast<int>(getNumThreads())); }
+#endif
+)_";
     }
 
     // dumpFreqs method
@@ -3272,10 +3590,11 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     }
     hook << "obj.runAll(opt.getInputFileDir(), opt.getOutputFileDir());\n";
 
+    const std::string lazy = glb.config().has("lazy-provenance") ? ", true" : "";
     if (glb.config().get("provenance") == "explain") {
-        hook << "explain(obj, false);\n";
+        hook << "explain(obj, false" << lazy << ");\n";
     } else if (glb.config().get("provenance") == "explore") {
-        hook << "explain(obj, true);\n";
+        hook << "explain(obj, true" << lazy << ");\n";
     }
     hook << "return 0;\n";
     hook << "} catch(std::exception &e) { souffle::SignalHandler::instance()->error(e.what());}\n";
@@ -3283,4 +3602,158 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     hook << "#endif\n";
 }
 
+void Synthesiser::generatePlugin(
+        GenDb& db, const std::string& id, const std::set<std::string>& strata, bool& withSharedLibrary) {
+    const Program& prog = translationUnit.getProgram();
+    auto& idxAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
+    const auto subroutines = prog.getSubroutines();
+
+    withSharedLibrary = false;
+    plugin = true;
+
+    std::string classname = "Plugin_" + id;
+
+    loadProfile();
+    generatePreamble(db);
+
+    // relations and functors accessed by the strata
+    std::set<std::string> relations;
+    std::set<std::string> functors;
+    for (const auto& stratum : strata) {
+        Statement& stmt = *subroutines.at(stratum);
+        for (const auto& name : accessedRelations(stmt)) {
+            const ram::Relation* rel = lookup(name);
+            if (rel->getRepresentation() == RelationRepresentation::EQREL ||
+                    rel->getRepresentation() == RelationRepresentation::BTREE_DELETE ||
+                    rel->getAuxiliaryArity() > 0) {
+                fatal("relation %s of stratum %s cannot be evaluated by a plugin", name, stratum);
+            }
+            relations.insert(name);
+        }
+        for (const auto& name : accessedUserDefinedFunctors(stmt)) {
+            functors.insert(name);
+        }
+    }
+    generateFunctorDeclarations(db, withSharedLibrary);
+    withSharedLibrary = !functors.empty();
+
+    // synthesise data-structures accessing the relations of the host
+    std::map<std::string, std::string> relationTypes;
+    for (const auto& name : relations) {
+        const ram::Relation* rel = lookup(name);
+        Own<Relation> relationType = mk<PluginRelation>(*rel, idxAnalysis.getIndexSelection(name));
+        relationType->computeIndices();
+
+        std::string typeName = relationType->getTypeName();
+        generateRelationTypeStruct(db, std::move(relationType));
+
+        relationTypes[getRelationName(*rel)] = typeName;
+    }
+
+    // generate class for each stratum
+    std::vector<std::pair<std::string, std::string>> subroutineInits;
+    std::vector<GenClass*> strataClasses;
+    for (const auto& stratum : strata) {
+        GenClass& gen = db.getClass(convertStratumIdent("Stratum_" + stratum),
+                fs::path(convertStratumIdent("Stratum_" + stratum)));
+        strataClasses.push_back(&gen);
+        subroutineInits.push_back(std::make_pair(
+                stratum, generateSubroutine(db, gen, stratum, *subroutines.at(stratum), relationTypes)));
+    }
+
+    // main class, created last such that a single file emits it after the strata
+    GenClass& mainClass = db.getClass(classname, fs::path(classname));
+    mainClass.inherits("public StratumPlugin");
+    mainClass.addInclude("\"souffle/CompiledSouffle.h\"");
+    mainClass.addInclude("\"souffle/StratumPlugin.h\"");
+    mainClass.isMain = true;
+    for (GenClass* gen : strataClasses) {
+        mainClass.addDependency(*gen);
+    }
+    for (const auto& [name, typeName] : relationTypes) {
+        db.usesDatastructure(mainClass, typeName);
+    }
+
+    GenFunction& constructor = mainClass.addConstructor(Visibility::Public);
+    constructor.setIsConstructor();
+    constructor.setNextArg("PluginHost&", "host");
+
+    // the state shared with the host
+    mainClass.addField("SymbolTable&", "symTable", Visibility::Private);
+    constructor.setNextInitializer("symTable", "host.symTable");
+    mainClass.addField("RecordTable&", "recordTable", Visibility::Private);
+    constructor.setNextInitializer("recordTable", "host.recordTable");
+    mainClass.addField("ConcurrentCache<std::string,std::regex>&", "regexCache", Visibility::Private);
+    constructor.setNextInitializer("regexCache", "host.regexCache");
+    mainClass.addField("std::atomic<RamDomain>&", "ctr", Visibility::Private);
+    constructor.setNextInitializer("ctr", "host.counter");
+
+    // the host evaluates the I/O statements with the directories of their directives
+    // and purges all cleared relations
+    mainClass.addField("bool", "performIO", Visibility::Private, "{true}");
+    mainClass.addField("bool", "pruneImdtRels", Visibility::Private, "{true}");
+    mainClass.addField("SignalHandler*", "signalHandler", Visibility::Private, "{SignalHandler::instance()}");
+    mainClass.addField("std::string", "inputDirectory", Visibility::Private);
+    mainClass.addField("std::string", "outputDirectory", Visibility::Private);
+
+    for (const auto& name : functors) {
+        mainClass.addField(functorType(name), name, Visibility::Private);
+        constructor.setNextInitializer(name, "functors::" + name);
+    }
+
+    for (const auto& name : relations) {
+        const ram::Relation* rel = lookup(name);
+        const std::string& cppName = getRelationName(*rel);
+        const std::string& type = relationTypes[cppName];
+        mainClass.addField("Own<" + type + ">", cppName, Visibility::Private);
+        constructor.setNextInitializer(cppName, "mk<" + type + ">(*host.relations.at(\"" + name + "\"))");
+    }
+
+    // string constants are encoded in the symbol table of the host
+    mainClass.addField("std::vector<RamDomain>", "symbols", Visibility::Private);
+    for (const auto& symbol : symbolIndex) {
+        constructor.body() << "symbols.push_back(symTable.encode(R\"_(" << symbol << ")_\"));\n";
+    }
+
+    for (auto [name, value] : subroutineInits) {
+        std::string clName = convertStratumIdent("Stratum_" + name);
+        std::string fName = convertStratumIdent("stratum_" + name);
+        mainClass.addField(clName, fName, Visibility::Private);
+        constructor.setNextInitializer(fName, value);
+    }
+
+    GenFunction& getStrata = mainClass.addFunction("getStrata", Visibility::Public);
+    getStrata.setRetType("std::vector<std::string>");
+    getStrata.setOverride();
+    getStrata.body() << "return {" << join(strata, ",", [](auto& out, const std::string& stratum) {
+        out << "\"" << stratum << "\"";
+    }) << "};\n";
+
+    GenFunction& executeStratum = mainClass.addFunction("executeStratum", Visibility::Public);
+    executeStratum.setRetType("void");
+    executeStratum.setOverride();
+    executeStratum.setNextArg("const std::string&", "name");
+    executeStratum.setNextArg("const std::vector<RamDomain>&", "args");
+    executeStratum.setNextArg("std::vector<RamDomain>&", "ret");
+    for (const auto& stratum : strata) {
+        executeStratum.body() << "if (name == \"" << stratum << "\") {\n"
+                              << convertStratumIdent("stratum_" + stratum) << ".run(args, ret);\n"
+                              << "return;"
+                              << "}\n";
+    }
+    executeStratum.body() << "fatal((\"unknown stratum \" + name).c_str());\n";
+
+    // the plugin is only created for the program it was synthesised from
+    std::ostream& hook = mainClass.hooks();
+    hook << "extern \"C\" {\n";
+    hook << "souffle::StratumPlugin* souffle_stratum_plugin(souffle::PluginHost& host, "
+         << "std::size_t fingerprint) {\n";
+    hook << "if (fingerprint != std::size_t(" << ram::fingerprint(prog) << "ULL)) {\n";
+    hook << "return nullptr;\n";
+    hook << "}\n";
+    hook << "return new " << db.getNS() << "::" << classname << "(host);\n";
+    hook << "}\n";
+    hook << "}\n";
+}
+
 }  // namespace souffle::synthesiser
@@ -94,6 +94,21 @@ private:
     /** Output relations */
     std::set<std::string> storeRelations;
 
+    /** Is set to true if string constants are encoded in the symbol table of a plugin host */
+    bool plugin = false;
+
+    /** Source locations of the rules taking up most of the runtime of a profile */
+    std::set<std::string> hotRules;
+
+    /** Source locations of the rules taking up hardly any runtime of a profile */
+    std::set<std::string> coldRules;
+
+    /** Source locations of the rules whose innermost filters rarely hold in a profile */
+    std::set<std::string> selectiveRules;
+
+    /** Number of queries outlined to functions */
+    std::size_t outlinedQueries = 0;
+
 protected:
     /** Convert RAM identifier */
     const std::string convertRamIdent(const std::string& name);
@@ -146,6 +161,15 @@ protected:
         }
     }
 
+    /** Get the expression of a string constant */
+    std::string convertSymbolConstant(const std::string& symbol) const {
+        const RamUnsigned idx = convertSymbol2Idx(symbol);
+        if (plugin) {
+            return "symbols[" + std::to_string(idx) + "]";
+        }
+        return "RamSigned(" + std::to_string(idx) + ")";
+    }
+
     std::string convertSymbolToIdentifier(const std::string& symbol) const;
 
     /** return the set of relation names accessed/used in the statement */
@@ -154,6 +178,22 @@ protected:
     /** return the set of User-defined functor names used in the statement */
     std::set<std::string> accessedUserDefinedFunctors(ram::Statement& stmt);
 
+    /** Classify the rules by the profile given by option profile-use */
+    void loadProfile();
+
+    /** Generate the defines, includes and namespace shared by all classes */
+    void generatePreamble(GenDb& db);
+
+    /** Generate the declarations of the user-defined functors and return their names */
+    std::set<std::string> generateFunctorDeclarations(GenDb& db, bool& withSharedLibrary);
+
+    /** Get the type of the function object of a user-defined functor */
+    std::string functorType(const std::string& name);
+
+    /** Generate the given class of a subroutine and return the arguments initialising it */
+    std::string generateSubroutine(GenDb& db, GenClass& gen, const std::string& stratum,
+            ram::Statement& stmt, std::map<std::string, std::string>& relationTypes);
+
 public:
     explicit Synthesiser(ram::TranslationUnit& tUnit) : translationUnit(tUnit), glb(tUnit.global()) {
         visit(tUnit.getProgram(),
@@ -169,5 +209,9 @@ public:
 
     /** Generate code */
     void generateCode(GenDb& db, const std::string& id, bool& withSharedLibrary);
+
+    /** Generate a stratum plugin evaluating the given strata on the relations of the interpreter */
+    void generatePlugin(
+            GenDb& db, const std::string& id, const std::set<std::string>& strata, bool& withSharedLibrary);
 };
 }  // namespace souffle::synthesiser
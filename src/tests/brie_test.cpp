@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <random>
 #include <set>
@@ -91,6 +92,35 @@ TEST(SparseArray, Limits) {
     EXPECT_EQ(toString(expected), toString(present));
 }
 
+TEST(SparseArray, WideKeys) {
+    // keys using the upper bits of the index, in arrays whose node width divides 64 or not
+    auto check = [&](auto map) {
+        using index_type = typename decltype(map)::index_type;
+        std::vector<index_type> keys = {0, 1, 0xFFFF, index_type(1) << 31, index_type(1) << 32,
+                index_type(1) << 48, static_cast<index_type>(-1) - 1, static_cast<index_type>(-1)};
+
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            map.update(keys[i], int(i + 1));
+        }
+
+        std::vector<std::pair<index_type, int>> present;
+        for (const auto& cur : map) {
+            present.push_back(cur);
+        }
+
+        std::vector<std::pair<index_type, int>> expected;
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            EXPECT_EQ(int(i + 1), map[keys[i]]);
+            expected.emplace_back(keys[i], int(i + 1));
+        }
+        EXPECT_EQ(toString(expected), toString(present));
+    };
+
+    check(SparseArray<int>());
+    check(SparseArray<int, 4>());
+    check(SparseArray<int, 16>());
+}
+
 TEST(SparseArray, Iterator) {
     SparseArray<int> map;
     using index_type = SparseArray<int>::index_type;
@@ -921,6 +951,89 @@ TEST(Trie, IteratorStress_4D) {
     EXPECT_EQ(data, is);
 }
 
+TEST(Trie, DenseLevels) {
+    using tuple = std::array<RamDomain, 3>;
+
+    // the first and last column have a domain small enough for a single node
+    using test_set = Trie<3, TrieLevels<2, 6, 1>>;
+
+    std::default_random_engine randomGenerator(3);
+    std::uniform_int_distribution<RamDomain> enumDistribution(0, 3);
+    std::uniform_int_distribution<RamDomain> valueDistribution(0, 999);
+    std::uniform_int_distribution<RamDomain> bitDistribution(0, 127);
+
+    test_set set;
+    std::set<tuple> data;
+    while (data.size() < 1000) {
+        tuple cur{enumDistribution(randomGenerator), valueDistribution(randomGenerator),
+                bitDistribution(randomGenerator)};
+        if (data.insert(cur).second) {
+            EXPECT_FALSE(set.contains(cur));
+            set.insert(cur);
+            EXPECT_TRUE(set.contains(cur));
+        }
+    }
+
+    std::set<tuple> is;
+    for (const auto& cur : set) {
+        is.insert(cur);
+    }
+
+    EXPECT_EQ(data.size(), set.size());
+    EXPECT_EQ(data, is);
+
+    // check boundaries on the dense level
+    for (RamDomain i = 0; i < 4; i++) {
+        auto range = set.getBoundaries<1>(tuple{i, 0, 0});
+        std::ptrdiff_t count = 0;
+        for (const auto& cur : range) {
+            EXPECT_EQ(i, cur[0]);
+            count++;
+        }
+        EXPECT_EQ(std::distance(data.lower_bound(tuple{i, 0, 0}), data.lower_bound(tuple{i + 1, 0, 0})),
+                count);
+    }
+}
+
+TEST(Trie, RetainAll) {
+    using tuple = std::array<RamDomain, 2>;
+    using test_set = Trie<2>;
+
+    std::default_random_engine randomGenerator(5);
+    std::uniform_int_distribution<RamDomain> distribution(-500, 500);
+
+    test_set a;
+    test_set b;
+    std::set<tuple> dataA;
+    std::set<tuple> dataB;
+    for (int i = 0; i < 5000; i++) {
+        tuple cur{distribution(randomGenerator) / 10, distribution(randomGenerator)};
+        a.insert(cur);
+        dataA.insert(cur);
+        cur = tuple{distribution(randomGenerator) / 10, distribution(randomGenerator)};
+        b.insert(cur);
+        dataB.insert(cur);
+    }
+
+    std::set<tuple> expected;
+    std::set_intersection(dataA.begin(), dataA.end(), dataB.begin(), dataB.end(),
+            std::inserter(expected, expected.end()));
+
+    a.retainAll(b);
+
+    std::set<tuple> is;
+    for (const auto& cur : a) {
+        is.insert(cur);
+    }
+
+    EXPECT_EQ(expected.size(), a.size());
+    EXPECT_EQ(expected, is);
+
+    // intersecting with an empty trie clears the trie
+    a.retainAll(test_set());
+    EXPECT_TRUE(a.empty());
+}
+
 TEST(Trie, BoundaryTest_1D) {
     using test_set = Trie<1>;
 
@@ -17,14 +17,17 @@
 #include "tests/test.h"
 
 #include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/BTreeDelete.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <random>
 #include <set>
@@ -576,6 +579,157 @@ TEST(BTreeSet, ChunkSplitStress) {
     }
 }
 
+/**
+ * A lexicographic comparator on integer arrays following the given column
+ * order, describing itself for vectorised searches.
+ */
+template <typename T, std::size_t N, detail::lex_kind Lead, std::size_t First, std::size_t... Rest>
+struct LexComparator {
+    static constexpr std::array<detail::lex_column, sizeof...(Rest) + 1> lex_order = {
+            {{First, Lead}, {Rest, detail::lex_kind::Signed}...}};
+
+    using Key = std::array<T, N>;
+
+    int operator()(const Key& a, const Key& b) const {
+        for (const auto& col : lex_order) {
+            int r = (col.kind == detail::lex_kind::Unsigned)
+                            ? compare<std::make_unsigned_t<T>>(a, b, col.index)
+                            : compare<T>(a, b, col.index);
+            if (r != 0) {
+                return r;
+            }
+        }
+        return 0;
+    }
+    bool less(const Key& a, const Key& b) const {
+        return (*this)(a, b) < 0;
+    }
+    bool equal(const Key& a, const Key& b) const {
+        return (*this)(a, b) == 0;
+    }
+
+private:
+    template <typename V>
+    static int compare(const Key& a, const Key& b, std::size_t c) {
+        return (V(a[c]) > V(b[c])) - (V(a[c]) < V(b[c]));
+    }
+};
+
+/**
+ * Checks that the vectorised search strategy locates the same elements as the
+ * binary search strategy for the key type and order of the given comparator.
+ */
+TEMPLATE_TEST(BTreeSet, SimdSearch, typename Comp, Comp) {
+    using Key = typename Comp::Key;
+    using T = typename Key::value_type;
+    using simd_set = btree_set<Key, Comp, std::allocator<Key>, 256, detail::simd_search>;
+    using binary_set = btree_set<Key, Comp, std::allocator<Key>, 256, detail::binary_search>;
+    EXPECT_TRUE((detail::simd::searchable<Key, Comp>::value || !detail::simd::lanes<T>::supported));
+
+    // few distinct values per column to exercise ties on leading columns
+    int range = 1 << (16 / std::tuple_size_v<Key>);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> values(-range, range);
+    auto random = [&]() {
+        Key k;
+        for (auto& v : k) {
+            // include values whose order flips when interpreted as unsigned
+            int x = values(generator);
+            v = (x % 4 == 0) ? std::numeric_limits<T>::max() - x : x;
+        }
+        return k;
+    };
+
+    const unsigned N = 10000;
+    simd_set a;
+    binary_set b;
+    for (unsigned i = 0; i < N; i++) {
+        auto k = random();
+        EXPECT_EQ(b.insert(k), a.insert(k));
+    }
+    EXPECT_EQ(b.size(), a.size());
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+
+    Comp comp;
+    auto it = a.begin();
+    for (auto prev = it; it != a.end(); prev = it) {
+        if (++it != a.end()) {
+            EXPECT_TRUE(comp.less(*prev, *it));
+        }
+    }
+
+    for (unsigned i = 0; i < N; i++) {
+        auto k = random();
+        EXPECT_EQ(b.contains(k), a.contains(k));
+        auto lowerA = a.lower_bound(k);
+        auto lowerB = b.lower_bound(k);
+        EXPECT_EQ(lowerB == b.end(), lowerA == a.end());
+        if (lowerA != a.end() && lowerB != b.end()) {
+            EXPECT_EQ(*lowerB, *lowerA);
+        }
+        auto upperA = a.upper_bound(k);
+        auto upperB = b.upper_bound(k);
+        EXPECT_EQ(upperB == b.end(), upperA == a.end());
+        if (upperA != a.end() && upperB != b.end()) {
+            EXPECT_EQ(*upperB, *upperA);
+        }
+    }
+}
+
+using Lex1 = LexComparator<int32_t, 1, detail::lex_kind::Signed, 0>;
+using Lex2 = LexComparator<int32_t, 2, detail::lex_kind::Signed, 0, 1>;
+using Lex2Swapped = LexComparator<int32_t, 2, detail::lex_kind::Signed, 1, 0>;
+using Lex2Unsigned = LexComparator<int32_t, 2, detail::lex_kind::Unsigned, 1, 0>;
+using Lex3 = LexComparator<int32_t, 3, detail::lex_kind::Signed, 2, 0, 1>;
+using Lex3Unsigned = LexComparator<int32_t, 3, detail::lex_kind::Unsigned, 1, 2, 0>;
+using Lex4 = LexComparator<int32_t, 4, detail::lex_kind::Signed, 3, 1, 0, 2>;
+using Lex2Wide = LexComparator<int64_t, 2, detail::lex_kind::Unsigned, 1, 0>;
+
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex1);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex2);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex2Swapped);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex2Unsigned);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex3);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex3Unsigned);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex4);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, Lex2Wide);
+
+TEST(BTreeDeleteSet, SimdSearch) {
+    using Key = std::array<int32_t, 2>;
+    using Comp = LexComparator<int32_t, 2, detail::lex_kind::Unsigned, 1, 0>;
+    using simd_set = btree_delete_set<Key, Comp, std::allocator<Key>, 256, detail::simd_search>;
+
+    auto less = [](const Key& a, const Key& b) { return Comp().less(a, b); };
+    std::set<Key, decltype(less)> reference(less);
+    simd_set t;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> values(-50, 50);
+    for (int i = 0; i < 5000; i++) {
+        Key k{values(generator), values(generator)};
+        EXPECT_EQ(reference.insert(k).second, t.insert(k));
+    }
+    for (int i = 0; i < 5000; i++) {
+        Key k{values(generator), values(generator)};
+        EXPECT_EQ(reference.erase(k), t.erase(k));
+    }
+    EXPECT_EQ(reference.size(), t.size());
+    EXPECT_TRUE(std::equal(t.begin(), t.end(), reference.begin(), reference.end()));
+    for (const auto& k : reference) {
+        EXPECT_TRUE(t.contains(k));
+    }
+}
+
+TEST(BTreeSet, SimdSearchDefault) {
+    // tuples ordered by comparators describing their order select the vectorised search
+    using Key = std::array<int32_t, 2>;
+    EXPECT_TRUE((std::is_same_v<detail::default_strategy<Key>::type, detail::simd_search>));
+    using Floats = std::array<float, 2>;
+    using Wide = std::array<int32_t, 8>;
+    EXPECT_TRUE((std::is_same_v<detail::default_strategy<Floats>::type, detail::binary_search>));
+    EXPECT_TRUE((std::is_same_v<detail::default_strategy<Wide>::type, detail::binary_search>));
+}
+
 using Entry = std::tuple<int, int64_t>;
 
 std::vector<Entry> getData(unsigned numEntries) {
@@ -712,6 +866,32 @@ TEST(Performance, Basic) {
     checkPerformance(t3, "souffle btree_set - 256 - binary", in, out);
 }
 
+TEST(Performance, SearchStrategies) {
+    using Key = std::array<int32_t, 2>;
+    using Comp = LexComparator<int32_t, 2, detail::lex_kind::Signed, 1, 0>;
+
+    int N = 1 << 18;
+
+    std::vector<Key> in;
+    std::vector<Key> out;
+    time("generating data", [&]() {
+        auto data = getData(2 * N);
+        for (std::size_t i = 0; i < data.size(); i += 2) {
+            in.push_back({std::get<0>(data[i]), static_cast<int32_t>(std::get<1>(data[i]))});
+            out.push_back({std::get<0>(data[i + 1]), static_cast<int32_t>(std::get<1>(data[i + 1]))});
+        }
+    });
+
+    using t1 = btree_set<Key, Comp, std::allocator<Key>, 256, detail::linear_search>;
+    checkPerformance(t1, "souffle btree_set - 256 - linear", in, out);
+
+    using t2 = btree_set<Key, Comp, std::allocator<Key>, 256, detail::binary_search>;
+    checkPerformance(t2, "souffle btree_set - 256 - binary", in, out);
+
+    using t3 = btree_set<Key, Comp, std::allocator<Key>, 256, detail::simd_search>;
+    checkPerformance(t3, "souffle btree_set - 256 - simd", in, out);
+}
+
 TEST(Performance, Load) {
     //        int N = 1<<24;
     int N = 1 << 20;
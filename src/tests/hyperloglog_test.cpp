@@ -0,0 +1,96 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hyperloglog_test.cpp
+ *
+ * Test cases for the HyperLogLog cardinality sketch.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/HyperLogLog.h"
+#include "souffle/utility/EvaluatorUtil.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+uint64_t hashValue(RamDomain value) {
+    return HyperLogLog<>::hash(0, value);
+}
+
+TEST(HyperLogLog, Small) {
+    HyperLogLog<> sketch;
+    EXPECT_EQ(0.0, sketch.estimate());
+
+    // duplicates do not change the estimate
+    for (int i = 0; i < 10; i++) {
+        sketch.insert(hashValue(1));
+    }
+    EXPECT_LT(std::abs(sketch.estimate() - 1.0), 0.01);
+
+    for (RamDomain i = -50; i < 50; i++) {
+        sketch.insert(hashValue(i));
+    }
+    EXPECT_LT(std::abs(sketch.estimate() - 100.0), 3.0);
+
+    sketch.clear();
+    EXPECT_EQ(0.0, sketch.estimate());
+}
+
+TEST(HyperLogLog, Large) {
+    const int N = 1000000;
+    HyperLogLog<> sketch;
+    for (RamDomain i = 0; i < N; i++) {
+        sketch.insert(hashValue(i));
+        sketch.insert(hashValue(i / 2));
+    }
+    EXPECT_LT(std::abs(sketch.estimate() - N) / N, 0.05);
+}
+
+TEST(HyperLogLog, Merge) {
+    HyperLogLog<> a;
+    HyperLogLog<> b;
+    for (RamDomain i = 0; i < 20000; i++) {
+        a.insert(hashValue(i));
+        b.insert(hashValue(i + 10000));
+    }
+    a.merge(b);
+    EXPECT_LT(std::abs(a.estimate() - 30000) / 30000, 0.05);
+}
+
+TEST(HyperLogLog, EstimateJoinSize) {
+    using tuple = std::array<RamDomain, 2>;
+
+    // 100 keys in the first column with 10 tuples each
+    std::vector<std::vector<tuple>> partitions(7);
+    for (RamDomain i = 0; i < 1000; i++) {
+        partitions[i % partitions.size()].push_back(tuple{i % 100, i});
+    }
+
+    auto hashFirst = [](const tuple& t) { return hashValue(t[0]); };
+    double joinSize = evaluator::estimateJoinSize(
+            partitions, false, [](const tuple&) { return true; }, hashFirst);
+    EXPECT_LT(std::abs(joinSize - 10.0), 0.5);
+
+    // constants only count the matching tuples
+    double matching = evaluator::estimateJoinSize(
+            partitions, true, [](const tuple& t) { return t[0] == 7; }, hashFirst);
+    EXPECT_EQ(10.0, matching);
+}
+
+}  // namespace test
+}  // namespace souffle
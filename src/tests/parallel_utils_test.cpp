@@ -16,8 +16,11 @@
 
 #include "tests/test.h"
 
+#include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/ParallelUtil.h"
+#include <atomic>
 #include <string>
+#include <vector>
 
 namespace souffle {
 
@@ -99,5 +102,138 @@ TEST(ParallelUtils, OptimisticReadWriteLock) {
 
     EXPECT_EQ(2 * (N / K), c);
 }
+
+TEST(ParallelUtils, WorkStealingScan) {
+    const int N = 100000;
+
+    std::vector<int> data(N);
+    for (int i = 0; i < N; i++) {
+        data[i] = i;
+    }
+
+    // a single range with a few expensive elements at its front
+    std::vector<range<std::vector<int>::const_iterator>> partition;
+    partition.push_back(make_range(data.cbegin(), data.cend()));
+    WorkStealingScan<range<std::vector<int>::const_iterator>> scan(partition);
+
+    std::vector<std::atomic<int>> seen(N);
+    std::atomic<long> sum{0};
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4)
+#endif
+    {
+        auto worker = scan.worker();
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                int value = worker.get();
+                seen[value]++;
+                long work = value < 4 ? 10000000 : 1;
+                long x = 0;
+                for (long i = 0; i < work; i++) {
+                    x += i ^ value;
+                }
+                sum += x & 1;
+            }
+        }
+    }
+
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(1, seen[i].load());
+    }
+#ifdef _OPENMP
+    EXPECT_EQ(4u, scan.getNumWorkers());
+    EXPECT_LT(0u, scan.getNumSplits());
+#else
+    EXPECT_EQ(1u, scan.getNumWorkers());
+#endif
+    EXPECT_TRUE(scan.getMaxBusyTime() <= scan.getTotalBusyTime());
+}
+
+TEST(ParallelUtils, ReplicatedScan) {
+    const int N = 1000;
+
+    std::vector<int> outer = {0, 1};
+    std::vector<int> inner(N);
+    for (int i = 0; i < N; i++) {
+        inner[i] = i;
+    }
+
+    // fewer outer elements than threads replicate the outer scan and split the nested one
+    std::vector<range<std::vector<int>::const_iterator>> partition;
+    partition.push_back(make_range(outer.cbegin(), outer.cend()));
+    WorkStealingScan<range<std::vector<int>::const_iterator>> scan(partition, 4);
+    EXPECT_TRUE(scan.isReplicated());
+
+    std::vector<std::atomic<int>> seen(2 * N);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4)
+#endif
+    {
+        auto worker = scan.worker();
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                int x = worker.get();
+                for (int y : worker.share(make_range(inner.cbegin(), inner.cend()))) {
+                    seen[x * N + y]++;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 2 * N; i++) {
+        EXPECT_EQ(1, seen[i].load());
+    }
+}
+
+TEST(ParallelUtils, NumaTopology) {
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 8, 10, 11}), NumaTopology::parseList("0-3,8,10-11\n"));
+    EXPECT_EQ((std::vector<int>{}), NumaTopology::parseList(""));
+
+    NumaTopology topology({{0, 1, 4, 5}, {}, {2, 3, 6, 7}});
+    EXPECT_EQ(2u, topology.getNumNodes());
+    EXPECT_EQ(0u, topology.getNode(5));
+    EXPECT_EQ(1u, topology.getNode(6));
+    EXPECT_EQ(0u, topology.getNode(100));
+
+    const NumaTopology& machine = NumaTopology::instance();
+    EXPECT_LT(0u, machine.getNumNodes());
+    EXPECT_LT(machine.getCurrentNode(), machine.getNumNodes());
+}
+
+TEST(ParallelUtils, NumaScan) {
+    const int N = 10000;
+
+    std::vector<int> data(N);
+    for (int i = 0; i < N; i++) {
+        data[i] = i;
+    }
+
+    // ranges of nodes without workers are taken by the workers of other nodes
+    std::vector<range<std::vector<int>::const_iterator>> partition;
+    for (int i = 0; i < N; i += 100) {
+        partition.push_back(make_range(data.cbegin() + i, data.cbegin() + i + 100));
+    }
+    WorkStealingScan<range<std::vector<int>::const_iterator>> scan(partition, 0, 3);
+
+    std::vector<std::atomic<int>> seen(N);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4)
+#endif
+    {
+        auto worker = scan.worker();
+        while (worker.next()) {
+            for (; !worker.done(); worker.advance()) {
+                seen[worker.get()]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(1, seen[i].load());
+    }
+}
 }  // namespace test
 }  // end namespace souffle
@@ -0,0 +1,74 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program reading a relation with an iteration tag through the
+ * OO-interface
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+/**
+ * Main program
+ */
+int main(int /* argc */, char** /* argv */) {
+    // create an instance of program "delta_tagging"
+    if (SouffleProgram* prog = ProgramFactory::newInstance("delta_tagging")) {
+        Relation* edge = prog->getRelation("edge");
+        Relation* path = prog->getRelation("path");
+        if (edge == nullptr || path == nullptr) {
+            error("cannot find relations edge and path");
+        }
+
+        std::vector<std::array<std::string, 2>> myData = {{"A", "B"}, {"B", "C"}, {"C", "D"}};
+        for (auto input : myData) {
+            tuple t(edge);
+            t << input[0] << input[1];
+            edge->insert(t);
+        }
+
+        // run program
+        prog->runAll("", "", false, true);
+
+        // only the attributes of the declaration are visible
+        std::cout << "edge: " << edge->getPrimaryArity() << "\n";
+        std::cout << "path: " << path->getPrimaryArity() << "\n";
+        for (auto& output : *path) {
+            std::string x;
+            std::string y;
+            output >> x >> y;
+            std::cout << x << " " << y << "\n";
+        }
+
+        // print all relations to CSV files in current directory
+        prog->printAll();
+
+        // free program analysis
+        delete prog;
+    } else {
+        error("cannot find program delta_tagging");
+    }
+}